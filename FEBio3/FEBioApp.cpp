@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "console.h"
 #include "CommandManager.h"
 #include <FECore/log.h>
+#include <FECore/FESolidDomain.h>
 #include "console.h"
 #include "breakpoint.h"
 #include <FEBioLib/febio.h>
@@ -195,6 +196,23 @@ void FEBioApp::ApplyConfig(FEBioModel& fem)
 	{
 		fem.SetPrintParametersFlag(m_config.m_printParams != 0);
 	}
+
+	if (m_config.m_nodeStore != -1)
+	{
+		fem.GetMesh().SetContiguousNodeStorage(m_config.m_nodeStore != 0);
+	}
+
+	if (m_config.m_G0cache != -1)
+	{
+		// the budget applies to each solid domain
+		FEMesh& mesh = fem.GetMesh();
+		size_t maxBytes = (size_t)m_config.m_G0cache * 1048576;
+		for (int i = 0; i < mesh.Domains(); ++i)
+		{
+			FESolidDomain* dom = dynamic_cast<FESolidDomain*>(&mesh.Domain(i));
+			if (dom) dom->SetReferenceGradientCache(m_config.m_G0cache > 0, maxBytes);
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -1272,6 +1272,9 @@ bool FEFluidFSISolver::StiffnessMatrix()
     // add contributions from rigid bodies
     m_rigidSolver.StiffnessMatrix(*m_pK, tp);
     
+    // add the buffered contributions (of rigid bodies and linear constraints)
+    LS.FinalizeAssembly();
+
     return true;
 }
 
@@ -66,8 +66,9 @@ bool FESoluteConvectiveFlow::Init()
     if ((m_sol < 1) || (m_sol > MAX_CDOFS)) return false;
     
     FEMesh& mesh = fem.GetMesh();
-    m_octree = new FEOctreeSearch(&mesh);
-    m_octree->Init();
+    m_locator = new FEPointLocator(&mesh);
+    if (m_locator->Init() == false) return false;
+    m_elem.clear();
     
     FESurface* ps = &GetSurface();
     m_np = new FENormalProjection(*ps);
@@ -110,7 +111,11 @@ void FESoluteConvectiveFlow::Update()
     FEModel& fem = *GetFEModel();
     FEMesh& mesh = fem.GetMesh();
     
-    for (int i=0; i<mesh.Nodes(); ++i)
+    // evaluate the upstream point of each node
+    int NN = mesh.Nodes();
+    vector<vec3d> X;
+    X.reserve(NN);
+    for (int i=0; i<NN; ++i)
     {
         if (!m_bexclude[i]) {
             FENode& node = mesh.Node(i);
@@ -118,14 +123,28 @@ void FESoluteConvectiveFlow::Update()
             vec3d vt = node.get_vec3d(m_dofW[0], m_dofW[1], m_dofW[2]);
             vec3d vp = node.get_vec3d_prev(m_dofW[0], m_dofW[1], m_dofW[2]);
             
-            vec3d X = x - (vt*m_gamma + vp*(1-m_gamma))*m_dt;
+            X.push_back(x - (vt*m_gamma + vp*(1-m_gamma))*m_dt);
+        }
+    }
+    
+    // search for the solid elements in which the points lie
+    // The elements of the last update are used as starting points for the search.
+    vector<vec3d> R;
+    m_locator->FindElements(X, m_elem, R);
+    
+    for (int i=0, k=0; i<NN; ++i)
+    {
+        if (!m_bexclude[i]) {
+            FENode& node = mesh.Node(i);
+            vec3d x = node.m_rt;
+            vec3d X_k = X[k];
             
             int dofc = m_dofC + m_sol - 1;
-            double r[3] = { 0 };
+            double r[3] = { R[k].x, R[k].y, R[k].z };
             double c = 0;
             
-            // search for the solid element in which X lies
-            FESolidElement* el = (FESolidElement*)m_octree->FindElement(X, r);
+            FESolidElement* el = (m_elem[k] >= 0 ? m_locator->Element(m_elem[k]) : nullptr);
+            ++k;
             if (el) {
                 const int NELN = FESolidElement::MAX_NODES;
                 double ep[NELN], cp[NELN];
@@ -143,7 +162,7 @@ void FESoluteConvectiveFlow::Update()
             else {
                 vec2d r2;
                 FESurfaceElement* pme;
-                vec3d n = x - X;
+                vec3d n = x - X_k;
                 n.unit();
                 pme = m_np->Project(x, n, r);
                 if (pme) {
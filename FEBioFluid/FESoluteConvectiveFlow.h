@@ -28,7 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <FECore/FESurfaceLoad.h>
-#include <FECore/FEOctreeSearch.h>
+#include <FECore/FEPointLocator.h>
 #include "FECore/FENormalProjection.h"
 #include "febiofluid_api.h"
 
@@ -70,7 +70,8 @@ private:
     double      m_dt;
     vector<bool>    m_bexclude;
     FENormalProjection* m_np;
-    FEOctreeSearch* m_octree;
+    FEPointLocator* m_locator;
+    vector<int>     m_elem;     //!< element containing the upstream point of each node (from last update)
     
     DECLARE_FECORE_CLASS();
 };
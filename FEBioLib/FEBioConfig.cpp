@@ -33,4 +33,6 @@ FEBioConfig::FEBioConfig()
 void FEBioConfig::Defaults()
 {
 	m_printParams = -1;
+	m_nodeStore = -1;
+	m_G0cache = -1;
 }
@@ -35,4 +35,6 @@ public:
 
 public:
 	int		m_printParams;
+	int		m_nodeStore;	//!< store nodal dof arrays contiguously (-1 = use default)
+	int		m_G0cache;		//!< memory budget (in MB) for reference gradient caches of solid domains (0 = off, -1 = use default)
 };
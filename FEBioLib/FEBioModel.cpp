@@ -618,6 +618,10 @@ void FEBioModel::Write(unsigned int nwhen)
 					double time = GetTime().currentTime;
 					if (m_plot) m_plot->Write(*this, (float)time);
 				}
+
+				// States are written in the background, so make sure 
+				// everything is on disk by the end of a step.
+				if (m_plot && (nwhen == CB_STEP_SOLVED)) m_plot->Sync();
 			}
 		}
 	}
@@ -665,6 +669,9 @@ void FEBioModel::WriteData()
 //! Dump state to archive for restarts
 void FEBioModel::DumpData()
 {
+	// the plot file should be complete up to the restart point
+	if (m_plot) m_plot->Sync();
+
 	DumpFile ar(*this);
 	if (ar.Create(m_sdump.c_str()) == false)
 	{
@@ -1639,7 +1646,10 @@ bool FEBioModel::Solve()
 	// close the plot file
 	int hint = GetStep(Steps() - 1)->GetPlotHint();
 	if (hint != FE_PLOT_APPEND)
+	{
 		if (m_plot) m_plot->Close();
+	}
+	else if (m_plot) m_plot->Sync();
 
 	// We're done !
 	return bconv;
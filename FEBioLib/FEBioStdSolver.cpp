@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include <FEBioXML/FERestartImport.h>
 #include <FECore/DumpFile.h>
 #include <FECore/FEAnalysis.h>
+#include <FEBioXML/FEBinaryMeshFile.h>
 
 //-----------------------------------------------------------------------------
 FEBioStdSolver::FEBioStdSolver(FEModel* pfem) : FECoreTask(pfem) {}
@@ -133,3 +134,33 @@ bool FEBioRestart::Run()
 	// continue the analysis
 	return (GetFEModel() ? GetFEModel()->Solve() : false);
 }
+
+//-----------------------------------------------------------------------------
+bool FEBioConvertMesh::Init(const char* szfile)
+{
+	if ((szfile == 0) || (szfile[0] == 0))
+	{
+		fprintf(stderr, "FATAL ERROR: no output file specified for binary mesh file.\n");
+		return false;
+	}
+	m_fileName = szfile;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioConvertMesh::Run()
+{
+	FEModel* fem = GetFEModel();
+	if (fem == 0) return false;
+
+	if (FEBinaryMeshFile::Write(m_fileName.c_str(), fem->GetMesh()) == false)
+	{
+		fprintf(stderr, "FATAL ERROR: failed writing binary mesh file %s\n", m_fileName.c_str());
+		return false;
+	}
+
+	FEMesh& mesh = fem->GetMesh();
+	printf("Binary mesh file %s written (%d nodes, %d elements).\n", m_fileName.c_str(), mesh.Nodes(), mesh.Elements());
+
+	return true;
+}
@@ -57,3 +57,22 @@ public:
 	//! Run the FE model
 	virtual bool Run();
 };
+
+//-----------------------------------------------------------------------------
+// This task writes the mesh of the input file to a binary mesh file, which can 
+// then be referenced from the Mesh or MeshData section with an Include tag.
+// The model is not solved.
+class FEBioConvertMesh : public FECoreTask
+{
+public:
+	FEBioConvertMesh(FEModel* pfem) : FECoreTask(pfem){}
+
+	//! initialization (stores the name of the output file)
+	bool Init(const char* szfile);
+
+	//! write the binary mesh file
+	bool Run();
+
+private:
+	std::string	m_fileName;
+};
@@ -127,6 +127,16 @@ namespace febio {
 							tag.value(config.m_printParams);
 							++tag;
 						}
+						else if (tag == "contiguous_node_storage")
+						{
+							tag.value(config.m_nodeStore);
+							++tag;
+						}
+						else if (tag == "reference_gradient_cache")
+						{
+							tag.value(config.m_G0cache);
+							++tag;
+						}
 						else
 						{
 							if (parse_tags(tag) == false) return false;
@@ -59,6 +59,7 @@ void InitLibrary()
 {
 	REGISTER_FECORE_CLASS(FEBioStdSolver, "solve");
 	REGISTER_FECORE_CLASS(FEBioRestart, "restart");
+	REGISTER_FECORE_CLASS(FEBioConvertMesh, "convert_mesh");
 
 	FECore::InitModule();
 	NumCore::InitModule();
@@ -46,4 +46,4 @@ SOFTWARE.*/
 // It is incremented when the structure of this file is modified.
 //
 
-#define RSTRTVERSION		0x06
+#define RSTRTVERSION		0x07
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/mat3d.h"
 #include "FECore/tens6d.h"
 #include <FECore/log.h>
+#include <FECore/FEException.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -67,6 +68,7 @@ bool FEElasticMultiscaleDomain1O::Init()
 			// create the material point RVEs
 			mmpt.m_F_prev = pt.m_F;	// TODO: I think I can remove this line
 			mmpt.m_rve.CopyFrom(rve);
+			mmpt.m_rve.BlockLog();
 			if (mmpt.m_rve.Init() == false) return false;
 		}
 	}
@@ -103,3 +105,87 @@ bool FEElasticMultiscaleDomain1O::Init()
 
 	return true;
 }
+
+//-----------------------------------------------------------------------------
+void FEElasticMultiscaleDomain1O::Update(const FETimeInfo& tp)
+{
+	// solve all the RVEs first, so that the element loop
+	// only needs to collect the averaged stresses
+	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
+	if (pmat->m_bparallel) SolveRVEs();
+
+	// call base class
+	FEElasticSolidDomain::Update(tp);
+}
+
+//-----------------------------------------------------------------------------
+//! Each material point owns a copy of the RVE model (with its own linear solver
+//! and a blocked log), so the RVE problems are independent and can be solved 
+//! concurrently. The RVE solution times can differ a lot, so we balance the load
+//! over the material points instead of the elements.
+void FEElasticMultiscaleDomain1O::SolveRVEs()
+{
+	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
+
+	// evaluate the deformation gradients the same way as UpdateElementStress
+	// and collect the material points
+	vector<FEMaterialPoint*> pts;
+	int NE = Elements();
+	for (int i=0; i<NE; ++i)
+	{
+		FESolidElement& el = Element(i);
+		if (el.isActive() == false) continue;
+
+		int nint = el.GaussPoints();
+		for (int n=0; n<nint; ++n)
+		{
+			FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+			FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
+			mmpt.m_rveSolved = false;
+
+			try
+			{
+				mat3d Ft, Fp;
+				double Jt = defgrad(el, Ft, n);
+				defgradp(el, Fp, n);
+				if (m_alphaf == 1.0)
+				{
+					pt.m_F = Ft;
+					pt.m_J = Jt;
+				}
+				else
+				{
+					pt.m_F = Ft*m_alphaf + Fp*(1 - m_alphaf);
+					pt.m_J = pt.m_F.det();
+				}
+			}
+			catch (const NegativeJacobian&)
+			{
+				// this will be reported when the element stresses are updated
+				continue;
+			}
+
+			pts.push_back(&mp);
+		}
+	}
+
+	// solve the RVEs
+	int NP = (int)pts.size();
+	int nfail = 0;
+	#pragma omp parallel for schedule(dynamic) reduction(+:nfail)
+	for (int i=0; i<NP; ++i)
+	{
+		try
+		{
+			if (pmat->SolveRVE(*pts[i]) == false) nfail++;
+		}
+		catch (...)
+		{
+			nfail++;
+		}
+	}
+
+	// make sure they all converged
+	if (nfail > 0) throw FEMultiScaleException(-1, -1);
+}
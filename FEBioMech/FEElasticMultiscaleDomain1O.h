@@ -42,4 +42,11 @@ public:
 
 	//! initialize class
 	bool Init();
+
+	//! Update the element stresses
+	void Update(const FETimeInfo& tp) override;
+
+protected:
+	//! solve the RVEs of all material points concurrently
+	void SolveRVEs();
 };
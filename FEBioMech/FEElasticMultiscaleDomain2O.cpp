@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FECore/mat3d.h"
 #include "FECore/tens6d.h"
 #include <FECore/log.h>
+#include <FECore/FEException.h>
 
 
 //-----------------------------------------------------------------------------
@@ -179,6 +180,11 @@ void FEElasticMultiscaleDomain2O::Update(const FETimeInfo& timeInfo)
 {
 	try
 	{
+		// solve all the RVEs first, so that the element and internal surface
+		// loops only need to collect the averaged stresses
+		FEMicroMaterial2O* pmat = dynamic_cast<FEMicroMaterial2O*>(m_pMat);
+		if (pmat->m_bparallel) SolveRVEs();
+
 		// call base class
 		FEElasticSolidDomain2O::Update(timeInfo);
 	}
@@ -197,3 +203,103 @@ void FEElasticMultiscaleDomain2O::Update(const FETimeInfo& timeInfo)
 		throw;
 	}
 }
+
+//-----------------------------------------------------------------------------
+//! Each material point owns a copy of the RVE model (with its own linear solver
+//! and a blocked log), so the RVE problems are independent and can be solved 
+//! concurrently. This includes the material points of the internal surface, 
+//! which are otherwise processed in a serial loop. 
+void FEElasticMultiscaleDomain2O::SolveRVEs()
+{
+	FEMicroMaterial2O* pmat = dynamic_cast<FEMicroMaterial2O*>(m_pMat);
+
+	// evaluate the deformation gradients and their gradients the same way as
+	// UpdateElementStress and UpdateInternalSurfaceStresses and collect the material points
+	vector<FEMaterialPoint*> pts;
+	int NE = Elements();
+	for (int i=0; i<NE; ++i)
+	{
+		FESolidElement& el = Element(i);
+		if (el.isActive() == false) continue;
+
+		int nint = el.GaussPoints();
+		for (int n=0; n<nint; ++n)
+		{
+			FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+			FEElasticMaterialPoint2O& pt2O = *mp.ExtractData<FEElasticMaterialPoint2O>();
+			mp.ExtractData<FEMicroMaterialPoint2O>()->m_rveSolved = false;
+
+			try
+			{
+				pt.m_J = defgrad(el, pt.m_F, n);
+				defhess(el, n, pt2O.m_G);
+			}
+			catch (const NegativeJacobian&)
+			{
+				// this will be reported when the element stresses are updated
+				continue;
+			}
+
+			pts.push_back(&mp);
+		}
+	}
+
+	int NF = m_surf.Elements(), nd = 0;
+	for (int i=0; i<NF; ++i)
+	{
+		FESurfaceElement& face = m_surf.Element(i);
+		int nint = face.GaussPoints();
+		for (int n=0; n<nint; ++n, ++nd)
+		{
+			FEInternalSurface2O::Data& data = m_surf.GetData(nd);
+			for (int k=0; k<2; ++k)
+			{
+				FEMaterialPoint& mp = *data.m_pt[k];
+				FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+				FEElasticMaterialPoint2O& pt2O = *mp.ExtractData<FEElasticMaterialPoint2O>();
+				mp.ExtractData<FEMicroMaterialPoint2O>()->m_rveSolved = false;
+
+				vec3d& ksi = data.ksi[k];
+				FESolidElement& ek = static_cast<FESolidElement&>(*face.m_elem[k]);
+				try
+				{
+					pt.m_J = defgrad(ek, pt.m_F, ksi.x, ksi.y, ksi.z);
+					defhess(ek, ksi.x, ksi.y, ksi.z, pt2O.m_G);
+				}
+				catch (const NegativeJacobian&)
+				{
+					continue;
+				}
+
+				pts.push_back(&mp);
+			}
+		}
+	}
+
+	// solve the RVEs
+	int NP = (int)pts.size();
+	int nfail = 0;
+	#pragma omp parallel for schedule(dynamic) reduction(+:nfail)
+	for (int i=0; i<NP; ++i)
+	{
+		try
+		{
+			if (pmat->SolveRVE(*pts[i]) == false) nfail++;
+		}
+		catch (...)
+		{
+			nfail++;
+		}
+	}
+
+	// report the first material point that failed
+	if (nfail > 0)
+	{
+		for (int i=0; i<NP; ++i)
+		{
+			FEMicroMaterialPoint2O& mmpt2O = *pts[i]->ExtractData<FEMicroMaterialPoint2O>();
+			if (mmpt2O.m_rveSolved == false) throw FEMultiScaleException(mmpt2O.m_elem_id, mmpt2O.m_gpt_id);
+		}
+	}
+}
@@ -48,4 +48,8 @@ public:
 
 	//! Update 
 	void Update(const FETimeInfo& timeInfo) override;
+
+protected:
+	//! solve the RVEs of all material points concurrently
+	void SolveRVEs();
 };
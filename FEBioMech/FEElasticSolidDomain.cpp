@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioMech.h"
 #include <FECore/FELinearSystem.h>
+#include "FESolidElementKernels.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -189,55 +190,33 @@ void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 
 void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<double>& fe)
 {
-	// jacobian matrix, inverse jacobian matrix and determinants
-	double Ji[3][3];
+	// spatial derivatives of shape functions
+	vec3d G[FEElement::MAX_NODES];
 
 	int nint = el.GaussPoints();
 	int neln = el.Nodes();
 
 	double*	gw = el.GaussWeights();
 
+	// nodal coordinates (these are the same for all integration points)
+	vec3d rt[FEElement::MAX_NODES];
+	if (m_update_dynamic) GetCurrentNodalCoordinates(el, rt, m_alphaf);
+	else GetCurrentNodalCoordinates(el, rt);
+
 	// repeat for all integration points
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
 
-		// calculate the jacobian
-		double detJt = (m_update_dynamic ? invjact(el, Ji, n, m_alphaf) : invjact(el, Ji, n));
-
-		detJt *= gw[n];
+		// calculate the jacobian and shape function gradients
+		double detJt = FESolidKernels::ShapeGradient(el, n, rt, G)*gw[n];
 
 		// get the stress vector for this integration point
-        const mat3ds& s = pt.m_s;
-
-		const double* Gr = el.Gr(n);
-		const double* Gs = el.Gs(n);
-		const double* Gt = el.Gt(n);
+		const mat3ds& s = pt.m_s;
 
-		for (int i=0; i<neln; ++i)
-		{
-			// calculate global gradient of shape functions
-			// note that we need the transposed of Ji, not Ji itself !
-			double Gx = Ji[0][0]*Gr[i]+Ji[1][0]*Gs[i]+Ji[2][0]*Gt[i];
-			double Gy = Ji[0][1]*Gr[i]+Ji[1][1]*Gs[i]+Ji[2][1]*Gt[i];
-			double Gz = Ji[0][2]*Gr[i]+Ji[1][2]*Gs[i]+Ji[2][2]*Gt[i];
-
-			// calculate internal force
-			// the '-' sign is so that the internal forces get subtracted
-			// from the global residual vector
-			fe[3*i  ] -= ( Gx*s.xx() +
-				           Gy*s.xy() +
-					       Gz*s.xz() )*detJt;
-
-			fe[3*i+1] -= ( Gy*s.yy() +
-				           Gx*s.xy() +
-					       Gz*s.yz() )*detJt;
-
-			fe[3*i+2] -= ( Gz*s.zz() +
-				           Gy*s.yz() +
-					       Gx*s.xz() )*detJt;
-		}
+		// calculate internal force
+		FESolidKernels::InternalForce(neln, G, s, detJt, &fe[0]);
 	}
 }
 
@@ -282,13 +261,17 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 	// weights at gauss points
 	const double *gw = el.GaussWeights();
 
+	// nodal coordinates (these are the same for all integration points)
+	vec3d rt[FEElement::MAX_NODES];
+	GetCurrentNodalCoordinates(el, rt, m_alphaf);
+
 	// calculate geometrical element stiffness matrix
 	int neln = el.Nodes();
 	int nint = el.GaussPoints();
 	for (int n = 0; n<nint; ++n)
 	{
 		// calculate shape function gradients and jacobian
-		double w = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
+		double w = FESolidKernels::ShapeGradient(el, n, rt, G)*gw[n]*m_alphaf;
 
 		// get the material point data
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
@@ -297,15 +280,7 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 		// element's Cauchy-stress tensor at gauss point n
 		mat3ds& s = pt.m_s;
 
-		for (int i = 0; i<neln; ++i)
-			for (int j = 0; j<neln; ++j)
-			{
-				double kab = (G[i]*(s * G[j]))*w;
-
-				ke[3*i  ][3*j  ] += kab;
-				ke[3*i+1][3*j+1] += kab;
-				ke[3*i+2][3*j+2] += kab;
-			}
+		FESolidKernels::GeometricalStiffness(neln, G, s, w, ke);
 	}
 }
 
@@ -321,26 +296,21 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	// global derivatives of shape functions
 	vec3d G[FEElement::MAX_NODES];
 
-	double Gxi, Gyi, Gzi;
-	double Gxj, Gyj, Gzj;
-
 	// The 'D' matrix
 	double D[6][6] = {0};	// The 'D' matrix
 
-	// The 'D*BL' matrix
-	double DBL[6][3];
-
-	// jacobian
-	double detJt;
-	
 	// weights at gauss points
 	const double *gw = el.GaussWeights();
 
+	// nodal coordinates (these are the same for all integration points)
+	vec3d rt[FEElement::MAX_NODES];
+	GetCurrentNodalCoordinates(el, rt, m_alphaf);
+
 	// calculate element stiffness matrix
 	for (int n=0; n<nint; ++n)
 	{
 		// calculate jacobian and shape function gradients
-		detJt = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
+		double detJt = FESolidKernels::ShapeGradient(el, n, rt, G)*gw[n]*m_alphaf;
 
 		// setup the material point
 		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
@@ -351,103 +321,82 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
         tens4dmm C = m_pMat->m_secant ? m_pMat->SecantTangent(mp) : m_pMat->Tangent(mp);
 		C.extract(D);
 
-		// we only calculate the upper triangular part
-		// since ke is symmetric. The other part is
-		// determined below using this symmetry.
-		for (int i=0, i3=0; i<neln; ++i, i3 += 3)
+		FESolidKernels::MaterialStiffness(neln, G, D, detJt, ke);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
+{
+	// repeat over all solid elements
+	int NE = Elements();
+
+	// See if we can use colored assembly. In that case, elements of the same color
+	// do not share nodes and are assembled directly via the scatter map without locks.
+	FEGlobalMatrix& K = LS.GetStiffnessMatrix();
+	if (K.ColoredAssembly() && m_assemblyMap.Update(K, *this, [=](FEElement& el, vector<int>& lm) {
+			UnpackLM(el, lm);
+			lm.resize(3 * el.Nodes());
+		}))
+	{
+		for (int c = 0; c < m_assemblyMap.Colors(); ++c)
 		{
-			Gxi = G[i].x;
-			Gyi = G[i].y;
-			Gzi = G[i].z;
+			const vector<int>& elems = m_assemblyMap.ColorElements(c);
+			int NC = (int)elems.size();
 
-			for (int j=0, j3 = 0; j<neln; ++j, j3 += 3)
+			#pragma omp parallel for shared (NC)
+			for (int n = 0; n < NC; ++n)
 			{
-				Gxj = G[j].x;
-				Gyj = G[j].y;
-				Gzj = G[j].z;
-
-				// calculate D*BL matrices
-				DBL[0][0] = (D[0][0]*Gxj+D[0][3]*Gyj+D[0][5]*Gzj);
-				DBL[0][1] = (D[0][1]*Gyj+D[0][3]*Gxj+D[0][4]*Gzj);
-				DBL[0][2] = (D[0][2]*Gzj+D[0][4]*Gyj+D[0][5]*Gxj);
-
-				DBL[1][0] = (D[1][0]*Gxj+D[1][3]*Gyj+D[1][5]*Gzj);
-				DBL[1][1] = (D[1][1]*Gyj+D[1][3]*Gxj+D[1][4]*Gzj);
-				DBL[1][2] = (D[1][2]*Gzj+D[1][4]*Gyj+D[1][5]*Gxj);
-
-				DBL[2][0] = (D[2][0]*Gxj+D[2][3]*Gyj+D[2][5]*Gzj);
-				DBL[2][1] = (D[2][1]*Gyj+D[2][3]*Gxj+D[2][4]*Gzj);
-				DBL[2][2] = (D[2][2]*Gzj+D[2][4]*Gyj+D[2][5]*Gxj);
-
-				DBL[3][0] = (D[3][0]*Gxj+D[3][3]*Gyj+D[3][5]*Gzj);
-				DBL[3][1] = (D[3][1]*Gyj+D[3][3]*Gxj+D[3][4]*Gzj);
-				DBL[3][2] = (D[3][2]*Gzj+D[3][4]*Gyj+D[3][5]*Gxj);
-
-				DBL[4][0] = (D[4][0]*Gxj+D[4][3]*Gyj+D[4][5]*Gzj);
-				DBL[4][1] = (D[4][1]*Gyj+D[4][3]*Gxj+D[4][4]*Gzj);
-				DBL[4][2] = (D[4][2]*Gzj+D[4][4]*Gyj+D[4][5]*Gxj);
-
-				DBL[5][0] = (D[5][0]*Gxj+D[5][3]*Gyj+D[5][5]*Gzj);
-				DBL[5][1] = (D[5][1]*Gyj+D[5][3]*Gxj+D[5][4]*Gzj);
-				DBL[5][2] = (D[5][2]*Gzj+D[5][4]*Gyj+D[5][5]*Gxj);
-
-				ke[i3  ][j3  ] += (Gxi*DBL[0][0] + Gyi*DBL[3][0] + Gzi*DBL[5][0] )*detJt;
-				ke[i3  ][j3+1] += (Gxi*DBL[0][1] + Gyi*DBL[3][1] + Gzi*DBL[5][1] )*detJt;
-				ke[i3  ][j3+2] += (Gxi*DBL[0][2] + Gyi*DBL[3][2] + Gzi*DBL[5][2] )*detJt;
-
-				ke[i3+1][j3  ] += (Gyi*DBL[1][0] + Gxi*DBL[3][0] + Gzi*DBL[4][0] )*detJt;
-				ke[i3+1][j3+1] += (Gyi*DBL[1][1] + Gxi*DBL[3][1] + Gzi*DBL[4][1] )*detJt;
-				ke[i3+1][j3+2] += (Gyi*DBL[1][2] + Gxi*DBL[3][2] + Gzi*DBL[4][2] )*detJt;
-
-				ke[i3+2][j3  ] += (Gzi*DBL[2][0] + Gyi*DBL[4][0] + Gxi*DBL[5][0] )*detJt;
-				ke[i3+2][j3+1] += (Gzi*DBL[2][1] + Gyi*DBL[4][1] + Gxi*DBL[5][1] )*detJt;
-				ke[i3+2][j3+2] += (Gzi*DBL[2][2] + Gyi*DBL[4][2] + Gxi*DBL[5][2] )*detJt;
+				int iel = elems[n];
+				AssembleElementStiffness(LS, iel, m_assemblyMap.ScatterMap(iel));
 			}
 		}
 	}
+	else
+	{
+		#pragma omp parallel for shared (NE)
+		for (int iel=0; iel<NE; ++iel)
+		{
+			AssembleElementStiffness(LS, iel, nullptr);
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
-void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
+void FEElasticSolidDomain::AssembleElementStiffness(FELinearSystem& LS, int iel, const int* scatter)
 {
-	// repeat over all solid elements
-	int NE = Elements();
-	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
-		FESolidElement& el = m_Elem[iel];
+	FESolidElement& el = m_Elem[iel];
 
-		if (el.isActive()) {
+	if (el.isActive()) {
 
-			// get the element's LM vector
-			vector<int> lm;
-			UnpackLM(el, lm);
+		// get the element's LM vector
+		vector<int> lm;
+		UnpackLM(el, lm);
 
-			// element stiffness matrix
-			FEElementMatrix ke(el, lm);
+		// element stiffness matrix
+		FEElementMatrix ke(el, lm);
 
-			// create the element's stiffness matrix
-			int ndof = 3 * el.Nodes();
-			ke.resize(ndof, ndof);
-			ke.zero();
+		// create the element's stiffness matrix
+		int ndof = 3 * el.Nodes();
+		ke.resize(ndof, ndof);
+		ke.zero();
 
-			// calculate geometrical stiffness
-			ElementGeometricalStiffness(el, ke);
+		// calculate geometrical stiffness
+		ElementGeometricalStiffness(el, ke);
 
-			// calculate material stiffness
-			ElementMaterialStiffness(el, ke);
+		// calculate material stiffness
+		ElementMaterialStiffness(el, ke);
 
-/*			// assign symmetic parts
-			// TODO: Can this be omitted by changing the Assemble routine so that it only
-			// grabs elements from the upper diagonal matrix?
-			for (int i = 0; i < ndof; ++i)
-				for (int j = i + 1; j < ndof; ++j)
-					ke[j][i] = ke[i][j];
+/*		// assign symmetic parts
+		// TODO: Can this be omitted by changing the Assemble routine so that it only
+		// grabs elements from the upper diagonal matrix?
+		for (int i = 0; i < ndof; ++i)
+			for (int j = i + 1; j < ndof; ++j)
+				ke[j][i] = ke[i][j];
 */
-			// assemble element matrix in global stiffness matrix
-			LS.Assemble(ke);
-		}
+		// assemble element matrix in global stiffness matrix
+		ke.SetScatterMap(scatter);
+		LS.Assemble(ke);
 	}
 }
 
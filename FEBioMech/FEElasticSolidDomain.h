@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FEElasticDomain.h"
 #include "FESolidMaterial.h"
 #include <FECore/FEDofList.h>
+#include <FECore/FEAssemblyMap.h>
 
 //-----------------------------------------------------------------------------
 //! domain described by Lagrange-type 3D volumetric elements
@@ -116,6 +117,10 @@ public:
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
     
+protected:
+	//! calculate and assemble the stiffness matrix of a single element
+	void AssembleElementStiffness(FELinearSystem& LS, int iel, const int* scatter);
+
 protected:
     double              m_alphaf;
     double              m_alpham;
@@ -132,4 +137,6 @@ protected:
 	FEDofList	m_dof;		// total dof list
 
 	FESolidMaterial*	m_pMat;
+
+	FEAssemblyMap	m_assemblyMap;	// used for colored assembly
 };
@@ -588,6 +588,7 @@ void FEFacet2FacetSliding::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FEFacetSlidingSurface& ms = (np == 0? m_ms : m_ss);
 
 		// loop over all primary surface elements
+		#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, r0) schedule(dynamic)
 		for (int i=0; i<ss.Elements(); ++i)
 		{
 			FESurfaceElement& se = ss.Element(i);
@@ -709,8 +710,27 @@ void FEFacet2FacetSliding::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 
 					for (int k=0; k<ndof; ++k) fe[k] *= tn*detJ[j]*w[j];
 
-					for (int k=0; k<nseln; ++k) ss.m_Fn[se.m_lnode[k]] += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
-					for (int k=0; k<nmeln; ++k) ms.m_Fn[me.m_lnode[k]] += vec3d(fe[3*nseln+3*k], fe[3*nseln+3*k+1], fe[3*nseln+3*k+2]);
+					// nodal forces are shared between elements
+					for (int k=0; k<nseln; ++k)
+					{
+						vec3d& Fn = ss.m_Fn[se.m_lnode[k]];
+						#pragma omp atomic
+						Fn.x += fe[3*k];
+						#pragma omp atomic
+						Fn.y += fe[3*k+1];
+						#pragma omp atomic
+						Fn.z += fe[3*k+2];
+					}
+					for (int k=0; k<nmeln; ++k)
+					{
+						vec3d& Fn = ms.m_Fn[me.m_lnode[k]];
+						#pragma omp atomic
+						Fn.x += fe[3*nseln+3*k];
+						#pragma omp atomic
+						Fn.y += fe[3*nseln+3*k+1];
+						#pragma omp atomic
+						Fn.z += fe[3*nseln+3*k+2];
+					}
 
 					// assemble the global residual
 					R.Assemble(en, LM, fe);
@@ -764,6 +784,8 @@ void FEFacet2FacetSliding::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		FEFacetSlidingSurface& ms = (np == 0? m_ms : m_ss);
 
 		// loop over all primary surface elements
+		// (the primary part of N1 and N2 must stay zero, so each thread copies them)
+		#pragma omp parallel for private(sLM, mLM, LM, en, ke, N, T1, T2, D1, D2, Nb1, Nb2, detJ, w, Hs, Hm, Hmr, Hms, r0) firstprivate(N1, N2) schedule(dynamic)
 		for (int i=0; i<ss.Elements(); ++i)
 		{
 			FESurfaceElement& se = ss.Element(i);
@@ -1038,6 +1060,7 @@ void FEFacet2FacetSliding::UpdateContactPressures()
 		FEFacetSlidingSurface& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all elements of the primary surface
+		#pragma omp parallel for
 		for (int n=0; n<ss.Elements(); ++n)
 		{
 			FESurfaceElement& el = ss.Element(n);
@@ -1092,6 +1115,7 @@ bool FEFacet2FacetSliding::Augment(int naug, const FETimeInfo& tp)
 	int NM = (int) m_ms.Elements();
 
 	double normL0 = 0;
+	#pragma omp parallel for reduction(+:normL0)
 	for (int i=0; i<NS; ++i)
 	{
 		FESurfaceElement& el = m_ss.Element(i);
@@ -1102,6 +1126,7 @@ bool FEFacet2FacetSliding::Augment(int naug, const FETimeInfo& tp)
 			normL0 += ds.m_Lm*ds.m_Lm;
 		}
 	}
+	#pragma omp parallel for reduction(+:normL0)
 	for (int i=0; i<NM; ++i)
 	{
 		FESurfaceElement& el = m_ms.Element(i);
@@ -1120,7 +1145,8 @@ bool FEFacet2FacetSliding::Augment(int naug, const FETimeInfo& tp)
 	double normg1 = 0;	// gap norm
 	int N = 0;
     double Ln;
-    for (int i=0; i<m_ss.Elements(); ++i) {
+    #pragma omp parallel for private(Ln) reduction(+:normL1,normg1,N)
+    for (int i=0; i<NS; ++i) {
         FESurfaceElement& el = m_ss.Element(i);
         vec3d tn[FEElement::MAX_INTPOINTS];
         if (m_bsmaug) m_ss.GetGPSurfaceTraction(i, tn);
@@ -1149,7 +1175,8 @@ bool FEFacet2FacetSliding::Augment(int naug, const FETimeInfo& tp)
         }
     }
     
-    for (int i=0; i<m_ms.Elements(); ++i) {
+    #pragma omp parallel for private(Ln) reduction(+:normL1,normg1,N)
+    for (int i=0; i<NM; ++i) {
         FESurfaceElement& el = m_ms.Element(i);
         vec3d tn[FEElement::MAX_INTPOINTS];
         if (m_bsmaug) m_ms.GetGPSurfaceTraction(i, tn);
@@ -1208,6 +1235,7 @@ bool FEFacet2FacetSliding::Augment(int naug, const FETimeInfo& tp)
 	if (bconv == false)
 	{
 		// we did not converge so update multipliers
+		#pragma omp parallel for
 		for (int i=0; i<NS; ++i)
 		{
 			FESurfaceElement& el = m_ss.Element(i);
@@ -1224,6 +1252,7 @@ bool FEFacet2FacetSliding::Augment(int naug, const FETimeInfo& tp)
 			}
 		}	
 
+		#pragma omp parallel for
 		for (int i=0; i<NM; ++i)
 		{
 			FESurfaceElement& el = m_ms.Element(i);
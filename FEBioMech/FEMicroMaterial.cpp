@@ -40,6 +40,7 @@ SOFTWARE.*/
 #include <FECore/mat6d.h>
 #include "FEBCPrescribedDeformation.h"
 #include <sstream>
+#include <typeinfo>
 
 //=============================================================================
 FERVEProbe::FERVEProbe(FEModel& fem, FEModel& rve, const char* szfile) : FECallBack(&fem, CB_ALWAYS), m_rve(rve), m_file(szfile) 
@@ -93,6 +94,13 @@ FEMicroMaterialPoint::FEMicroMaterialPoint(FEMaterialPoint* mp) : FEMaterialPoin
 	
 	m_macro_energy_inc = 0.;
 	m_micro_energy_inc = 0.;
+
+	m_rveSolved = false;
+	m_rveStress.zero();
+	m_rveHasTangent = false;
+	m_rveTangent.zero();
+	m_rveCachePending = false;
+	m_rveF.unit();
 }
 
 //-----------------------------------------------------------------------------
@@ -165,6 +173,11 @@ BEGIN_FECORE_CLASS(FEMicroMaterial, FEElasticMaterial)
 	ADD_PARAMETER(m_szbc     , "bc_set"  );
 	ADD_PARAMETER(m_bctype   , "rve_type" );
 	ADD_PARAMETER(m_scale	 , "scale"   ); 
+	ADD_PARAMETER(m_bparallel, "parallel_rve");
+	ADD_PARAMETER(m_bcache   , "rve_cache");
+	ADD_PARAMETER(m_cacheTol , "rve_cache_tol");
+	ADD_PARAMETER(m_cacheStressTol, "rve_cache_stress_tol");
+	ADD_PARAMETER(m_cacheSize, "rve_cache_size");
 
 	ADD_PROPERTY(m_probe, "probe", false);
 
@@ -178,6 +191,12 @@ FEMicroMaterial::FEMicroMaterial(FEModel* pfem) : FEElasticMaterial(pfem)
 	m_szbc[0] = 0;
 	m_bctype = FERVEModel::DISPLACEMENT;	// use displacement BCs by default
 	m_scale = 1.0;
+	m_bparallel = true;
+	m_bcache = false;
+	m_cacheTol = 1e-4;
+	m_cacheStressTol = 1e-3;
+	m_cacheSize = 0;
+	m_bcacheCB = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -191,6 +210,32 @@ FEMaterialPoint* FEMicroMaterial::CreateMaterialPointData()
 	return new FEMicroMaterialPoint(new FEElasticMaterialPoint);
 }
 
+//-----------------------------------------------------------------------------
+// callback that prints the RVE cache statistics after each converged time step
+static bool rve_cache_cb(FEModel* pfem, unsigned int nwhen, void* pd)
+{
+	FEMicroMaterial* pmat = (FEMicroMaterial*)pd;
+	pmat->LogCacheStats();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// See if the state of the RVE depends on its deformation history. This is assumed
+// when any of the RVE materials stores more than the elastic material point data
+// (e.g. damage, plasticity, viscoelasticity).
+static bool rve_has_history(FEModel& rve)
+{
+	for (int i = 0; i < rve.Materials(); ++i)
+	{
+		FEMaterialPoint* mp = rve.GetMaterial(i)->CreateMaterialPointData();
+		if (mp == nullptr) continue;
+		bool bhist = ((typeid(*mp) != typeid(FEElasticMaterialPoint)) || (mp->Next() != nullptr));
+		delete mp;
+		if (bhist) return true;
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 bool FEMicroMaterial::Init()
 {
@@ -221,44 +266,149 @@ bool FEMicroMaterial::Init()
 		feLogError("An error occurred preparing RVE model"); return false;
 	}
 
+	// The cache returns a response without updating the RVE of the material point,
+	// so it cannot be used when the RVE response depends on its history.
+	if (m_bcache && rve_has_history(m_mrve))
+	{
+		feLogWarning("The RVE materials are path dependent. The RVE cache is disabled.");
+		m_bcache = false;
+	}
+
+	// setup the RVE response cache
+	if (m_bcache)
+	{
+		if (m_cacheTol <= 0.0) { feLogError("rve_cache_tol must be positive"); return false; }
+		if (m_cacheStressTol <= 0.0) { feLogError("rve_cache_stress_tol must be positive"); return false; }
+		m_cache.SetTolerance(m_cacheTol);
+		m_cache.SetStressTolerance(m_cacheStressTol);
+		m_cache.SetMaxEntries(m_cacheSize);
+		m_cache.Clear();
+
+		// Init can be called more than once, so make sure we only register the callback once
+		if (m_bcacheCB == false)
+		{
+			GetFEModel()->AddCallback(rve_cache_cb, CB_MAJOR_ITERS, this);
+			m_bcacheCB = true;
+		}
+	}
+
 	return true;
 }
 
 //-----------------------------------------------------------------------------
-// Note that this function is not used in the first-order implemenetation
-mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
+void FEMicroMaterial::LogCacheStats()
+{
+	int hits = m_cache.Hits();
+	int misses = m_cache.Misses();
+	int total = hits + misses;
+	double ratio = (total > 0 ? 100.0*hits / total : 0.0);
+	feLog("RVE cache (material %d): %d hits, %d misses (%.1lf%%), %d entries, max. estimated stress error = %lg\n", GetID(), hits, misses, ratio, m_cache.Entries(), m_cache.MaxError());
+	m_cache.ResetStats();
+}
+
+//-----------------------------------------------------------------------------
+//! Solve the RVE of this material point for the current deformation gradient.
+//! The averaged stress is stored at the material point and returned by the next
+//! call to Stress. This only touches the data of this material point, so the
+//! multiscale domain can call it concurrently for all its material points.
+bool FEMicroMaterial::SolveRVE(FEMaterialPoint& mp)
 {
 	// get the deformation gradient
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
 	mat3d F = pt.m_F;
-	
+	mmpt.m_rveSolved = false;
+	mmpt.m_rveHasTangent = false;
+	mmpt.m_rveCachePending = false;
+
+	// See if a nearby deformation gradient was already solved.
+	// Note that on a hit, the RVE of this point is not updated. This is fine since the
+	// cache is only used for path-independent RVEs (see Init), so the next RVE solve 
+	// only starts from a different initial configuration.
+	if (m_bcache)
+	{
+		FERVEResponseCache::Entry e;
+		double err = 0.0;
+		if (m_cache.Find(F, e, err))
+		{
+			mmpt.m_rveStress = e.s;
+			mmpt.m_rveTangent = e.C;
+			mmpt.m_micro_energy = e.W;
+			mmpt.m_rveHasTangent = true;
+			mmpt.m_rveSolved = true;
+			return true;
+		}
+	}
+
 	// update the BC's
 	mmpt.m_rve.Update(F);
 
 	// solve the RVE
-	bool bret = mmpt.m_rve.Solve();
-
-	// make sure it converged
-	if (bret == false) throw FEMultiScaleException(-1, -1);
+	if (mmpt.m_rve.Solve() == false) return false;
 
 	// calculate the averaged Cauchy stress
-	mat3ds sa = mmpt.m_rve.StressAverage(mp);
-	
+	mmpt.m_rveStress = mmpt.m_rve.StressAverage(mp);
+
 	// calculate the difference between the macro and micro energy for Hill-Mandel condition
-	mmpt.m_micro_energy = micro_energy(mmpt.m_rve);	
-	
-	return sa;
+	mmpt.m_micro_energy = micro_energy(mmpt.m_rve);
+
+	// The cache entry needs the stiffness, which is expensive, so the response 
+	// is only added to the cache when the tangent is requested (see Tangent).
+	if (m_bcache)
+	{
+		mmpt.m_rveF = F;
+		mmpt.m_rveCachePending = true;
+	}
+
+	mmpt.m_rveSolved = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Returns the averaged RVE stress. The RVE is only solved here if the domain
+// did not already solve it (see SolveRVE).
+mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
+{
+	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
+
+	// solve the RVE, unless the domain already did this
+	if (mmpt.m_rveSolved == false)
+	{
+		// make sure it converged
+		if (SolveRVE(mp) == false) throw FEMultiScaleException(-1, -1);
+	}
+	mmpt.m_rveSolved = false;
+
+	return mmpt.m_rveStress;
 }
 
 //-----------------------------------------------------------------------------
-// The stiffness is evaluated at the same time the stress is evaluated so we 
-// can just return it here. Note that this assumes that the stress function 
-// is always called prior to the tangent function.
+// The stiffness is evaluated for the RVE state of the last stress evaluation. 
+// Note that this assumes that the stress function is always called prior to 
+// the tangent function. If the RVE cache is used, the response of the last RVE 
+// solve is added to the cache here.
 tens4ds FEMicroMaterial::Tangent(FEMaterialPoint &mp)
 {
 	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
-	return mmpt.m_rve.StiffnessAverage(mp);
+	if (mmpt.m_rveHasTangent) return mmpt.m_rveTangent;
+
+	tens4ds C = mmpt.m_rve.StiffnessAverage(mp);
+
+	if (mmpt.m_rveCachePending)
+	{
+		FERVEResponseCache::Entry e;
+		e.F = mmpt.m_rveF;
+		e.s = mmpt.m_rveStress;
+		e.C = C;
+		e.W = mmpt.m_micro_energy;
+		m_cache.Add(e);
+
+		mmpt.m_rveTangent = C;
+		mmpt.m_rveHasTangent = true;
+		mmpt.m_rveCachePending = false;
+	}
+
+	return C;
 }
 
 //-----------------------------------------------------------------------------
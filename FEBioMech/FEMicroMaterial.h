@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include "FEPeriodicBoundary1O.h"
 #include "FECore/FECallBack.h"
 #include "FERVEModel.h"
+#include "FERVEResponseCache.h"
 
 //-----------------------------------------------------------------------------
 class FEBioPlotFile;
@@ -91,6 +92,13 @@ public:
 	double	   m_micro_energy_inc;	// Microscopic strain energy increment
 
 	FERVEModel	m_rve;				// Local copy of the parent rve
+
+	bool		m_rveSolved;		// the RVE was solved ahead of the next Stress call (see FEMicroMaterial::SolveRVE)
+	mat3ds		m_rveStress;		// averaged Cauchy stress of the last RVE solve
+	bool		m_rveHasTangent;	// m_rveTangent is valid (only used with the RVE cache)
+	tens4ds		m_rveTangent;		// averaged stiffness of the last RVE solve or cache hit
+	bool		m_rveCachePending;	// the last RVE solve still needs to be added to the cache (see FEMicroMaterial::Tangent)
+	mat3d		m_rveF;				// deformation gradient of the last RVE solve
 };
 
 //-----------------------------------------------------------------------------
@@ -130,6 +138,11 @@ public:
 	std::string	m_szbc;		//!< name of nodeset defining boundary
 	int			m_bctype;		//!< periodic bc flag
 	double		m_scale;		//!< RVE scale factor
+	bool		m_bparallel;	//!< solve the RVEs of all material points concurrently
+	bool		m_bcache;		//!< use the RVE response cache
+	double		m_cacheTol;		//!< tolerance on deformation gradient for cache hits
+	double		m_cacheStressTol;	//!< relative tolerance on the estimated stress error of cache hits
+	int			m_cacheSize;	//!< max number of cache entries (0 = no limit)
 	FERVEModel	m_mrve;			//!< the parent RVE (Representive Volume Element)
 
 public:
@@ -145,6 +158,9 @@ public:
 	//! create material point data
 	FEMaterialPoint* CreateMaterialPointData() override;
 
+	//! solve the RVE of a material point and store the averaged stress
+	bool SolveRVE(FEMaterialPoint& mp);
+
 	// calculate the average PK1 stress
 	mat3d AveragedStressPK1(FEModel& rve, FEMaterialPoint &mp);
 
@@ -154,6 +170,9 @@ public:
 	// average RVE energy
 	double micro_energy(FEModel& rve);
 
+	// print the RVE cache statistics to the log
+	void LogCacheStats();
+
 public:
 	int Probes() { return (int) m_probe.size(); }
 	FEMicroProbe& Probe(int i) { return *m_probe[i]; }
@@ -161,6 +180,9 @@ public:
 protected:
 	std::vector<FEMicroProbe*>	m_probe;
 
+	FERVEResponseCache	m_cache;	//!< cache of RVE responses
+	bool				m_bcacheCB;	//!< the cache statistics callback was registered
+
 public:
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
@@ -42,6 +42,10 @@ FEMicroMaterialPoint2O::FEMicroMaterialPoint2O(FEMaterialPoint* mp) : FEMaterial
 {
 	m_elem_id = -1;
 	m_gpt_id = -1;
+
+	m_rveSolved = false;
+	m_rveP.zero();
+	m_rveQ.zero();
 }
 
 //-----------------------------------------------------------------------------
@@ -68,6 +72,7 @@ BEGIN_FECORE_CLASS(FEMicroMaterial2O, FEElasticMaterial2O)
 	ADD_PARAMETER(m_szbc     , "bc_set"  );
 	ADD_PARAMETER(m_rveType  , "rve_type" );
 	ADD_PARAMETER(m_scale    , "scale");
+	ADD_PARAMETER(m_bparallel, "parallel_rve");
 
 	ADD_PROPERTY(m_probe, "probe", false);
 
@@ -81,6 +86,7 @@ FEMicroMaterial2O::FEMicroMaterial2O(FEModel* pfem) : FEElasticMaterial2O(pfem)
 	m_szbc[0] = 0;
 	m_rveType = FERVEModel2O::DISPLACEMENT;
 	m_scale = 1.0;
+	m_bparallel = true;
 }
 
 //-----------------------------------------------------------------------------
@@ -122,25 +128,47 @@ bool FEMicroMaterial2O::Init()
 }
 
 //-----------------------------------------------------------------------------
-void FEMicroMaterial2O::Stress(FEMaterialPoint &mp, mat3d& P, tens3drs& Q)
+//! Solve the RVE of this material point for the current deformation gradient 
+//! and its gradient. The averaged stresses are stored at the material point and
+//! returned by the next call to Stress. Since this only touches the data of this
+//! material point, the multiscale domain can call it concurrently.
+bool FEMicroMaterial2O::SolveRVE(FEMaterialPoint& mp)
 {
 	// get the deformation gradient and its gradient
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 	FEElasticMaterialPoint2O& pt2 = *mp.ExtractData<FEElasticMaterialPoint2O>();
 	FEMicroMaterialPoint2O& mmpt2O = *mp.ExtractData<FEMicroMaterialPoint2O>();
+	mmpt2O.m_rveSolved = false;
 
 	// get the deformation gradient and its gradient
 	const mat3d& F = pt.m_F;
 	const tens3drs& G = pt2.m_G;
 
 	// solve the RVE
-	bool bret = mmpt2O.m_rve.Solve(F, G);
+	if (mmpt2O.m_rve.Solve(F, G) == false) return false;
 
-	// make sure it converged
-	if (bret == false) throw FEMultiScaleException(mmpt2O.m_elem_id, mmpt2O.m_gpt_id);
+	// calculate the averaged stresses
+	mmpt2O.m_rve.AveragedStress2O(mmpt2O.m_rveP, mmpt2O.m_rveQ);
+
+	mmpt2O.m_rveSolved = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEMicroMaterial2O::Stress(FEMaterialPoint &mp, mat3d& P, tens3drs& Q)
+{
+	FEMicroMaterialPoint2O& mmpt2O = *mp.ExtractData<FEMicroMaterialPoint2O>();
+
+	// solve the RVE, unless the domain already did this
+	if (mmpt2O.m_rveSolved == false)
+	{
+		// make sure it converged
+		if (SolveRVE(mp) == false) throw FEMultiScaleException(mmpt2O.m_elem_id, mmpt2O.m_gpt_id);
+	}
+	mmpt2O.m_rveSolved = false;
 
-	// calculate the averaged Cauchy stress
-	mmpt2O.m_rve.AveragedStress2O(P, Q);
+	P = mmpt2O.m_rveP;
+	Q = mmpt2O.m_rveQ;
 }
 
 //-----------------------------------------------------------------------------
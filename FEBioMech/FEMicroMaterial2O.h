@@ -54,6 +54,10 @@ public:
 	FEMicroModel2O m_rve;				//!< local copy of the rve		
 	int		m_elem_id;		//!< element ID
 	int		m_gpt_id;		//!< Gauss point index (0-based)
+
+	bool		m_rveSolved;	//!< the RVE was solved ahead of the next Stress call
+	mat3d		m_rveP;			//!< averaged PK1 stress of the last RVE solve
+	tens3drs	m_rveQ;			//!< averaged higher-order stress of the last RVE solve
 };
 
 //-----------------------------------------------------------------------------
@@ -72,6 +76,7 @@ public:
 	std::string		m_szbc;			//!< name of nodeset defining boundary
 	int				m_rveType;		//!< RVE type
 	double			m_scale;		//!< geometry scale factor
+	bool			m_bparallel;	//!< solve the RVEs of all material points concurrently
 	FERVEModel2O	m_mrve;			//!< the parent RVE (Representive Volume Element)
 
 public:
@@ -87,6 +92,9 @@ public:
 	//! create material point data
 	FEMaterialPoint* CreateMaterialPointData() override;
 
+	//! solve the RVE of a material point and store the averaged stresses
+	bool SolveRVE(FEMaterialPoint& mp);
+
 public:
 	int Probes() { return (int) m_probe.size(); }
 	FEMicroProbe& Probe(int i) { return *m_probe[i]; }
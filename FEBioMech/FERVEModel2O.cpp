@@ -400,6 +400,9 @@ bool FEMicroModel2O::Init(FERVEModel2O& rve)
 	// copy the parent RVE
 	CopyFrom(rve);
 
+	// the material point RVEs are solved concurrently, so they should not output anything
+	BlockLog();
+
 	// initialize model
 	if (FEModel::Init() == false) return false;
 
@@ -0,0 +1,141 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FERVEResponseCache.h"
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FERVEResponseCache::FERVEResponseCache()
+{
+	m_tol = 1e-4;
+	m_stol = 1e-3;
+	m_maxEntries = 0;
+	m_entries = 0;
+	ResetStats();
+}
+
+//-----------------------------------------------------------------------------
+void FERVEResponseCache::ResetStats()
+{
+	m_hits = 0;
+	m_misses = 0;
+	m_maxErr = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+void FERVEResponseCache::Clear()
+{
+	#pragma omp critical (rve_cache)
+	{
+		m_bin.clear();
+		m_entries = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// hash of the deformation gradient quantized by the tolerance
+size_t FERVEResponseCache::key(const mat3d& F) const
+{
+	size_t h = 0;
+	for (int i=0; i<3; ++i)
+		for (int j=0; j<3; ++j)
+		{
+			long long q = (long long) floor(F(i,j) / m_tol + 0.5);
+			h ^= std::hash<long long>()(q) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		}
+	return h;
+}
+
+//-----------------------------------------------------------------------------
+bool FERVEResponseCache::Find(const mat3d& F, Entry& e, double& err)
+{
+	if (m_tol <= 0.0) return false;
+
+	size_t k = key(F);
+
+	bool bfound = false;
+	#pragma omp critical (rve_cache)
+	{
+		// find the closest entry in this bin
+		auto it = m_bin.find(k);
+		if (it != m_bin.end())
+		{
+			std::vector<Entry>& bin = it->second;
+			double dmin = m_tol;
+			for (size_t i=0; i<bin.size(); ++i)
+			{
+				double d = (F - bin[i].F).norm();
+				if (d <= dmin) { dmin = d; e = bin[i]; bfound = true; }
+			}
+		}
+	}
+
+	// Estimate the error as the first-order change of the stress, using
+	// the rate of deformation that takes the cached F to the requested F.
+	// The entry is only used when this error is small enough.
+	if (bfound)
+	{
+		mat3ds D = ((F - e.F)*e.F.inverse()).sym();
+		err = e.C.dot(D).norm();
+		if (err > m_stol*e.s.norm()) bfound = false;
+	}
+
+	#pragma omp critical (rve_cache)
+	{
+		if (bfound)
+		{
+			m_hits++;
+			if (err > m_maxErr) m_maxErr = err;
+		}
+		else m_misses++;
+	}
+
+	return bfound;
+}
+
+//-----------------------------------------------------------------------------
+void FERVEResponseCache::Add(const Entry& e)
+{
+	if (m_tol <= 0.0) return;
+
+	size_t k = key(e.F);
+
+	#pragma omp critical (rve_cache)
+	{
+		// when the cache is full we start over, since older entries
+		// are less likely to be hit again
+		if ((m_maxEntries > 0) && (m_entries >= m_maxEntries))
+		{
+			m_bin.clear();
+			m_entries = 0;
+		}
+
+		m_bin[k].push_back(e);
+		m_entries++;
+	}
+}
@@ -0,0 +1,112 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/mat3d.h>
+#include <FECore/tens4d.h>
+#include <vector>
+#include <unordered_map>
+
+//-----------------------------------------------------------------------------
+//! Cache of RVE responses, used by the multiscale materials.
+//! The cache stores the averaged stress and stiffness for the deformation gradients
+//! for which the RVE was solved. A deformation gradient that lies within the tolerance
+//! of a stored one returns the stored response, so that the RVE does not need to be
+//! solved again. The entries are binned on the deformation gradient quantized by the
+//! tolerance, so only the bin of the deformation gradient is searched.
+//! A stored response is only returned when the estimated stress error of using it
+//! (the first-order change C:D of the stress) is within the stress tolerance.
+//! The cache can be accessed concurrently.
+class FERVEResponseCache
+{
+public:
+	struct Entry
+	{
+		mat3d	F;		//!< deformation gradient
+		mat3ds	s;		//!< averaged Cauchy stress
+		tens4ds	C;		//!< averaged spatial stiffness
+		double	W;		//!< averaged micro energy
+
+		Entry() : W(0.0) {}
+		Entry(const Entry& e) : s(e.s), C(e.C), W(e.W) { F = e.F; }
+		Entry& operator = (const Entry& e)
+		{
+			F = e.F;
+			s = e.s;
+			C = e.C;
+			W = e.W;
+			return *this;
+		}
+	};
+
+public:
+	FERVEResponseCache();
+
+	//! set the tolerance on the (Frobenius) norm of the difference of deformation gradients
+	void SetTolerance(double tol) { m_tol = tol; }
+
+	//! set the tolerance on the estimated stress error, relative to the norm of the stored stress
+	void SetStressTolerance(double tol) { m_stol = tol; }
+
+	//! set the max number of entries (0 = no limit)
+	void SetMaxEntries(int n) { m_maxEntries = n; }
+
+	//! find the closest entry within tolerance of F. The entry is rejected if the 
+	//! estimated stress error is larger than the stress tolerance.
+	//! On success, err is an estimate of the stress error of using the cached response.
+	bool Find(const mat3d& F, Entry& e, double& err);
+
+	//! add an entry to the cache
+	void Add(const Entry& e);
+
+	//! clear the cache
+	void Clear();
+
+	//! number of entries
+	int Entries() const { return m_entries; }
+
+public:
+	//! statistics since the last call to ResetStats
+	int Hits() const { return m_hits; }
+	int Misses() const { return m_misses; }
+	double MaxError() const { return m_maxErr; }
+	void ResetStats();
+
+private:
+	size_t key(const mat3d& F) const;
+
+private:
+	double	m_tol;
+	double	m_stol;
+	int		m_maxEntries;
+	int		m_entries;
+	std::unordered_map<size_t, std::vector<Entry> >	m_bin;
+
+	int		m_hits;
+	int		m_misses;
+	double	m_maxErr;
+};
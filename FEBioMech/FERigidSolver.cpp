@@ -305,8 +305,23 @@ void FERigidSolver::PrepStep(const FETimeInfo& timeInfo, vector<double>& ui)
 }
 
 //-----------------------------------------------------------------------------
-//! This function calculates the rigid stiffness matrices
-void FERigidSolver::RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<double>& F, const FEElementMatrix& ke, double alpha)
+//! See if any of the nodes is a rigid interface node
+bool FERigidSolver::IsRigidCoupled(const vector<int>& en) const
+{
+	if ((m_fem == nullptr) || (m_fem->RigidBodies() == 0)) return false;
+
+	FEMesh& mesh = m_fem->GetMesh();
+	for (size_t j = 0; j < en.size(); ++j)
+	{
+		if ((en[j] >= 0) && (mesh.Node(en[j]).m_rid >= 0)) return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+//! This function calculates the rigid stiffness matrices and stores the
+//! contributions in the buffer
+void FERigidSolver::RigidStiffness(FEStiffnessBuffer& buf, const vector<double>& ui, const FEElementMatrix& ke, double alpha)
 {
 	if (m_fem == nullptr) return;
 
@@ -326,16 +341,16 @@ void FERigidSolver::RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<d
 		}
     }
     if (bclamped_shell)
-        RigidStiffnessShell(K, ui, F, en, ke.RowIndices(), ke.ColumnsIndices(), ke, alpha);
+        RigidStiffnessShell(buf, ui, en, ke.RowIndices(), ke.ColumnsIndices(), ke, alpha);
     else
-        RigidStiffnessSolid(K, ui, F, en, ke.RowIndices(), ke.ColumnsIndices(), ke, alpha);
+        RigidStiffnessSolid(buf, ui, en, ke.RowIndices(), ke.ColumnsIndices(), ke, alpha);
     return;
 }
 
 //-----------------------------------------------------------------------------
 //! This function calculates the rigid stiffness matrices
 //! correct stiffness matrix for rigid-solid interfaces
-void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vector<double>& F, const vector<int>& en, const vector<int>& elmi, const std::vector<int>& elmj, const matrix& ke, double alpha)
+void FERigidSolver::RigidStiffnessSolid(FEStiffnessBuffer& buf, const vector<double>& ui, const vector<int>& en, const vector<int>& elmi, const std::vector<int>& elmj, const matrix& ke, double alpha)
 {
 	if (m_fem == nullptr) return;
 	FEMechModel& fem = *m_fem;
@@ -447,8 +462,8 @@ void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vec
                             if (I >= 0)
                             {
                                 // multiply KR by alpha for alpha rule
-                                if (J < -1) F[I] -= KR[l][k]*ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KR[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KR[l][k]*ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KR[l][k]);
                             }
                         }
                     
@@ -471,8 +486,8 @@ void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vec
                             if (I >= 0)
                             {
                                 // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                     
@@ -492,8 +507,8 @@ void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vec
                             
                             if (I >= 0)
                             {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                     
@@ -521,8 +536,8 @@ void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vec
                             if (I >= 0)
                             {
                                 // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                 }
@@ -570,8 +585,8 @@ void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vec
                             
                             if (I >= 0)
                             {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                 }
@@ -583,7 +598,7 @@ void FERigidSolver::RigidStiffnessSolid(SparseMatrix& K, vector<double>& ui, vec
 //-----------------------------------------------------------------------------
 //! This function calculates the rigid stiffness matrices
 //! correct stiffness matrix for rigid bodies accounting for rigid-body-deformable-shell interfaces
-void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vector<double>& F, const vector<int>& en, const vector<int>& elmi, const vector<int>& elmj, const matrix& ke, double alpha)
+void FERigidSolver::RigidStiffnessShell(FEStiffnessBuffer& buf, const vector<double>& ui, const vector<int>& en, const vector<int>& elmi, const vector<int>& elmj, const matrix& ke, double alpha)
 {
 	if (m_fem == nullptr) return;
 	FEMechModel& fem = *m_fem;
@@ -713,8 +728,8 @@ void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vec
                             if (I >= 0)
                             {
                                 // multiply KR by alpha for alpha rule
-                                if (J < -1) F[I] -= KR[l][k]*ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KR[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KR[l][k]*ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KR[l][k]);
                             }
                         }
                     
@@ -738,8 +753,8 @@ void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vec
                             if (I >= 0)
                             {
                                 // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                     
@@ -761,8 +776,8 @@ void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vec
                             
                             if (I >= 0)
                             {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                     
@@ -791,8 +806,8 @@ void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vec
                             if (I >= 0)
                             {
                                 // multiply KF by alpha for alpha rule
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                 }
@@ -846,8 +861,8 @@ void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vec
                             
                             if (I >= 0)
                             {
-                                if (J < -1) F[I] -= KF[l][k] * ui[-J - 2];
-                                else if (J >= 0) K.add(I, J, KF[l][k]);
+                                if (J < -1) buf.AddRHS(I, -KF[l][k] * ui[-J - 2]);
+                                else if (J >= 0) buf.Add(I, J, KF[l][k]);
                             }
                         }
                 }
@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FEBodyForce.h"
 #include <FECore/FETimeInfo.h>
 #include <FECore/FESolver.h>
+#include <FECore/FEStiffnessBuffer.h>
 #include <vector>
 
 //-----------------------------------------------------------------------------
@@ -62,14 +63,17 @@ public:
 	// This is called at the start of each time step
 	void PrepStep(const FETimeInfo& timeInfo, vector<double>& ui);
 
-	// correct stiffness matrix for rigid bodies
-	void RigidStiffness(SparseMatrix& K, std::vector<double>& ui, std::vector<double>& F, const FEElementMatrix& ke, double alpha);
+	// see if any of the nodes are attached to a rigid body
+	bool IsRigidCoupled(const std::vector<int>& en) const;
+
+	// correct stiffness matrix for rigid bodies (the corrections are stored in the buffer)
+	void RigidStiffness(FEStiffnessBuffer& buf, const std::vector<double>& ui, const FEElementMatrix& ke, double alpha);
 
     // correct stiffness matrix for rigid bodies accounting for rigid-body-deformable-shell interfaces
-    void RigidStiffnessSolid(SparseMatrix& K, std::vector<double>& ui, std::vector<double>& F, const std::vector<int>& en, const std::vector<int>& lmi, const std::vector<int>& lmj, const matrix& ke, double alpha);
+    void RigidStiffnessSolid(FEStiffnessBuffer& buf, const std::vector<double>& ui, const std::vector<int>& en, const std::vector<int>& lmi, const std::vector<int>& lmj, const matrix& ke, double alpha);
     
     // correct stiffness matrix for rigid bodies accounting for rigid-body-deformable-shell interfaces
-    void RigidStiffnessShell(SparseMatrix& K, std::vector<double>& ui, std::vector<double>& F, const std::vector<int>& en, const std::vector<int>& lmi, const std::vector<int>& lmj, const matrix& ke, double alpha);
+    void RigidStiffnessShell(FEStiffnessBuffer& buf, const std::vector<double>& ui, const std::vector<int>& en, const std::vector<int>& lmi, const std::vector<int>& lmj, const matrix& ke, double alpha);
     
 	// adjust residual for rigid-deformable interface nodes
 	void AssembleResidual(int node_id, int dof, double f, std::vector<double>& R);
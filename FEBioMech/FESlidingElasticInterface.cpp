@@ -939,9 +939,14 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
         FESlidingElasticSurface& ss = (np == 0? m_ss : m_ms);
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
+        // The net contact forces are first collected per element, so that the
+        // sum does not depend on the number of threads.
+        int NE = ss.Elements();
+        vector<vec3d> Fs(NE, vec3d(0,0,0)), Fm(NE, vec3d(0,0,0));
+
         // loop over all primary elements
-        //#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hm, N)
-        for (int i=0; i<ss.Elements(); ++i)
+        #pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hm, N) schedule(dynamic)
+        for (int i=0; i<NE; ++i)
         {
             // get the surface element
             FESurfaceElement& se = ss.Element(i);
@@ -1050,12 +1055,12 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                         // calculate contact forces
                         for (int k=0; k<nseln; ++k)
                         {
-                            ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                            Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
                         }
                         
                         for (int k = 0; k<nmeln; ++k)
                         {
-                            ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                            Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
                         }
                         
                         // assemble the global residual
@@ -1064,6 +1069,12 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                 }
             }
         }
+
+        for (int i=0; i<NE; ++i)
+        {
+            ss.m_Ft += Fs[i];
+            ms.m_Ft += Fm[i];
+        }
     }
 }
 
@@ -1091,7 +1102,7 @@ void FESlidingElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETime
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
         // loop over all primary elements
-        //#pragma omp parallel for private(detJ, w, Hm, N, sLM, mLM, LM, en, ke)
+        #pragma omp parallel for private(detJ, w, Hm, N, sLM, mLM, LM, en, ke) schedule(dynamic)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get ths primary element
@@ -1619,6 +1630,7 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
     // --- c a l c u l a t e   i n i t i a l   n o r m s ---
     // a. normal component
     double normL0 = 0;
+    #pragma omp parallel for reduction(+:normL0)
     for (int i=0; i<NS; ++i)
     {
 		FESurfaceElement& se = m_ss.Element(i);
@@ -1631,6 +1643,7 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
                 normL0 += ds.m_Lmd*ds.m_Lmd;
         }
     }
+    #pragma omp parallel for reduction(+:normL0)
     for (int i=0; i<NM; ++i)
     {
 		FESurfaceElement& me = m_ms.Element(i);
@@ -1649,9 +1662,14 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
     // (is calculated during update)
     double maxgap = 0;
     
+    // max gap of each element
+    vector<double> gmax(NS > NM ? NS : NM);
+    
     // update Lagrange multipliers
     double normL1 = 0;
-    for (int i=0; i<m_ss.Elements(); ++i) {
+    #pragma omp parallel for private(Ln) reduction(+:normL1)
+    for (int i=0; i<NS; ++i) {
+        gmax[i] = 0;
         FESurfaceElement& el = m_ss.Element(i);
         vec3d tn[FEElement::MAX_INTPOINTS];
         if (m_bsmaug) m_ss.GetGPSurfaceTraction(i, tn);
@@ -1674,8 +1692,8 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
                 normL1 += data.m_Lmt*data.m_Lmt;
                 
                 if (m_btension)
-                    maxgap = max(maxgap,data.m_dg.norm());
-                else if (Ln > 0) maxgap = max(maxgap,data.m_dg.norm());
+                    gmax[i] = max(gmax[i],data.m_dg.norm());
+                else if (Ln > 0) gmax[i] = max(gmax[i],data.m_dg.norm());
             }
             else {
                 // if slip, augment normal traction
@@ -1694,13 +1712,17 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
                 normL1 += data.m_Lmd*data.m_Lmd;
                 
                 if (m_btension)
-                    maxgap = max(maxgap,fabs(data.m_gap));
-                else if (Ln > 0) maxgap = max(maxgap,fabs(data.m_gap));
+                    gmax[i] = max(gmax[i],fabs(data.m_gap));
+                else if (Ln > 0) gmax[i] = max(gmax[i],fabs(data.m_gap));
             }
         }
     }
     
-    for (int i=0; i<m_ms.Elements(); ++i) {
+    for (int i=0; i<NS; ++i) maxgap = max(maxgap, gmax[i]);
+    
+    #pragma omp parallel for private(Ln) reduction(+:normL1)
+    for (int i=0; i<NM; ++i) {
+        gmax[i] = 0;
         FESurfaceElement& el = m_ms.Element(i);
         vec3d tn[FEElement::MAX_INTPOINTS];
         if (m_bsmaug) m_ms.GetGPSurfaceTraction(i, tn);
@@ -1723,8 +1745,8 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
                 normL1 += data.m_Lmt*data.m_Lmt;
                 
                 if (m_btension)
-                    maxgap = max(maxgap,fabs(data.m_dg.norm()));
-                else if (Ln > 0) maxgap = max(maxgap,fabs(data.m_dg.norm()));
+                    gmax[i] = max(gmax[i],fabs(data.m_dg.norm()));
+                else if (Ln > 0) gmax[i] = max(gmax[i],fabs(data.m_dg.norm()));
             }
             else {
                 // if slip, augment normal traction
@@ -1743,12 +1765,14 @@ bool FESlidingElasticInterface::Augment(int naug, const FETimeInfo& tp)
                 normL1 += data.m_Lmd*data.m_Lmd;
                 
                 if (m_btension)
-                    maxgap = max(maxgap,fabs(data.m_gap));
-                else if (Ln > 0) maxgap = max(maxgap,fabs(data.m_gap));
+                    gmax[i] = max(gmax[i],fabs(data.m_gap));
+                else if (Ln > 0) gmax[i] = max(gmax[i],fabs(data.m_gap));
             }
         }
     }
     
+    for (int i=0; i<NM; ++i) maxgap = max(maxgap, gmax[i]);
+    
     // calculate relative norms
     double lnorm = (normL1 != 0 ? fabs((normL1 - normL0) / normL1) : fabs(normL1 - normL0));
     
@@ -509,8 +509,16 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 	cpp.HandleSpecialCases(true);
 	cpp.Init();
 
+	// Nodes that are moved onto the secondary surface are only relocated after
+	// all nodes are projected, since other nodes may project onto them (e.g. for self-contact).
+	int NN = ss.Nodes();
+	vector<int> bnodeMove;
+	vector<vec3d> xnew;
+	if (bmove) { bnodeMove.assign(NN, 0); xnew.resize(NN); }
+
 	// loop over all primary surface nodes
-	for (int i=0; i<ss.Nodes(); ++i)
+	#pragma omp parallel for private(r, s, q) schedule(dynamic)
+	for (int i=0; i<NN; ++i)
 	{
 		// get the node
 		FENode& node = ss.Node(i);
@@ -608,7 +616,8 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 			ss.m_data[i].m_gap = -(ss.m_data[i].m_nu*(x - q)) + ss.m_data[i].m_off;
 			if (bmove && (ss.m_data[i].m_gap>0))
 			{
-				node.m_r0 = node.m_rt = q + ss.m_data[i].m_nu*ss.m_data[i].m_off;
+				xnew[i] = q + ss.m_data[i].m_nu*ss.m_data[i].m_off;
+				bnodeMove[i] = 1;
 				ss.m_data[i].m_gap = 0;
 			}
 
@@ -634,6 +643,19 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 			ss.m_data[i].m_Lt[0] = ss.m_data[i].m_Lt[1] = 0;
 		}
 	}
+
+	// relocate the nodes
+	if (bmove)
+	{
+		for (int i = 0; i<NN; ++i)
+		{
+			if (bnodeMove[i])
+			{
+				FENode& node = ss.Node(i);
+				node.m_r0 = node.m_rt = xnew[i];
+			}
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -696,6 +718,7 @@ void FESlidingInterface::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 
 		// loop over all primary surface facets
 		int ne = ss.Elements();
+		#pragma omp parallel for private(fe, lm, en, sLM, mLM, r0, w, Gr, Gs, detJ, dxr, dxs) schedule(dynamic)
 		for (int j=0; j<ne; ++j)
 		{
 			// get the next element
@@ -1034,7 +1057,9 @@ void FESlidingInterface::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& t
 		FESlidingSurface& ms = (np==0?m_ms:m_ss);	
 
 		// loop over all primary surface elements
+		// (lm and en are presized, so each thread needs a copy)
 		int ne = ss.Elements();
+		#pragma omp parallel for private(ke, Gr, Gs, w, r0, detJ, dxr, dxs, sLM, mLM) firstprivate(lm, en) schedule(dynamic)
 		for (int j=0; j<ne; ++j)
 		{
 			// unpack the next element
@@ -1818,7 +1843,9 @@ void FESlidingInterface::UpdateContactPressures()
 		FESlidingSurface& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all nodes of the primary surface
-		for (int n=0; n<ss.Nodes(); ++n)
+		int NN = ss.Nodes();
+		#pragma omp parallel for
+		for (int n=0; n<NN; ++n)
 		{
 			// get the normal tractions at the integration points
 			double gap = ss.m_data[n].m_gap;
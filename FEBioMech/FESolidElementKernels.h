@@ -0,0 +1,222 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/FESolidElement.h>
+#include <FECore/FEException.h>
+#include <FECore/matrix.h>
+#include <FECore/mat3d.h>
+
+//-----------------------------------------------------------------------------
+// Element kernels for solid elements. The kernels are templated on the number
+// of element nodes, so that for the common element types (TET4, HEX8, TET10,
+// HEX20, HEX27) all loops have a fixed trip count and can be unrolled and 
+// vectorized by the compiler. Use NELN = 0 for other element types, in which
+// case the node count is taken from the neln parameter.
+// The kernels perform the same floating point operations as the generic code
+// in the same order, so the results do not depend on which version is used.
+namespace FESolidKernels {
+
+//-----------------------------------------------------------------------------
+//! Calculates the spatial gradient of the shape functions at integration point
+//! n for the given nodal coordinates. Returns the Jacobian determinant.
+template <int NELN> inline double ShapeGradient(FESolidElement& el, int n, const vec3d* rt, vec3d* G, int neln = NELN)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	const double* Gr = el.Gr(n);
+	const double* Gs = el.Gs(n);
+	const double* Gt = el.Gt(n);
+
+	// calculate jacobian
+	double J[3][3] = { 0 };
+	for (int i = 0; i < N; ++i)
+	{
+		const double& x = rt[i].x;
+		const double& y = rt[i].y;
+		const double& z = rt[i].z;
+
+		J[0][0] += Gr[i]*x; J[0][1] += Gs[i]*x; J[0][2] += Gt[i]*x;
+		J[1][0] += Gr[i]*y; J[1][1] += Gs[i]*y; J[1][2] += Gt[i]*y;
+		J[2][0] += Gr[i]*z; J[2][1] += Gs[i]*z; J[2][2] += Gt[i]*z;
+	}
+
+	// calculate the determinant
+	double det =  J[0][0]*(J[1][1]*J[2][2] - J[1][2]*J[2][1])
+				+ J[0][1]*(J[1][2]*J[2][0] - J[2][2]*J[1][0])
+				+ J[0][2]*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
+
+	// make sure the determinant is positive
+	if (det <= 0) throw NegativeJacobian(el.GetID(), n + 1, det);
+
+	// calculate inverse jacobian
+	double deti = 1.0 / det;
+	double Ji[3][3];
+	Ji[0][0] =  deti*(J[1][1]*J[2][2] - J[1][2]*J[2][1]);
+	Ji[1][0] =  deti*(J[1][2]*J[2][0] - J[1][0]*J[2][2]);
+	Ji[2][0] =  deti*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
+
+	Ji[0][1] =  deti*(J[0][2]*J[2][1] - J[0][1]*J[2][2]);
+	Ji[1][1] =  deti*(J[0][0]*J[2][2] - J[0][2]*J[2][0]);
+	Ji[2][1] =  deti*(J[0][1]*J[2][0] - J[0][0]*J[2][1]);
+
+	Ji[0][2] =  deti*(J[0][1]*J[1][2] - J[1][1]*J[0][2]);
+	Ji[1][2] =  deti*(J[0][2]*J[1][0] - J[0][0]*J[1][2]);
+	Ji[2][2] =  deti*(J[0][0]*J[1][1] - J[0][1]*J[1][0]);
+
+	// calculate global gradient of shape functions
+	// note that we need the transposed of Ji, not Ji itself !
+	for (int i = 0; i < N; ++i)
+	{
+		G[i].x = Ji[0][0]*Gr[i] + Ji[1][0]*Gs[i] + Ji[2][0]*Gt[i];
+		G[i].y = Ji[0][1]*Gr[i] + Ji[1][1]*Gs[i] + Ji[2][1]*Gt[i];
+		G[i].z = Ji[0][2]*Gr[i] + Ji[1][2]*Gs[i] + Ji[2][2]*Gt[i];
+	}
+
+	return det;
+}
+
+//-----------------------------------------------------------------------------
+//! Adds the internal force of one integration point (with stress s) to fe.
+template <int NELN> inline void InternalForce(const vec3d* G, const mat3ds& s, double detJt, double* fe, int neln = NELN)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	for (int i = 0; i < N; ++i)
+	{
+		const double Gx = G[i].x, Gy = G[i].y, Gz = G[i].z;
+
+		// the '-' sign is so that the internal forces get subtracted
+		// from the global residual vector
+		fe[3*i  ] -= (Gx*s.xx() + Gy*s.xy() + Gz*s.xz())*detJt;
+		fe[3*i+1] -= (Gy*s.yy() + Gx*s.xy() + Gz*s.yz())*detJt;
+		fe[3*i+2] -= (Gz*s.zz() + Gy*s.yz() + Gx*s.xz())*detJt;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Adds the geometrical stiffness of one integration point (with stress s) to ke.
+//! The product s*G[j] does not depend on i, so it is only evaluated once per node.
+template <int NELN> inline void GeometricalStiffness(const vec3d* G, const mat3ds& s, double w, matrix& ke, int neln = NELN)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	vec3d sG[NELN > 0 ? NELN : FEElement::MAX_NODES];
+	for (int j = 0; j < N; ++j) sG[j] = s*G[j];
+
+	for (int i = 0; i < N; ++i)
+	{
+		double* k0 = ke[3*i];
+		double* k1 = ke[3*i+1];
+		double* k2 = ke[3*i+2];
+		for (int j = 0; j < N; ++j)
+		{
+			double kab = (G[i]*sG[j])*w;
+			k0[3*j  ] += kab;
+			k1[3*j+1] += kab;
+			k2[3*j+2] += kab;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Adds the material stiffness of one integration point (with the tangent in
+//! Voigt notation D) to ke. The products D*BL only depend on the column node, 
+//! so they are evaluated once per node and stored per component, so that the
+//! inner loop reads them contiguously.
+template <int NELN> inline void MaterialStiffness(const vec3d* G, const double D[6][6], double detJt, matrix& ke, int neln = NELN)
+{
+	const int N = (NELN > 0 ? NELN : neln);
+	const int M = (NELN > 0 ? NELN : FEElement::MAX_NODES);
+	double DBL[6][3][M];
+	for (int j = 0; j < N; ++j)
+	{
+		const double Gxj = G[j].x, Gyj = G[j].y, Gzj = G[j].z;
+		for (int k = 0; k < 6; ++k)
+		{
+			DBL[k][0][j] = (D[k][0]*Gxj + D[k][3]*Gyj + D[k][5]*Gzj);
+			DBL[k][1][j] = (D[k][1]*Gyj + D[k][3]*Gxj + D[k][4]*Gzj);
+			DBL[k][2][j] = (D[k][2]*Gzj + D[k][4]*Gyj + D[k][5]*Gxj);
+		}
+	}
+
+	for (int i = 0; i < N; ++i)
+	{
+		const double Gxi = G[i].x, Gyi = G[i].y, Gzi = G[i].z;
+		double* k0 = ke[3*i];
+		double* k1 = ke[3*i+1];
+		double* k2 = ke[3*i+2];
+		for (int j = 0; j < N; ++j)
+		{
+			k0[3*j  ] += (Gxi*DBL[0][0][j] + Gyi*DBL[3][0][j] + Gzi*DBL[5][0][j])*detJt;
+			k0[3*j+1] += (Gxi*DBL[0][1][j] + Gyi*DBL[3][1][j] + Gzi*DBL[5][1][j])*detJt;
+			k0[3*j+2] += (Gxi*DBL[0][2][j] + Gyi*DBL[3][2][j] + Gzi*DBL[5][2][j])*detJt;
+
+			k1[3*j  ] += (Gyi*DBL[1][0][j] + Gxi*DBL[3][0][j] + Gzi*DBL[4][0][j])*detJt;
+			k1[3*j+1] += (Gyi*DBL[1][1][j] + Gxi*DBL[3][1][j] + Gzi*DBL[4][1][j])*detJt;
+			k1[3*j+2] += (Gyi*DBL[1][2][j] + Gxi*DBL[3][2][j] + Gzi*DBL[4][2][j])*detJt;
+
+			k2[3*j  ] += (Gzi*DBL[2][0][j] + Gyi*DBL[4][0][j] + Gxi*DBL[5][0][j])*detJt;
+			k2[3*j+1] += (Gzi*DBL[2][1][j] + Gyi*DBL[4][1][j] + Gxi*DBL[5][1][j])*detJt;
+			k2[3*j+2] += (Gzi*DBL[2][2][j] + Gyi*DBL[4][2][j] + Gxi*DBL[5][2][j])*detJt;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// These functions call the kernel that is specialized for the element's node count.
+#define FESOLID_KERNEL_DISPATCH(neln, kernel, ...) \
+	switch (neln) { \
+	case  4: return kernel< 4>(__VA_ARGS__); \
+	case  8: return kernel< 8>(__VA_ARGS__); \
+	case 10: return kernel<10>(__VA_ARGS__); \
+	case 20: return kernel<20>(__VA_ARGS__); \
+	case 27: return kernel<27>(__VA_ARGS__); \
+	} \
+	return kernel<0>(__VA_ARGS__, neln);
+
+inline double ShapeGradient(FESolidElement& el, int n, const vec3d* rt, vec3d* G)
+{
+	int neln = el.Nodes();
+	FESOLID_KERNEL_DISPATCH(neln, ShapeGradient, el, n, rt, G)
+}
+
+inline void InternalForce(int neln, const vec3d* G, const mat3ds& s, double detJt, double* fe)
+{
+	FESOLID_KERNEL_DISPATCH(neln, InternalForce, G, s, detJt, fe)
+}
+
+inline void GeometricalStiffness(int neln, const vec3d* G, const mat3ds& s, double w, matrix& ke)
+{
+	FESOLID_KERNEL_DISPATCH(neln, GeometricalStiffness, G, s, w, ke)
+}
+
+inline void MaterialStiffness(int neln, const vec3d* G, const double D[6][6], double detJt, matrix& ke)
+{
+	FESOLID_KERNEL_DISPATCH(neln, MaterialStiffness, G, D, detJt, ke)
+}
+
+#undef FESOLID_KERNEL_DISPATCH
+
+} // namespace FESolidKernels
@@ -73,13 +73,7 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		vector<double>& ui = m_u;
 
 		// adjust for linear constraints
-		FEModel* fem = m_solver->GetFEModel();
-		FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
-		if (LCM.LinearConstraints() > 0)
-		{
-			#pragma omp critical 
-			LCM.AssembleStiffness(m_K, m_F, m_u, ke.Nodes(), ke.RowIndices(), ke.ColumnsIndices(), ke);
-		}
+		AssembleLinearConstraints(ke);
 
 		// adjust stiffness matrix for prescribed degrees of freedom
 		// NOTE: I had to comment this if statement out since otherwise
@@ -121,7 +115,13 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 
 		// see if there are any rigid body dofs here
-		#pragma omp critical 
-		m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		// The rigid contributions are collected in an assembly buffer, and
+		// assembled at the end (see FELinearSystem::FinalizeAssembly).
+		if (m_rigidSolver->IsRigidCoupled(ke.Nodes()))
+		{
+			FEStiffnessBuffer* buf = AcquireBuffer();
+			m_rigidSolver->RigidStiffness(*buf, m_u, ke, m_alpha);
+			ReleaseBuffer(buf);
+		}
 	}
 }
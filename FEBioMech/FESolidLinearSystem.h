@@ -28,10 +28,9 @@ SOFTWARE.*/
 #pragma once
 
 #include <FECore/FELinearSystem.h>
+#include "FERigidSolver.h"
 #include "febiomech_api.h"
 
-class FERigidSolver;
-
 class FEBIOMECH_API FESolidLinearSystem : public FELinearSystem
 {
 public:
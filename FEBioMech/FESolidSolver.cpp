@@ -590,6 +590,9 @@ bool FESolidSolver::StiffnessMatrix()
 	// for the prescribed rigid body dofs.
 	m_rigidSolver.StiffnessMatrix(*m_pK, tp);
 
+	// add the buffered contributions (of rigid bodies and linear constraints)
+	LS.FinalizeAssembly();
+
 	return true;
 }
 
@@ -1142,6 +1142,9 @@ bool FESolidSolver2::StiffnessMatrix()
 	// add contributions from rigid bodies
 	m_rigidSolver.StiffnessMatrix(*m_pK, tp);
 
+	// add the buffered contributions (of rigid bodies and linear constraints)
+	LS.FinalizeAssembly();
+
 	return true;
 }
 
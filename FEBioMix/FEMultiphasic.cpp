@@ -160,7 +160,7 @@ void muller(bool fnreal, complex<double>* zeros, const int n, const int nprev,
 
 // Newton's method for finding nearest root of a polynomial
 bool newton(double& zero, const int n, const int maxit, 
-			const double ep1, const double ep2, vector<double> a)
+			const double ep1, const double ep2, const vector<double>& a)
 {
 	bool done = false;
 	bool conv = false;
@@ -206,7 +206,7 @@ bool newton(double& zero, const int n, const int maxit,
 }
 
 // linear
-bool poly1(vector<double> a, double& x)
+bool poly1(const vector<double>& a, double& x)
 {
 	if (a[1]) {
 		x = -a[0]/a[1];
@@ -217,7 +217,7 @@ bool poly1(vector<double> a, double& x)
 }
 
 // quadratic
-bool poly2(vector<double> a, double& x)
+bool poly2(const vector<double>& a, double& x)
 {
 	if (a[2]) {
 		x = (-a[1]+sqrt(SQR(a[1])-4*a[0]*a[2]))/(2*a[2]);
@@ -228,7 +228,7 @@ bool poly2(vector<double> a, double& x)
 }
 
 // higher order
-bool polyn(int n, vector<double> a, double& x)
+bool polyn(int n, const vector<double>& a, double& x)
 {
 //	bool fnreal = true;
 //	vector< complex<double> > zeros(n,complex<double>(1,0));
@@ -246,7 +246,7 @@ bool polyn(int n, vector<double> a, double& x)
 	return newton(x, n, maxit,ep1, ep2, a);
 }
 
-bool solvepoly(int n, vector<double> a, double& x)
+bool solvepoly(int n, const vector<double>& a, double& x)
 {
 	switch (n) {
 		case 1:
@@ -275,6 +275,7 @@ FEMultiphasic::FEMultiphasic(FEModel* pfem) : FEMaterial(pfem)
 	m_rhoTw = 0;
 	m_Rgas = 0; m_Tabs = 0; m_Fc = 0;
 	m_penalty = 1;
+	m_bcache = false;
 
 	m_pSolid = 0;
 	m_pPerm = 0;
@@ -350,6 +351,7 @@ bool FEMultiphasic::Init()
 	}
 	m_zmin = zmin;
 	m_ndeg = zmax - zmin;	// polynomial degree
+	m_bcache = CanCacheSolubility();
 
 	m_Rgas = GetFEModel()->GetGlobalConstant("R");
 	m_Tabs = GetFEModel()->GetGlobalConstant("T");
@@ -379,9 +381,23 @@ void FEMultiphasic::Serialize(DumpStream& ar)
 		// restore the m_pMP pointers for reactions
 		int NR = (int) m_pReact.size();
 		for (int i=0; i<NR; ++i) m_pReact[i]->m_pMP = this;
+
+		m_bcache = CanCacheSolubility();
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! The electroneutrality cache can only be used when none of the solubilities depends
+//! on state that is not part of the key of the cache.
+bool FEMultiphasic::CanCacheSolubility() const
+{
+	for (int i=0; i<(int)m_pSolute.size(); ++i)
+	{
+		if (m_pSolute[i]->m_pSolub->IsCacheable() == false) return false;
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Solid referential apparent density
 double FEMultiphasic::SolidReferentialApparentDensity(FEMaterialPoint& pt)
@@ -473,61 +489,90 @@ double FEMultiphasic::ElectricPotential(FEMaterialPoint& pt, const bool eform)
 	// if not neutral, solve electroneutrality polynomial for zeta
 	FESolutesMaterialPoint& set = *pt.ExtractData<FESolutesMaterialPoint>();
 	const int nsol = (int)m_pSolute.size();
-	double cF = FixedChargeDensity(pt);
 
-	vector<double> c(nsol);		// effective concentration
-	vector<double> khat(nsol);	// solubility
-	vector<int> z(nsol);		// charge number
-	for (i=0; i<nsol; ++i) {
-		c[i] = set.m_c[i];
-		khat[i] = m_pSolute[i]->m_pSolub->Solubility(pt);
-		z[i] = m_pSolute[i]->ChargeNumber();
+	// The solution only depends on the state of the material point (and the initial
+	// guess), so we can reuse it when this function is called again for the same state,
+	// which happens many times for each stiffness and residual evaluation.
+	FEElectroneutralityCache& enc = set.m_enc;
+	double J = pt.ExtractData<FEElasticMaterialPoint>()->m_J;
+	double phi0 = pt.ExtractData<FEBiphasicMaterialPoint>()->m_phi0;
+	double time = GetFEModel()->GetTime().currentTime;
+	bool bcache = m_bcache && (set.m_ca.size() == set.m_c.size()) && FEElectroneutralityCache::Fits((int)set.m_c.size(), (int)set.m_sbmr.size());
+
+	double zeta;
+	if (bcache && enc.IsValid(J, phi0, set.m_psi, time, set.m_c, set.m_sbmr, set.m_ca, set.m_cF))
+	{
+		zeta = enc.m_zeta;
 	}
-	
-	// evaluate polynomial coefficients
-	const int n = m_ndeg;
-	vector<double> a(n+1,0);
-	if (m_zmin < 0) {
+	else
+	{
+		double cF = FixedChargeDensity(pt);
+
+		// evaluate polynomial coefficients
+		const int n = m_ndeg;
+		vector<double> a(n+1,0);
 		for (i=0; i<nsol; ++i) {
-			j = z[i] - m_zmin;
-			a[j] += z[i]*khat[i]*c[i];
+			double khat = m_pSolute[i]->m_pSolub->Solubility(pt);
+			int z = m_pSolute[i]->ChargeNumber();
+			j = (m_zmin < 0 ? z - m_zmin : z);
+			a[j] += z*khat*set.m_c[i];
+			if (bcache) enc.m_khat[i] = khat;
 		}
-		a[-m_zmin] = cF;
-	} else {
-		for (i=0; i<nsol; ++i) {
-			j = z[i];
-			a[j] += z[i]*khat[i]*c[i];
+		if (m_zmin < 0) a[-m_zmin] = cF;
+		else a[0] = cF;
+
+		// solve polynomial
+		double psi = set.m_psi;		// use previous solution as initial guess
+		zeta = exp(-m_Fc*psi/m_Rgas/m_Tabs);
+		if (!solvepoly(n, a, zeta)) {
+			zeta = 1.0;
 		}
-		a[0] = cF;
-	}
 
-	// solve polynomial
-	double psi = set.m_psi;		// use previous solution as initial guess
-	double zeta = exp(-m_Fc*psi/m_Rgas/m_Tabs);
-	if (!solvepoly(n, a, zeta)) {
-		zeta = 1.0;
+		// update the cache
+		if (bcache)
+		{
+			enc.m_zeta = zeta;
+			enc.SetKey(J, phi0, psi, time, set.m_c, set.m_sbmr, set.m_ca, set.m_cF);
+		}
+		else enc.Invalidate();
 	}
 	
 	// Return exponential (non-dimensional) form if desired
 	if (eform) return zeta;
 	
 	// Otherwise return dimensional value of electric potential
-	psi = -m_Rgas*m_Tabs/m_Fc*log(zeta);
+	double psi = -m_Rgas*m_Tabs/m_Fc*log(zeta);
 	
 	return psi;
 }
 
+//-----------------------------------------------------------------------------
+//! Solubility of a solute. When called right after ElectricPotential, this returns
+//! the value that was stored in the electroneutrality cache, as long as the state
+//! of the point did not change since.
+double FEMultiphasic::SoluteSolubility(FEMaterialPoint& pt, const int sol)
+{
+	FESolutesMaterialPoint& spt = *pt.ExtractData<FESolutesMaterialPoint>();
+	if ((m_ndeg != 0) && m_bcache && spt.m_enc.IsValid())
+	{
+		double J = pt.ExtractData<FEElasticMaterialPoint>()->m_J;
+		double phi0 = pt.ExtractData<FEBiphasicMaterialPoint>()->m_phi0;
+		double time = GetFEModel()->GetTime().currentTime;
+		if (spt.m_enc.HasSolubility(J, phi0, time, spt.m_c, spt.m_sbmr, spt.m_ca, spt.m_cF)) return spt.m_enc.m_khat[sol];
+	}
+	return m_pSolute[sol]->m_pSolub->Solubility(pt);
+}
+
 //-----------------------------------------------------------------------------
 //! partition coefficient
 double FEMultiphasic::PartitionCoefficient(FEMaterialPoint& pt, const int sol)
 {
-	
-	// solubility
-	double khat = m_pSolute[sol]->m_pSolub->Solubility(pt);
-	// charge number
-	int z = m_pSolute[sol]->ChargeNumber();
 	// electric potential
 	double zeta = ElectricPotential(pt, true);
+	// solubility (which was cached with the electric potential, if possible)
+	double khat = SoluteSolubility(pt, sol);
+	// charge number
+	int z = m_pSolute[sol]->ChargeNumber();
 	double zz = pow(zeta, z);
 	// partition coefficient
 	double kappa = zz*khat;
@@ -924,9 +969,9 @@ vec3d FEMultiphasic::SoluteFlux(FEMaterialPoint& pt, const int sol)
 	double D0 = m_pSolute[sol]->m_pDiff->Free_Diffusivity(pt);
 	
 	// solubility
-	double khat = m_pSolute[sol]->m_pSolub->Solubility(pt);
-	int z = m_pSolute[sol]->ChargeNumber();
 	double zeta = ElectricPotential(pt, true);
+	double khat = SoluteSolubility(pt, sol);
+	int z = m_pSolute[sol]->ChargeNumber();
 	double zz = pow(zeta, z);
 	double kappa = zz*khat;
 	
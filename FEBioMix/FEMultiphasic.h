@@ -187,6 +187,16 @@ public:
 	int		m_zmin;			//!< minimum charge number in mixture
 	int		m_ndeg;			//!< polynomial degree of zeta in electroneutrality
 
+protected:
+	//! solute solubility (must be called after ElectricPotential, which caches it)
+	double SoluteSolubility(FEMaterialPoint& pt, const int sol);
+
+	//! see if all solubilities can be stored in the electroneutrality cache
+	bool CanCacheSolubility() const;
+
+protected:
+	bool	m_bcache;		//!< use the electroneutrality cache
+
 protected:
 	// material properties
 	FEElasticMaterial*			m_pSolid;		//!< pointer to elastic solid material
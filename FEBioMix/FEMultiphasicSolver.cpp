@@ -662,6 +662,9 @@ bool FEMultiphasicSolver::StiffnessMatrix()
 	// add contributions from rigid bodies
 	m_rigidSolver.StiffnessMatrix(*m_pK, tp);
 
+	// add the buffered contributions (of rigid bodies and linear constraints)
+	LS.FinalizeAssembly();
+
 	return true;
 }
 
@@ -866,7 +866,7 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
     }
     
 	// loop over all integration points
-//    #pragma omp parallel for shared(R, bupseg)
+	#pragma omp parallel for private(pme, r, nu, rs, Ln, ps, p1, cs, c1) schedule(dynamic)
 	for (int i=0; i<ss.Elements(); ++i)
 	{
 		FESurfaceElement& el = ss.Element(i);
@@ -1174,8 +1174,14 @@ void FESlidingInterface3::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FESlidingSurface3& ss = (np == 0? m_ss : m_ms);
 		FESlidingSurface3& ms = (np == 0? m_ms : m_ss);
 		
+		// The net contact forces are first collected per element, so that the
+		// sum does not depend on the number of threads.
+		int NE = ss.Elements();
+		vector<vec3d> Fs(NE, vec3d(0,0,0)), Fm(NE, vec3d(0,0,0));
+
 		// loop over all primary surface elements
-		for (int i = 0; i<ss.Elements(); ++i)
+		#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N) schedule(dynamic)
+		for (int i = 0; i<NE; ++i)
 		{
 			// get the surface element
 			FESurfaceElement& se = ss.Element(i);
@@ -1298,12 +1304,12 @@ void FESlidingInterface3::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 					
                     for (int k=0; k<nseln; ++k)
                     {
-                        ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                        Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
                     }
                     
                     for (int k = 0; k<nmeln; ++k)
                     {
-                        ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                        Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
                     }
                     
 					// assemble the global residual
@@ -1368,6 +1374,12 @@ void FESlidingInterface3::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 				}
 			}
 		}
+
+		for (int i=0; i<NE; ++i)
+		{
+			ss.m_Ft += Fs[i];
+			ms.m_Ft += Fm[i];
+		}
 	}
 }
 
@@ -1415,6 +1427,7 @@ void FESlidingInterface3::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		FESlidingSurface3& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all primary surface elements
+		#pragma omp parallel for private(j, k, l, sLM, mLM, LM, en, ke, detJ, w, Hs, Hm, pt, dpr, dps, ct, dcr, dcs, N) schedule(dynamic)
 		for (i=0; i<ss.Elements(); ++i)
 		{
 			// get the next element
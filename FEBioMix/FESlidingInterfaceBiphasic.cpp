@@ -1406,8 +1406,14 @@ void FESlidingInterfaceBiphasic::LoadVector(FEGlobalVector& R, const FETimeInfo&
         FESlidingSurfaceBiphasic& ss = (np == 0? m_ss : m_ms);
         FESlidingSurfaceBiphasic& ms = (np == 0? m_ms : m_ss);
         
+        // The net contact forces are first collected per element, so that the
+        // sum does not depend on the number of threads.
+        int NE = ss.Elements();
+        vector<vec3d> Fs(NE, vec3d(0,0,0)), Fm(NE, vec3d(0,0,0));
+
         // loop over all primary surface elements
-        for (int i=0; i<ss.Elements(); ++i)
+        #pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N) schedule(dynamic)
+        for (int i=0; i<NE; ++i)
         {
             // get the surface element
             FESurfaceElement& se = ss.Element(i);
@@ -1519,10 +1525,10 @@ void FESlidingInterfaceBiphasic::LoadVector(FEGlobalVector& R, const FETimeInfo&
                         
                         // calculate contact forces
                         for (int k=0; k<nseln; ++k)
-                            ss.m_Ft += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
+                            Fs[i] += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
                         
                         for (int k = 0; k<nmeln; ++k)
-                            ms.m_Ft += vec3d(fe[3*(k+nseln)], fe[3*(k+nseln)+1], fe[3*(k+nseln)+2]);
+                            Fm[i] += vec3d(fe[3*(k+nseln)], fe[3*(k+nseln)+1], fe[3*(k+nseln)+2]);
                         
                         // assemble the global residual
                         R.Assemble(en, LM, fe);
@@ -1558,6 +1564,12 @@ void FESlidingInterfaceBiphasic::LoadVector(FEGlobalVector& R, const FETimeInfo&
                 }
             }
         }
+
+        for (int i=0; i<NE; ++i)
+        {
+            ss.m_Ft += Fs[i];
+            ms.m_Ft += Fm[i];
+        }
     }
 }
 
@@ -1589,6 +1601,7 @@ void FESlidingInterfaceBiphasic::StiffnessMatrix(FELinearSystem& LS, const FETim
         FEMesh& mesh = *ms.GetMesh();
         
         // loop over all primary elements
+        #pragma omp parallel for private(sLM, mLM, LM, en, ke, detJ, w, Hs, Hm, N) schedule(dynamic)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get the primary element
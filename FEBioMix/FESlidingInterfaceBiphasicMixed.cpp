@@ -1479,8 +1479,14 @@ void FESlidingInterfaceBiphasicMixed::LoadVector(FESlidingSurfaceBiphasicMixed&
     // need to multiply biphasic force entries by the timestep
     double dt = tp.timeIncrement;
     
+    // The net contact forces are first collected per element, so that the
+    // sum does not depend on the number of threads.
+    int NE = ss.Elements();
+    vector<vec3d> Fs(NE, vec3d(0,0,0)), Fm(NE, vec3d(0,0,0));
+
     // loop over all primary surface elements
-    for (int i=0; i<ss.Elements(); ++i)
+    #pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, Hmp, N) schedule(dynamic)
+    for (int i=0; i<NE; ++i)
     {
         // get the surface element
         FESurfaceElement& se = ss.Element(i);
@@ -1594,10 +1600,10 @@ void FESlidingInterfaceBiphasicMixed::LoadVector(FESlidingSurfaceBiphasicMixed&
                         
                     // calculate contact forces
                     for (int k=0; k<nseln; ++k)
-                        ss.m_Ft += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
+                        Fs[i] += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
                         
                     for (int k = 0; k<nmeln; ++k)
-                        ms.m_Ft += vec3d(fe[3*(k+nseln)], fe[3*(k+nseln)+1], fe[3*(k+nseln)+2]);
+                        Fm[i] += vec3d(fe[3*(k+nseln)], fe[3*(k+nseln)+1], fe[3*(k+nseln)+2]);
                         
                     // assemble the global residual
                     R.Assemble(en, LM, fe);
@@ -1644,6 +1650,12 @@ void FESlidingInterfaceBiphasicMixed::LoadVector(FESlidingSurfaceBiphasicMixed&
             }
         }
     }
+
+    for (int i=0; i<NE; ++i)
+    {
+        ss.m_Ft += Fs[i];
+        ms.m_Ft += Fm[i];
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -1687,6 +1699,7 @@ void FESlidingInterfaceBiphasicMixed::StiffnessMatrix(FESlidingSurfaceBiphasicMi
     FEMesh& mesh = *ms.GetMesh();
         
     // loop over all primary surface elements
+    #pragma omp parallel for private(sLM, mLM, LM, en, ke, detJ, w, Hs, Hm, Hmp, N, H) schedule(dynamic)
     for (int i=0; i<ss.Elements(); ++i)
     {
         // get the next element
@@ -995,7 +995,7 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
     }
     
 	// loop over all integration points
-//    #pragma omp parallel for shared(R, bupseg)
+	#pragma omp parallel for private(pme, r, nu, rs, Ln, ps, p1) firstprivate(cs, c1) schedule(dynamic)
 	for (int i=0; i<ss.Elements(); ++i)
 	{
 		FESurfaceElement& el = ss.Element(i);
@@ -1304,8 +1304,14 @@ void FESlidingInterfaceMP::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FESlidingSurfaceMP& ms = (np == 0? m_ms : m_ss);
 		vector<int>& sl = (np == 0? m_ssl : m_msl);
 		
+		// The net contact forces are first collected per element, so that the
+		// sum does not depend on the number of threads.
+		int NE = ss.Elements();
+		vector<vec3d> Fs(NE, vec3d(0,0,0)), Fm(NE, vec3d(0,0,0));
+
 		// loop over all primary surface elements
-		for (int i=0; i<ss.Elements(); ++i)
+		#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N, tn, wn) firstprivate(jn) schedule(dynamic)
+		for (int i=0; i<NE; ++i)
 		{
 			// get the surface element
 			FESurfaceElement& se = ss.Element(i);
@@ -1431,12 +1437,12 @@ void FESlidingInterfaceMP::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 					
                     for (int k=0; k<nseln; ++k)
                     {
-                        ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                        Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
                     }
                     
                     for (int k = 0; k<nmeln; ++k)
                     {
-                        ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                        Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
                     }
                     
 					// assemble the global residual
@@ -1495,6 +1501,12 @@ void FESlidingInterfaceMP::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 				}
 			}
 		}
+
+		for (int i=0; i<NE; ++i)
+		{
+			ss.m_Ft += Fs[i];
+			ms.m_Ft += Fm[i];
+		}
 	}
 }
 
@@ -1545,6 +1557,7 @@ void FESlidingInterfaceMP::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		vector<int>& sl = (np == 0? m_ssl : m_msl);
 		
 		// loop over all primary surface elements
+		#pragma omp parallel for private(j, k, l, sLM, mLM, LM, en, ke, detJ, w, Hs, Hm, tn, wn, pv) firstprivate(jn, qv) schedule(dynamic)
 		for (i=0; i<ss.Elements(); ++i)
 		{
 			// get the next element
@@ -56,6 +56,9 @@ public:
 	//! Second derivative of solubility with respect to concentration
 	double Tangent_Solubility_Concentration_Concentration(FEMaterialPoint& mp, const int isol, const int jsol) override;
 
+	//! the solubility can be cached
+	bool IsCacheable() const override { return true; }
+
 public:
 	double	m_solub;			//!< solubility
 	
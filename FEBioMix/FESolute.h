@@ -97,6 +97,11 @@ public:
 	virtual double Tangent_Solubility_Concentration_Concentration(FEMaterialPoint& mp, 
 																  const int isol, const int jsol) = 0;
 	
+	//! Return true if the solubility only depends on the time and on the state that is
+	//! stored in the key of the electroneutrality cache (J, phi0, c, ca, cF, sbmr).
+	//! Only then can FEMultiphasic reuse the solubility from that cache.
+	virtual bool IsCacheable() const { return false; }
+
 	//! set solute ID
 	void SetSoluteID(const int ID) {m_ID = ID;}
 	
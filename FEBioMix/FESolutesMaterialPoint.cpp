@@ -30,6 +30,47 @@ SOFTWARE.*/
 #include "FESolutesMaterialPoint.h"
 #include "FECore/DumpStream.h"
 
+//=============================================================================
+//   FEElectroneutralityCache
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+//! see if the cached solution is valid for this state
+bool FEElectroneutralityCache::IsValid(double J, double phi0, double psi, double time, const vector<double>& c, const vector<double>& sbmr, const vector<double>& ca, double cF) const
+{
+	return (psi == m_psi) && HasSolubility(J, phi0, time, c, sbmr, ca, cF);
+}
+
+//-----------------------------------------------------------------------------
+//! see if the cached solubilities are valid for this state
+bool FEElectroneutralityCache::HasSolubility(double J, double phi0, double time, const vector<double>& c, const vector<double>& sbmr, const vector<double>& ca, double cF) const
+{
+	if (m_valid == false) return false;
+	if ((J != m_J) || (phi0 != m_phi0) || (time != m_time) || (cF != m_cF)) return false;
+	if (((int)c.size() != m_nsol) || ((int)ca.size() != m_nsol) || ((int)sbmr.size() != m_nsbm)) return false;
+	for (int i = 0; i < m_nsol; ++i) if ((c[i] != m_c[i]) || (ca[i] != m_ca[i])) return false;
+	for (int i = 0; i < m_nsbm; ++i) if (sbmr[i] != m_sbmr[i]) return false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! store the key for this state
+void FEElectroneutralityCache::SetKey(double J, double phi0, double psi, double time, const vector<double>& c, const vector<double>& sbmr, const vector<double>& ca, double cF)
+{
+	assert(Fits((int)c.size(), (int)sbmr.size()));
+	assert(ca.size() == c.size());
+	m_J = J;
+	m_phi0 = phi0;
+	m_psi = psi;
+	m_time = time;
+	m_cF = cF;
+	m_nsol = (int)c.size();
+	m_nsbm = (int)sbmr.size();
+	for (int i = 0; i < m_nsol; ++i) { m_c[i] = c[i]; m_ca[i] = ca[i]; }
+	for (int i = 0; i < m_nsbm; ++i) m_sbmr[i] = sbmr[i];
+	m_valid = true;
+}
+
 //=============================================================================
 //   FESolutesMaterialPoint
 //=============================================================================
@@ -82,6 +123,7 @@ void FESolutesMaterialPoint::Init()
     m_idi.clear();
     
 	// don't forget to initialize the base class
+	m_enc.Invalidate();
     FEMaterialPoint::Init();
 }
 
@@ -99,4 +141,6 @@ void FESolutesMaterialPoint::Serialize(DumpStream& ar)
 	ar & m_strain & m_pe & m_pi;
 	ar & m_ce & m_ide;
 	ar & m_ci & m_idi;
+
+	if (ar.IsLoading()) m_enc.Invalidate();
 }
@@ -30,6 +30,53 @@ SOFTWARE.*/
 #include <FECore/FEMaterialPoint.h>
 #include "febiomix_api.h"
 
+//-----------------------------------------------------------------------------
+//! Cached solution of the electroneutrality condition at a multiphasic material 
+//! point (see FEMultiphasic::ElectricPotential). The solution depends on the state 
+//! of the point (J, phi0, c, sbmr), the time, and the initial guess (psi). The cached
+//! solubilities may also depend on the actual concentrations (ca) and the fixed charge
+//! density (cF) of the point. All of these are stored as the key of the cache. Only models 
+//! with a limited number of solutes and solid-bound molecules are cached, so that no 
+//! memory needs to be allocated.
+class FEBIOMIX_API FEElectroneutralityCache
+{
+public:
+	enum { MAX_SOLUTES = 8, MAX_SBMS = 8 };
+
+public:
+	FEElectroneutralityCache() : m_valid(false), m_nsol(0), m_nsbm(0) {}
+
+	//! see if the cache can be used for this number of solutes and sbms
+	static bool Fits(int nsol, int nsbm) { return ((nsol <= MAX_SOLUTES) && (nsbm <= MAX_SBMS)); }
+
+	//! see if the cached solution is valid for this state
+	bool IsValid(double J, double phi0, double psi, double time, const vector<double>& c, const vector<double>& sbmr, const vector<double>& ca, double cF) const;
+
+	//! see if the cached solubilities are valid for this state (these do not depend on psi)
+	bool HasSolubility(double J, double phi0, double time, const vector<double>& c, const vector<double>& sbmr, const vector<double>& ca, double cF) const;
+
+	//! store the key for this state (the values must be set separately)
+	void SetKey(double J, double phi0, double psi, double time, const vector<double>& c, const vector<double>& sbmr, const vector<double>& ca, double cF);
+
+	//! see if the cache holds a solution
+	bool IsValid() const { return m_valid; }
+
+	//! invalidate the cache
+	void Invalidate() { m_valid = false; }
+
+public:
+	double	m_zeta;					//!< exponential form of the electric potential
+	double	m_khat[MAX_SOLUTES];	//!< solute solubilities
+
+private:
+	bool	m_valid;
+	int		m_nsol, m_nsbm;
+	double	m_J, m_phi0, m_psi, m_time, m_cF;
+	double	m_c[MAX_SOLUTES];
+	double	m_ca[MAX_SOLUTES];
+	double	m_sbmr[MAX_SBMS];
+};
+
 //-----------------------------------------------------------------------------
 //! Class for storing material point data for solute materials
 
@@ -85,5 +132,7 @@ public:
     vector<double>  m_ci;       //!< effective solute concentration on internal side
     vector<int>     m_ide;      //!< solute IDs on external side
     vector<int>     m_idi;      //!< solute IDs on internal side
+
+	FEElectroneutralityCache	m_enc;	//!< cached solution of electroneutrality condition
 };
 
@@ -52,18 +52,13 @@ void clevmar_cb(double *p, double *hx, int m, int n, void *adata)
 {
 	FEConstrainedLMOptimizeMethod* pLM = (FEConstrainedLMOptimizeMethod*) adata;
 
-	// get the optimization data
-	FEOptimizeData& opt = *pLM->GetOptimizeData();
-	FEObjectiveFunction& obj = opt.GetObjective();
-
 	// evaluate at a
 	vector<double> a(m);
 	for (int i = 0; i<m; ++i) a[i] = p[i];
-	if (opt.FESolve(a) == false) throw FEErrorTermination();
+	vector<double> y(n, 0.0);
+	pLM->Evaluate(a, y);
 
 	// store the measurement vector
-	vector<double> y(n, 0.0);
-	opt.GetObjective().Evaluate(y);
 	for (int i=0; i<n; ++i) hx[i] = y[i];
 
 	// store the last calculated values
@@ -77,6 +72,7 @@ FEConstrainedLMOptimizeMethod::FEConstrainedLMOptimizeMethod()
 	m_objtol = 0.001;
 	m_fdiff  = 0.001;
 	m_nmax   = 100;
+	m_bprefetch = false;
     m_loglevel = LogLevel::LOG_NEVER;
 }
 
@@ -136,6 +132,12 @@ bool FEConstrainedLMOptimizeMethod::Solve(FEOptimizeData *pOpt, vector<double>&
 		const double tol = m_objtol;
 		double opts[5] = {m_tau, tol, tol, tol, m_fdiff};
 
+		// The forward difference solves of the Jacobian can only be predicted 
+		// without linear constraints (see Evaluate).
+		m_bprefetch = (opt.MaxJobs() > 1) && (opt.Constraints() == 0) && (m_fdiff >= 0.0);
+		m_ca.clear();
+		m_cy.clear();
+
 		int itmax = m_nmax;
 		if (opt.Constraints() > 0)
 		{
@@ -184,6 +186,62 @@ bool FEConstrainedLMOptimizeMethod::Solve(FEOptimizeData *pOpt, vector<double>&
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Evaluates the measurements at a. levmar calculates the (forward difference)
+// Jacobian at a point it already evaluated by evaluating that point again, and 
+// then the points where one parameter at a time is increased by max(1e-4*|a_i|, f_diff_scale).
+// With concurrent FE solves, a second request for the same point therefore solves
+// all these perturbed points at once, and the following requests are taken from 
+// the cache. Since levmar still requests the same points in the same order, the
+// results are the same as with serial solves.
+void FEConstrainedLMOptimizeMethod::Evaluate(const vector<double>& a, vector<double>& y)
+{
+	FEOptimizeData& opt = *m_pOpt;
+
+	if (m_bprefetch)
+	{
+		for (size_t n = 0; n < m_ca.size(); ++n)
+		{
+			if (m_ca[n] == a)
+			{
+				y = m_cy[n];
+				if ((n == 0) && (m_ca.size() == 1)) SolvePerturbed(a);
+				return;
+			}
+		}
+	}
+
+	if (opt.FESolve(a) == false) throw FEErrorTermination();
+	opt.GetObjective().Evaluate(y);
+
+	if (m_bprefetch)
+	{
+		m_ca.assign(1, a);
+		m_cy.assign(1, y);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Solves the forward difference points of a concurrently and adds them to the cache.
+void FEConstrainedLMOptimizeMethod::SolvePerturbed(const vector<double>& a)
+{
+	int ma = (int)a.size();
+	vector< vector<double> > A(ma, a);
+	for (int i=0; i<ma; ++i)
+	{
+		// same step size as levmar
+		double d = fabs(1e-4*a[i]);
+		if (d < m_fdiff) d = m_fdiff;
+		A[i][i] = a[i] + d;
+	}
+
+	vector< vector<double> > Y;
+	if (m_pOpt->FESolve(A, Y) == false) throw FEErrorTermination();
+
+	m_ca.insert(m_ca.end(), A.begin(), A.end());
+	m_cy.insert(m_cy.end(), Y.begin(), Y.end());
+}
+
 //-----------------------------------------------------------------------------
 void FEConstrainedLMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a, vector<double>& y, matrix& dyda)
 {
@@ -41,11 +41,16 @@ public:
 
 	FEOptimizeData* GetOptimizeData() { return m_pOpt; }
 
+	// evaluate the measurements at a
+	void Evaluate(const vector<double>& a, vector<double>& y);
+
 protected:
 	FEOptimizeData* m_pOpt;
 
 	void ObjFun(vector<double>& x, vector<double>& a, vector<double>& y, matrix& dyda);
 
+	void SolvePerturbed(const vector<double>& a);
+
 	static FEConstrainedLMOptimizeMethod* m_pThis;
 	static void objfun(vector<double>& x, vector<double>& a, vector<double>& y, matrix& dyda) { return m_pThis->ObjFun(x, a, y, dyda); }
 
@@ -59,6 +64,11 @@ public:
 public:
 	vector<double>	m_yopt;	// optimal y-values
 
+private:
+	bool						m_bprefetch;	// solve the forward difference points concurrently
+	vector< vector<double> >	m_ca, m_cy;		// cache of evaluated points and their measurements
+
+public:
 	DECLARE_FECORE_CLASS();
 };
 #endif
@@ -0,0 +1,262 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEJobScheduler.h"
+#include <stdio.h>
+#include <string.h>
+#ifndef WIN32
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <list>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef PARDISO
+extern "C" void MKL_Set_Num_Threads(int);
+#endif
+
+//-----------------------------------------------------------------------------
+FEJobScheduler::FEJobScheduler(int maxJobs)
+{
+	SetMaxJobs(maxJobs);
+}
+
+//-----------------------------------------------------------------------------
+void FEJobScheduler::SetMaxJobs(int n)
+{
+	m_maxJobs = (n < 1 ? 1 : n);
+}
+
+//-----------------------------------------------------------------------------
+bool FEJobScheduler::IsParallel() const
+{
+#ifdef WIN32
+	return false;
+#else
+	return (m_maxJobs > 1);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool FEJobScheduler::RunSerial(int jobs, Job& job, std::vector< std::vector<double> >& results)
+{
+	for (int i = 0; i < jobs; ++i)
+	{
+		if (job(i, results[i]) == false) return false;
+	}
+	return true;
+}
+
+#ifndef WIN32
+//-----------------------------------------------------------------------------
+// helper functions for the worker processes
+namespace {
+
+	// a worker process that is still running
+	struct Worker
+	{
+		pid_t				pid;	// process ID
+		int					fd;		// read end of the pipe
+		int					job;	// the job index
+		std::vector<char>	buf;	// data received so far
+	};
+
+	// write a buffer to a pipe
+	bool write_all(int fd, const void* data, size_t size)
+	{
+		const char* sz = (const char*)data;
+		while (size > 0)
+		{
+			ssize_t n = write(fd, sz, size);
+			if (n < 0)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			sz += n;
+			size -= (size_t)n;
+		}
+		return true;
+	}
+
+	// This runs a job in the worker process and sends the results back
+	// as (status, number of values, values). This function does not return.
+	void run_worker(FEJobScheduler::Job& job, int n, int fd)
+	{
+		// The OpenMP runtime is not fork-safe: the threads of the parent's thread pool
+		// do not exist in the child, so a parallel region with more than one thread
+		// would deadlock. The worker must therefore run single-threaded. With one thread,
+		// parallel regions are executed by the calling thread only.
+#ifdef _OPENMP
+		omp_set_dynamic(0);
+		omp_set_num_threads(1);
+#endif
+#ifdef PARDISO
+		MKL_Set_Num_Threads(1);
+#endif
+		std::vector<double> r;
+		int status = 0;
+		try {
+			status = (job(n, r) ? 1 : 0);
+		}
+		catch (...)
+		{
+			status = 0;
+		}
+
+		int nsize = (int)r.size();
+		bool bok = write_all(fd, &status, sizeof(int)) && write_all(fd, &nsize, sizeof(int));
+		if (bok && (nsize > 0)) write_all(fd, &r[0], nsize * sizeof(double));
+		close(fd);
+
+		// Don't run any exit handlers or flush any stdio buffers,
+		// since these belong to the parent process.
+		_exit(0);
+	}
+
+	// decode the data received from a worker
+	bool decode_result(const std::vector<char>& buf, std::vector<double>& r)
+	{
+		if (buf.size() < 2 * sizeof(int)) return false;
+		int status, nsize;
+		memcpy(&status, &buf[0], sizeof(int));
+		memcpy(&nsize, &buf[sizeof(int)], sizeof(int));
+		if ((nsize < 0) || (buf.size() != 2 * sizeof(int) + nsize * sizeof(double))) return false;
+		r.resize(nsize);
+		if (nsize > 0) memcpy(&r[0], &buf[2 * sizeof(int)], nsize * sizeof(double));
+		return (status == 1);
+	}
+}
+#endif
+
+//-----------------------------------------------------------------------------
+bool FEJobScheduler::Run(int jobs, Job job, std::vector< std::vector<double> >& results)
+{
+	results.assign(jobs, std::vector<double>());
+	if (jobs <= 0) return true;
+	if ((IsParallel() == false) || (jobs == 1)) return RunSerial(jobs, job, results);
+
+#ifndef WIN32
+	// Make sure the workers don't inherit any pending output
+	fflush(NULL);
+
+	bool bret = true;
+	std::list<Worker> active;
+	int next = 0;
+	while ((next < jobs) || (active.empty() == false))
+	{
+		// start new workers
+		while ((next < jobs) && ((int)active.size() < m_maxJobs))
+		{
+			int n = next++;
+
+			pid_t pid = -1;
+			int fd[2];
+			if (pipe(fd) == 0)
+			{
+				pid = fork();
+				if (pid == 0)
+				{
+					close(fd[0]);
+					run_worker(job, n, fd[1]);
+				}
+				close(fd[1]);
+				if (pid < 0) close(fd[0]);
+			}
+
+			if (pid < 0)
+			{
+				// we could not create a worker, so run this job ourselves
+				if (job(n, results[n]) == false) bret = false;
+			}
+			else
+			{
+				Worker w;
+				w.pid = pid;
+				w.fd = fd[0];
+				w.job = n;
+				active.push_back(w);
+			}
+		}
+		if (active.empty()) continue;
+
+		// wait for data from any of the workers
+		std::vector<pollfd> pfd;
+		for (std::list<Worker>::iterator it = active.begin(); it != active.end(); ++it)
+		{
+			pollfd p = { it->fd, POLLIN, 0 };
+			pfd.push_back(p);
+		}
+		if (poll(&pfd[0], (nfds_t)pfd.size(), -1) < 0)
+		{
+			if (errno == EINTR) continue;
+
+			// something went wrong, so clean up the workers and bail
+			for (std::list<Worker>::iterator it = active.begin(); it != active.end(); ++it)
+			{
+				close(it->fd);
+				waitpid(it->pid, 0, 0);
+			}
+			return false;
+		}
+
+		// read the data and collect the workers that are done
+		int i = 0;
+		for (std::list<Worker>::iterator it = active.begin(); it != active.end(); ++i)
+		{
+			if (pfd[i].revents == 0) { ++it; continue; }
+
+			char tmp[4096];
+			ssize_t nread = read(it->fd, tmp, sizeof(tmp));
+			if ((nread < 0) && (errno == EINTR)) { ++it; continue; }
+			if (nread > 0)
+			{
+				it->buf.insert(it->buf.end(), tmp, tmp + nread);
+				++it;
+				continue;
+			}
+
+			// the worker closed the pipe, so it's done
+			close(it->fd);
+			int status = 0;
+			while ((waitpid(it->pid, &status, 0) < 0) && (errno == EINTR));
+			if (decode_result(it->buf, results[it->job]) == false) bret = false;
+			it = active.erase(it);
+		}
+	}
+
+	return bret;
+#else
+	return RunSerial(jobs, job, results);
+#endif
+}
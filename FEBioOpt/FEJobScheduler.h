@@ -0,0 +1,73 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <vector>
+#include <functional>
+
+//-----------------------------------------------------------------------------
+//! This class runs a number of independent jobs concurrently. 
+//! Each job runs in a forked worker process, so it works on its own copy of the 
+//! model and can change it freely. A job returns its results as an array of 
+//! doubles, which is sent back to the calling process. Results are stored by job
+//! index, so they do not depend on the order in which the workers finish. 
+//! Since the OpenMP runtime cannot be used with multiple threads after a fork, each
+//! worker runs single-threaded. Set the max number of jobs to the number of cores to
+//! use the whole machine.
+//! On platforms that do not support fork (i.e. Windows), or when only one job is
+//! allowed, the jobs are run one after another in the calling process. Note that
+//! in that case the jobs change the caller's model. 
+class FEJobScheduler
+{
+public:
+	//! A job is passed its index and fills in its results. 
+	//! It should return false if the job failed.
+	typedef std::function<bool(int, std::vector<double>&)> Job;
+
+public:
+	FEJobScheduler(int maxJobs = 1);
+
+	//! set the max number of jobs that can run concurrently
+	void SetMaxJobs(int n);
+
+	//! get the max number of jobs that can run concurrently
+	int MaxJobs() const { return m_maxJobs; }
+
+	//! see if jobs will run in worker processes
+	bool IsParallel() const;
+
+	//! Run the jobs 0 to (jobs - 1). The results of job i are returned in results[i]. 
+	//! Returns false if any of the jobs failed.
+	bool Run(int jobs, Job job, std::vector< std::vector<double> >& results);
+
+private:
+	bool RunSerial(int jobs, Job& job, std::vector< std::vector<double> >& results);
+
+private:
+	int	m_maxJobs;	//!< max number of concurrent jobs
+};
@@ -196,30 +196,35 @@ void FELMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a, vector<dou
 		}
 	}
 	
-	// evaluate at a
-	if (opt.FESolve(a) == false) throw FEErrorTermination();
-	
-	opt.GetObjective().Evaluate(y);
-	m_yopt = y;
-
-	// now calculate the derivatives using forward differences
-	int ndata = (int)x.size();
-	vector<double> a1(a);
-	vector<double> y1(ndata);
+	// Set up the parameters where we need to evaluate the functions, i.e. at a and 
+	// at the points needed for the forward differences. These are independent FE 
+	// solves, so we let the optimize data solve them all at once.
 	int ma = (int)a.size();
+	vector< vector<double> > A(ma + 1, a);
 	for (int i=0; i<ma; ++i)
 	{
 		FEInputParameter& var = *opt.GetInputParameter(i);
 
 		double b = var.ScaleFactor();
 
-		a1[i] = a1[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
-		assert(a1[i] != a[i]);
+		A[i + 1][i] = a[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
+		assert(A[i + 1][i] != a[i]);
+	}
+
+	vector< vector<double> > Y;
+	if (opt.FESolve(A, Y, true) == false) throw FEErrorTermination();
 
-		if (opt.FESolve(a1) == false) throw FEErrorTermination();
-		opt.GetObjective().Evaluate(y1);
-		for (int j=0; j<ndata; ++j) dyda[j][i] = (y1[j] - y[j])/(a1[i] - a[i]);
-		a1[i] = a[i];
+	// the function values at a
+	y = Y[0];
+	m_yopt = y;
+
+	// now calculate the derivatives using forward differences
+	int ndata = (int)x.size();
+	for (int i=0; i<ma; ++i)
+	{
+		const vector<double>& y1 = Y[i + 1];
+		double da = A[i + 1][i] - a[i];
+		for (int j=0; j<ndata; ++j) dyda[j][i] = (y1[j] - y[j])/da;
 	}
 }
 
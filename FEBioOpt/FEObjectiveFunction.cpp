@@ -88,6 +88,24 @@ double FEObjectiveFunction::Evaluate(vector<double>& y)
 	return chisq;
 }
 
+double FEObjectiveFunction::ObjectiveValue(const vector<double>& f)
+{
+	// get the measurement vector
+	int ndata = Measurements();
+	vector<double> y0(ndata);
+	GetMeasurements(y0);
+	assert((int)f.size() == ndata);
+
+	double chisq = 0.0;
+	for (int i = 0; i<ndata; ++i)
+	{
+		double dy = (f[i] - y0[i]);
+		chisq += dy*dy;
+	}
+
+	return chisq;
+}
+
 //=============================================================================
 
 //----------------------------------------------------------------------------
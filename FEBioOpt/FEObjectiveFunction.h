@@ -69,6 +69,10 @@ public:
 	// evaluate objective function
 	double Evaluate();
 
+	// calculate the objective value for the function values f
+	// (i.e. without evaluating the functions)
+	double ObjectiveValue(const vector<double>& f);
+
 	// print output to screen or not
 	void SetVerbose(bool b) { m_verbose = b; }
 
@@ -30,9 +30,11 @@ SOFTWARE.*/
 #include "FEOptimizeData.h"
 #include "FELMOptimizeMethod.h"
 #include "FEOptimizeInput.h"
+#include "FEJobScheduler.h"
 #include <FECore/FECoreKernel.h>
 #include <FECore/FEModel.h>
 #include <FECore/FEAnalysis.h>
+#include <FECore/FENewtonSolver.h>
 #include <FECore/log.h>
 //=============================================================================
 
@@ -102,6 +104,8 @@ FEOptimizeData::FEOptimizeData(FEModel* fem) : m_fem(fem)
 	m_pTask = 0;
 	m_niter = 0;
 	m_obj = 0;
+	m_maxJobs = 1;
+	m_bwarmStart = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -239,3 +243,111 @@ bool FEOptimizeData::FESolve(const vector<double>& a)
 
 	return bret;
 }
+
+//-----------------------------------------------------------------------------
+//! Solve the FE problem for several sets of parameters. When more than one job
+//! is allowed, the problems are solved in worker processes (see FEJobScheduler)
+//! and only the function values are returned; the state of the model is not 
+//! updated in that case.
+//! If bperturb is true, the parameters a[1], a[2], ... are small perturbations of
+//! a[0] (e.g. for finite differences). With the warm start option, a[0] is then 
+//! solved first, and its converged solutions are used as the initial guess for
+//! the time steps of the other solves.
+bool FEOptimizeData::FESolve(const vector< vector<double> >& a, vector< vector<double> >& y, bool bperturb)
+{
+	int jobs = (int)a.size();
+	y.resize(jobs);
+
+	if (bperturb && m_bwarmStart && (jobs > 1))
+	{
+		// solve the base problem and record its solution
+		m_history.Clear();
+		SetSolutionHistory(&m_history, nullptr);
+		bool bret = FESolve(a[0]);
+		SetSolutionHistory(nullptr, nullptr);
+		if (bret == false) return false;
+		GetObjective().Evaluate(y[0]);
+
+		// solve the others, starting from the base solution
+		SetSolutionHistory(nullptr, &m_history);
+		bret = SolveJobs(a, y, 1);
+		SetSolutionHistory(nullptr, nullptr);
+		return bret;
+	}
+	else return SolveJobs(a, y, 0);
+}
+
+//-----------------------------------------------------------------------------
+//! Solves the problems a[n0], a[n0 + 1], ... and stores the function values in y.
+bool FEOptimizeData::SolveJobs(const vector< vector<double> >& a, vector< vector<double> >& y, int n0)
+{
+	int jobs = (int)a.size() - n0;
+	if (jobs <= 0) return true;
+
+	FEJobScheduler scheduler(m_maxJobs);
+	if ((scheduler.IsParallel() == false) || (jobs == 1))
+	{
+		for (int n = n0; n < n0 + jobs; ++n)
+		{
+			if (FESolve(a[n]) == false) return false;
+			GetObjective().Evaluate(y[n]);
+		}
+		return true;
+	}
+
+	// The workers don't write to the log, so we report the new values here.
+	int nvar = InputParameters();
+	for (int n = 0; n < jobs; ++n)
+	{
+		if (nvar != (int)a[n0 + n].size()) return false;
+
+		feLog("\n----- Iteration: %d -----\n", m_niter + n + 1);
+		for (int i = 0; i<nvar; ++i)
+		{
+			FEInputParameter& var = *GetInputParameter(i);
+			string name = var.GetName();
+			feLog("%-15s = %lg\n", name.c_str(), a[n0 + n][i]);
+		}
+	}
+	m_niter += jobs;
+
+	// solve all problems
+	FEModel& fem = *GetFEModel();
+	FEObjectiveFunction& obj = GetObjective();
+	vector< vector<double> > yj;
+	bool bret = scheduler.Run(jobs, [&](int n, vector<double>& yn) {
+		fem.BlockLog();
+		if (FESolve(a[n0 + n]) == false) return false;
+		fem.BlockLog();
+		obj.Evaluate(yn);
+		return true;
+	}, yj);
+	if (bret == false) return false;
+
+	// report the objective values
+	for (int n = 0; n < jobs; ++n)
+	{
+		if ((int)yj[n].size() != obj.Measurements()) return false;
+		feLog("iteration %d: objective value: %lg\n", m_niter - jobs + n + 1, obj.ObjectiveValue(yj[n]));
+		y[n0 + n] = yj[n];
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Sets the solution history that the Newton solvers of all steps record to and
+//! take their initial guess from.
+void FEOptimizeData::SetSolutionHistory(FESolutionHistory* record, FESolutionHistory* initialGuess)
+{
+	FEModel& fem = *GetFEModel();
+	for (int i = 0; i < fem.Steps(); ++i)
+	{
+		FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(fem.GetStep(i)->GetFESolver());
+		if (solver)
+		{
+			solver->RecordSolutionHistory(record);
+			solver->SetInitialGuess(initialGuess);
+		}
+	}
+}
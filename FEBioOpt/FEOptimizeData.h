@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include <FEBioXML/XMLReader.h>
 #include <FECore/FEModel.h>
 #include <FECore/FECoreTask.h>
+#include <FECore/FESolutionHistory.h>
 #include "FEObjectiveFunction.h"
 #include <vector>
 #include <string>
@@ -144,6 +145,21 @@ public:
 	//! solve the FE problem with a new set of parameters
 	bool FESolve(const vector<double>& a);
 
+	//! Solve the FE problem for several sets of parameters and evaluate the objective
+	//! functions. The function values for the parameters a[i] are returned in y[i].
+	//! Up to MaxJobs() problems are solved concurrently. Set bperturb if a[1], a[2], ...
+	//! are small perturbations of a[0] (see warm start option).
+	bool FESolve(const vector< vector<double> >& a, vector< vector<double> >& y, bool bperturb = false);
+
+	//! set the max number of FE problems that can be solved concurrently
+	void SetMaxJobs(int n) { m_maxJobs = (n < 1 ? 1 : n); }
+
+	//! get the max number of FE problems that can be solved concurrently
+	int MaxJobs() const { return m_maxJobs; }
+
+	//! Use the solution of a base problem as the initial guess for perturbed problems
+	void SetWarmStart(bool b) { m_bwarmStart = b; }
+
 public:
 	// return the number of input parameters
 	int InputParameters() { return (int)m_Var.size(); }
@@ -179,9 +195,17 @@ public:
 
 	FECoreTask* m_pTask;	// the task that will solve the FE model
 
+protected:
+	bool SolveJobs(const vector< vector<double> >& a, vector< vector<double> >& y, int n0);
+	void SetSolutionHistory(FESolutionHistory* record, FESolutionHistory* initialGuess);
+
 protected:
 	FEModel*	m_fem;
 
+	int			m_maxJobs;	//!< max nr of concurrent FE solves
+	bool		m_bwarmStart;	//!< warm start perturbed solves from the base solve
+	FESolutionHistory	m_history;	//!< the converged solutions of the base solve
+
 	FEObjectiveFunction*	m_obj;		//!< the objective function
 
 	FEOptimizeMethod*	m_pSolver;
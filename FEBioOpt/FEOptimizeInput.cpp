@@ -137,6 +137,20 @@ void FEOptionsSection::Parse(XMLTag& tag)
 						else throw XMLReader::InvalidValue(tag);
 					}
 				}
+				else if (tag == "jobs")
+				{
+					// max number of FE solves that can run concurrently
+					int njobs = 1;
+					tag.value(njobs);
+					if (njobs < 1) throw XMLReader::InvalidValue(tag);
+					m_opt->SetMaxJobs(njobs);
+				}
+				else if (tag == "warm_start")
+				{
+					bool b = false;
+					tag.value(b);
+					m_opt->SetWarmStart(b);
+				}
 				else throw XMLReader::InvalidTag(tag);
 			}
 			++tag;
@@ -631,6 +631,18 @@ void FEBioPlotFile::Close()
 	m_ar.Close();
 }
 
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::Sync()
+{
+	m_ar.Sync();
+}
+
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::SetAsyncWrite(bool b)
+{
+	m_ar.SetAsyncWrite(b);
+}
+
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::Open(FEModel &fem, const char *szfile)
 {
@@ -289,6 +289,12 @@ public:
 	//! Write current FE state to plot database
 	bool Write(FEModel& fem, float ftime);
 
+	//! wait until all states are stored on disk
+	void Sync();
+
+	//! Turn background compression and writing of states on or off
+	void SetAsyncWrite(bool b);
+
 	//! Add a variable to the dictionary
 	bool AddVariable(FEPlotData* ps, const char* szname);
 	bool AddVariable(const char* sz);
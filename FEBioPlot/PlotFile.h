@@ -60,6 +60,9 @@ public:
 	//! see if the plot file is valid
 	virtual bool IsValid() const = 0;
 
+	//! wait until all states passed to Write are stored on disk
+	virtual void Sync() {}
+
 protected:
 	FEModel*	m_pfem;		//!< pointer to FE model
 };
@@ -207,6 +207,12 @@ PltArchive::PltArchive()
 	m_pRoot = 0;
 	m_pChunk = 0;
 	m_bSaving = true;
+	m_ncompress = 0;
+
+	m_basync = true;
+	m_maxPending = 64*1024*1024;	// = 64M
+	m_pending = 0;
+	m_bstop = false;
 }
 
 PltArchive::~PltArchive()
@@ -219,6 +225,7 @@ void PltArchive::Close()
 	if (m_bSaving)
 	{
 		if (m_pRoot) Flush();
+		StopWriter();
 	}
 	else 
 	{
@@ -237,22 +244,104 @@ void PltArchive::Close()
 
 void PltArchive::SetCompression(int n)
 {
-	if (m_fp) m_fp->SetCompression(n);
+	// The file stream may still be busy with a previous tree, so the
+	// compression level is stored with each tree when it is written.
+	m_ncompress = n;
+}
+
+void PltArchive::SetAsyncWrite(bool b)
+{
+	if (b == false) StopWriter();
+	m_basync = b;
 }
 
 void PltArchive::Flush()
 {
 	if (m_fp && m_pRoot)
 	{
-		m_fp->BeginStreaming();
-		m_pRoot->Write(m_fp);
-		m_fp->EndStreaming();
+		if (m_basync) QueueTree(m_pRoot);
+		else WriteTree(m_pRoot, m_ncompress);
 	}
-	delete m_pRoot;
+	else delete m_pRoot;
 	m_pRoot = 0;
 	m_pChunk = 0;
 }
 
+void PltArchive::WriteTree(OBranch* root, int ncompress)
+{
+	m_fp->SetCompression(ncompress);
+	m_fp->BeginStreaming();
+	root->Write(m_fp);
+	m_fp->EndStreaming();
+	delete root;
+}
+
+void PltArchive::QueueTree(OBranch* root)
+{
+	PENDING tree;
+	tree.root = root;
+	tree.ncompress = m_ncompress;
+	tree.nsize = (size_t) root->Size();
+
+	unique_lock<mutex> lock(m_mutex);
+
+	// start the writer thread on first use
+	if (m_writer.joinable() == false)
+	{
+		m_bstop = false;
+		m_writer = thread(&PltArchive::WriterLoop, this);
+	}
+
+	// Wait until there is room in the queue. A tree that is larger than the 
+	// max pending size is still accepted once the writer is idle.
+	m_cv.wait(lock, [&]() { return (m_pending == 0) || (m_pending + tree.nsize <= m_maxPending); });
+
+	m_queue.push_back(tree);
+	m_pending += tree.nsize;
+	m_cv.notify_all();
+}
+
+void PltArchive::WriterLoop()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		m_cv.wait(lock, [&]() { return m_bstop || (m_queue.empty() == false); });
+
+		// we only stop once all the data is written
+		if (m_queue.empty()) break;
+
+		PENDING tree = m_queue.front();
+		m_queue.pop_front();
+
+		// compress and write without holding the lock
+		lock.unlock();
+		WriteTree(tree.root, tree.ncompress);
+		lock.lock();
+
+		m_pending -= tree.nsize;
+		m_cv.notify_all();
+	}
+}
+
+void PltArchive::Sync()
+{
+	unique_lock<mutex> lock(m_mutex);
+	m_cv.wait(lock, [&]() { return (m_pending == 0); });
+}
+
+void PltArchive::StopWriter()
+{
+	if (m_writer.joinable() == false) return;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_bstop = true;
+	}
+	m_cv.notify_all();
+	m_writer.join();
+	m_bstop = false;
+}
+
 bool PltArchive::Create(const char* szfile)
 {
 	// attempt to create the file
@@ -35,6 +35,10 @@ SOFTWARE.*/
 #include <list>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 using namespace std;
 
 //-----------------------------------------------------------------------------
@@ -257,6 +261,16 @@ public:
 	// flush data to file
 	void Flush();
 
+	// wait until all queued chunk trees are written to file
+	void Sync();
+
+	// When on (default), completed chunk trees are compressed and written
+	// on a background thread so the caller can continue with its work.
+	void SetAsyncWrite(bool b);
+
+	// max bytes of chunk data that can be waiting for the writer thread
+	void SetMaxPendingSize(size_t nbytes) { m_maxPending = nbytes; }
+
 public:
 	// --- Writing ---
 
@@ -346,9 +360,42 @@ public:
 
 	bool IsValid() const { return (m_fp != 0); }
 
+protected:
+	// write a chunk tree to file and delete it
+	void WriteTree(OBranch* root, int ncompress);
+
+	// queue a chunk tree for the writer thread
+	void QueueTree(OBranch* root);
+
+	// writer thread's main loop
+	void WriterLoop();
+
+	// write all queued chunk trees and terminate the writer thread
+	void StopWriter();
+
+protected:
+	// a chunk tree waiting to be written
+	struct PENDING
+	{
+		OBranch*	root;		// tree root
+		int			ncompress;	// compression level
+		size_t		nsize;		// tree size in bytes
+	};
+
 protected:
 	FileStream*	m_fp;		// pointer to file stream
 	bool		m_bSaving;	// read or write mode?
+	int			m_ncompress;	// compression level for the next chunk tree
+
+	// background writer
+	bool					m_basync;		// write on background thread?
+	size_t					m_maxPending;	// max size of queued data
+	size_t					m_pending;		// size of queued (or in-progress) data
+	bool					m_bstop;		// writer thread stop flag
+	deque<PENDING>			m_queue;		// trees waiting to be written
+	thread					m_writer;		// the writer thread
+	mutex					m_mutex;
+	condition_variable		m_cv;
 
 	// write data
 	OBranch*	m_pRoot;	// chunk tree root
@@ -34,6 +34,8 @@ SOFTWARE.*/
 #include "FERestartDiagnostics.h"
 #include "FEJFNKTangentDiagnostic.h"
 #include "FEBioEigenSolver.h"
+#include "FESpMVBenchmark.h"
+#include "FESerializationBenchmark.h"
 
 namespace FEBioTest
 {
@@ -44,5 +46,7 @@ void InitModule()
 	REGISTER_FECORE_CLASS(FERestartDiagnostic, "restart_test");
 	REGISTER_FECORE_CLASS(FEJFNKTangentDiagnostic, "jfnk tangent test");
 	REGISTER_FECORE_CLASS(FEBioEigenSolver, "eigen");
+	REGISTER_FECORE_CLASS(FESpMVBenchmark, "spmv_benchmark");
+	REGISTER_FECORE_CLASS(FESerializationBenchmark, "dump_benchmark");
 }
 }
@@ -104,6 +104,9 @@ bool FEContactDiagnostic::Run()
 	solver.ContactStiffness(LS);
 //	solver.StiffnessMatrix();
 
+	// add the buffered contributions (e.g. rigid bodies and linear constraints)
+	LS.FinalizeAssembly();
+
 	print_matrix(K0);
 
 	// calculate the derivative of the residual
@@ -156,6 +156,9 @@ bool FEContactDiagnosticBiphasic::Run()
     // build the stiffness matrix
     K.Zero();
     solver.ContactStiffness(LS);
+
+	// add the buffered contributions (e.g. rigid bodies and linear constraints)
+	LS.FinalizeAssembly();
     
     print_matrix(K0);
     
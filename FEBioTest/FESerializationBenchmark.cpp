@@ -0,0 +1,153 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FESerializationBenchmark.h"
+#include <FECore/DumpMemStream.h>
+#include <FECore/FEModel.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+// The objects that are serialized. Each object stores some state data (about the
+// size of an elastic material point) and a pointer to a "parent" object that 
+// was serialized before, so the pointer table is used for each object.
+class BenchmarkObject
+{
+public:
+	BenchmarkObject() : m_parent(nullptr), m_id(0), m_F(1.0, 0.1, 0.0, 0.0, 1.0, 0.2, 0.3, 0.0, 1.0), m_s(1.0, 2.0, 3.0, 0.1, 0.2, 0.3)
+	{
+		for (int j = 0; j < 8; ++j) m_v[j] = (double)j;
+	}
+
+	void Serialize(DumpStream& ar)
+	{
+		ar & m_id & m_F & m_s & m_v;
+		ar & m_parent;
+	}
+
+	// These are only used for deep copies, and we only do shallow copies here.
+	static void SaveClass(DumpStream&, BenchmarkObject*) {}
+	static BenchmarkObject* LoadClass(DumpStream&, BenchmarkObject* p) { return p; }
+
+public:
+	BenchmarkObject*	m_parent;
+	int					m_id;
+	mat3d				m_F;
+	mat3ds				m_s;
+	double				m_v[8];
+};
+
+//-----------------------------------------------------------------------------
+FESerializationBenchmark::FESerializationBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_maxSize = 1000000;
+}
+
+//-----------------------------------------------------------------------------
+bool FESerializationBenchmark::Init(const char* szfile)
+{
+	if (szfile && (szfile[0] != 0))
+	{
+		m_maxSize = atoi(szfile);
+		if (m_maxSize <= 0) return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// create the objects. The parent of each object is one of the previous objects.
+static void create_objects(std::vector<BenchmarkObject*>& obj, int N, bool binit)
+{
+	obj.resize(N);
+	for (int i = 0; i < N; ++i)
+	{
+		BenchmarkObject* p = new BenchmarkObject;
+		if (binit)
+		{
+			p->m_id = i;
+			p->m_parent = (i > 0 ? obj[rand() % i] : nullptr);
+		}
+		obj[i] = p;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FESerializationBenchmark::Run()
+{
+	typedef std::chrono::steady_clock clock;
+
+	FEModel& fem = *GetFEModel();
+
+	printf("\nSerialization benchmark\n\n");
+	printf("%10s %12s %12s %12s %12s %12s %8s\n", "objects", "bytes", "write (ms)", "write MB/s", "read (ms)", "read MB/s", "check");
+	printf("-----------------------------------------------------------------------------------\n");
+
+	for (int N = 1000; N <= m_maxSize; N *= 10)
+	{
+		srand(1);
+		std::vector<BenchmarkObject*> src, dst;
+		create_objects(src, N, true);
+		create_objects(dst, N, false);
+
+		DumpMemStream ar(fem);
+
+		// write
+		ar.Open(true, true);
+		clock::time_point t0 = clock::now();
+		ar << src;
+		double tw = std::chrono::duration<double>(clock::now() - t0).count();
+		size_t bytes = ar.size();
+
+		// read
+		ar.Open(false, true);
+		t0 = clock::now();
+		ar >> dst;
+		double tr = std::chrono::duration<double>(clock::now() - t0).count();
+
+		// check that we got the same object graph back
+		bool bok = true;
+		for (int i = 0; i < N; ++i)
+		{
+			BenchmarkObject* ps = src[i];
+			BenchmarkObject* pd = dst[i];
+			int ns = (ps->m_parent ? ps->m_parent->m_id : -1);
+			int nd = (pd->m_parent ? pd->m_parent->m_id : -1);
+			if ((ps->m_id != pd->m_id) || (ns != nd)) { bok = false; break; }
+		}
+
+		double MB = (double)bytes / (1024.0*1024.0);
+		printf("%10d %12zu %12.4lg %12.4lg %12.4lg %12.4lg %8s\n", N, bytes, tw*1000.0, MB / tw, tr*1000.0, MB / tr, (bok ? "ok" : "FAILED"));
+
+		for (int i = 0; i < N; ++i) { delete src[i]; delete dst[i]; }
+	}
+
+	printf("\n");
+
+	return true;
+}
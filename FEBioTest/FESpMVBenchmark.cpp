@@ -0,0 +1,158 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FESpMVBenchmark.h"
+#include <NumCore/CompactSymmMatrix.h>
+#include <NumCore/CompactUnSymmMatrix.h>
+#include <FECore/MatrixProfile.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FESpMVBenchmark::FESpMVBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_maxSize = 40;
+}
+
+//-----------------------------------------------------------------------------
+bool FESpMVBenchmark::Init(const char* szfile)
+{
+	if (szfile && (szfile[0] != 0))
+	{
+		m_maxSize = atoi(szfile);
+		if (m_maxSize <= 0) return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// time the matrix-vector product and return the time (in seconds) per product
+static double time_mult_vector(SparseMatrix& A, vector<double>& x, vector<double>& r)
+{
+	typedef std::chrono::steady_clock clock;
+
+	// warm-up (this also builds any helper structures)
+	A.mult_vector(&x[0], &r[0]);
+
+	// repeat until we have a reasonable measurement
+	int nreps = 0;
+	double t = 0.0;
+	clock::time_point t0 = clock::now();
+	do
+	{
+		for (int i = 0; i < 10; ++i) A.mult_vector(&x[0], &r[0]);
+		nreps += 10;
+		t = std::chrono::duration<double>(clock::now() - t0).count();
+	}
+	while (t < 0.5);
+
+	return t / nreps;
+}
+
+//-----------------------------------------------------------------------------
+bool FESpMVBenchmark::Run()
+{
+	printf("\nSparse matrix-vector product benchmark\n\n");
+	printf("%10s %10s %12s %12s %10s %12s\n", "format", "equations", "nonzeroes", "time (ms)", "GFLOP/s", "error");
+	printf("-------------------------------------------------------------------------\n");
+
+	for (int n = 10; n <= m_maxSize; n += 10)
+	{
+		// build the element equation numbers of a structured mesh
+		int n1 = n + 1;
+		int neq = 3 * n1*n1*n1;
+		int NE = n*n*n;
+		vector< vector<int> > LM(NE, vector<int>(24));
+		for (int k = 0; k < n; ++k)
+			for (int j = 0; j < n; ++j)
+				for (int i = 0; i < n; ++i)
+				{
+					vector<int>& lm = LM[(k*n + j)*n + i];
+					for (int a = 0; a < 8; ++a)
+					{
+						int na = ((k + a / 4)*n1 + (j + (a / 2) % 2))*n1 + i + a % 2;
+						lm[3 * a] = 3 * na;
+						lm[3 * a + 1] = 3 * na + 1;
+						lm[3 * a + 2] = 3 * na + 2;
+					}
+				}
+
+		SparseMatrixProfile MP(neq, neq);
+		MP.CreateDiagonal();
+		MP.UpdateProfile(LM, NE);
+
+		// the formats we're testing
+		CRSSparseMatrix  CRS(0);
+		CCSSparseMatrix  CCS(0);
+		CompactSymmMatrix SYM(0);
+		CompactMatrix* mat[] = { &CRS, &CCS, &SYM };
+		const char* szname[] = { "CRS", "CCS", "symmetric" };
+		for (int m = 0; m < 3; ++m) { mat[m]->Create(MP); mat[m]->Zero(); }
+
+		// assemble (the same) random symmetric element matrices
+		srand(1);
+		matrix ke(24, 24);
+		for (int e = 0; e < NE; ++e)
+		{
+			for (int i = 0; i < 24; ++i)
+				for (int j = 0; j <= i; ++j) ke[i][j] = ke[j][i] = (double)rand() / RAND_MAX - 0.5;
+
+			for (int m = 0; m < 3; ++m) mat[m]->Assemble(ke, LM[e]);
+		}
+
+		// random vector
+		vector<double> x(neq), r0(neq), r(neq);
+		for (int i = 0; i < neq; ++i) x[i] = (double)rand() / RAND_MAX;
+
+		// the CRS format is the reference
+		CRS.mult_vector(&x[0], &r0[0]);
+		double rmax = 0.0;
+		for (int i = 0; i < neq; ++i) rmax = fmax(rmax, fabs(r0[i]));
+
+		// all formats are compared with the flops of the full matrix
+		double flops = 2.0*CRS.NonZeroes();
+
+		for (int m = 0; m < 3; ++m)
+		{
+			double t = time_mult_vector(*mat[m], x, r);
+
+			double err = 0.0;
+			for (int i = 0; i < neq; ++i) err = fmax(err, fabs(r[i] - r0[i]));
+			if (rmax > 0.0) err /= rmax;
+
+			printf("%10s %10d %12d %12.4lg %10.3lg %12.3lg\n", szname[m], neq, mat[m]->NonZeroes(), t*1000.0, flops / t * 1e-9, err);
+		}
+	}
+
+	printf("\n");
+
+	return true;
+}
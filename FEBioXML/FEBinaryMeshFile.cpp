@@ -0,0 +1,645 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEBinaryMeshFile.h"
+#include "FEModelBuilder.h"
+#include <FECore/FEMesh.h>
+#include <FECore/FEDomain.h>
+#include <FECore/FENodeDataMap.h>
+#include <FECore/FESurfaceMap.h>
+#include <FECore/FEDomainMap.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// file header
+#define FEBM_MAGIC		"FEBM"
+#define FEBM_VERSION	1
+#define FEBM_ENDIAN		0x01020304
+
+//-----------------------------------------------------------------------------
+// round up to the next multiple of 8 bytes
+static size_t pad8(size_t n) { return (n + 7) & ~((size_t)7); }
+
+//-----------------------------------------------------------------------------
+static bool is_little_endian()
+{
+	uint32_t n = 1;
+	return (*(char*)&n == 1);
+}
+
+//-----------------------------------------------------------------------------
+// helper class for reading the data of a block
+class FEBlockReader
+{
+public:
+	FEBlockReader(const char* data, size_t size) : m_p(data), m_end(data + size), m_ok(true) {}
+
+	bool ok() const { return m_ok; }
+
+	uint32_t read4()
+	{
+		if (check(4) == false) return 0;
+		uint32_t n; memcpy(&n, m_p, 4); m_p += 4;
+		return n;
+	}
+
+	uint64_t read8()
+	{
+		if (check(8) == false) return 0;
+		uint64_t n; memcpy(&n, m_p, 8); m_p += 8;
+		return n;
+	}
+
+	std::string readString()
+	{
+		uint64_t l = read8();
+		if (check(pad8(l)) == false) return std::string();
+		std::string s(m_p, (size_t) l);
+		m_p += pad8(l);
+		return s;
+	}
+
+	// The block data is 8-byte aligned in the file (and the file is page aligned in memory),
+	// so these arrays can be accessed in place.
+	const int* readInts(uint64_t n)
+	{
+		if (check(pad8(n * 4)) == false) return nullptr;
+		const int* d = (const int*) m_p;
+		m_p += pad8(n * 4);
+		return d;
+	}
+
+	const double* readDoubles(uint64_t n)
+	{
+		if (check(n * 8) == false) return nullptr;
+		const double* d = (const double*) m_p;
+		m_p += n * 8;
+		return d;
+	}
+
+private:
+	bool check(size_t n)
+	{
+		if (m_ok && ((size_t)(m_end - m_p) < n)) m_ok = false;
+		return m_ok;
+	}
+
+private:
+	const char*	m_p;
+	const char*	m_end;
+	bool		m_ok;
+};
+
+//-----------------------------------------------------------------------------
+// helper class for building the data of a block
+class FEBlockWriter
+{
+public:
+	FEBlockWriter(const char* szid) { memcpy(m_id, szid, 4); }
+
+	void write4(uint32_t n) { append(&n, 4); }
+	void write8(uint64_t n) { append(&n, 8); }
+
+	void writeString(const std::string& s)
+	{
+		write8(s.size());
+		append(s.c_str(), s.size());
+		pad();
+	}
+
+	void writeInts(const std::vector<int>& v)
+	{
+		if (v.empty() == false) append(&v[0], v.size() * sizeof(int));
+		pad();
+	}
+
+	void writeDoubles(const double* v, size_t n)
+	{
+		if (n > 0) append(v, n * sizeof(double));
+	}
+
+	bool flush(FILE* fp)
+	{
+		pad();
+		uint32_t zero = 0;
+		uint64_t size = m_data.size();
+		if (fwrite(m_id, 1, 4, fp) != 4) return false;
+		if (fwrite(&zero, 4, 1, fp) != 1) return false;
+		if (fwrite(&size, 8, 1, fp) != 1) return false;
+		if (size > 0) return (fwrite(&m_data[0], 1, size, fp) == size);
+		return true;
+	}
+
+private:
+	void append(const void* d, size_t n)
+	{
+		const char* c = (const char*) d;
+		m_data.insert(m_data.end(), c, c + n);
+	}
+
+	void pad() { m_data.resize(pad8(m_data.size()), 0); }
+
+private:
+	char				m_id[4];
+	std::vector<char>	m_data;
+};
+
+//=============================================================================
+FEBinaryMeshFile::FEBinaryMeshFile()
+{
+	m_buf = nullptr;
+	m_size = 0;
+	m_map = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEBinaryMeshFile::~FEBinaryMeshFile()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBinaryMeshFile::Error(const char* sz)
+{
+	m_err = sz;
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+void FEBinaryMeshFile::Close()
+{
+#ifdef WIN32
+	if (m_map)
+	{
+		UnmapViewOfFile(m_buf);
+		CloseHandle((HANDLE) m_map);
+	}
+#else
+	if (m_map) munmap(m_map, m_size);
+#endif
+	m_map = nullptr;
+	m_buf = nullptr;
+	m_size = 0;
+	m_copy.clear();
+	m_block.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBinaryMeshFile::Open(const char* szfile)
+{
+	Close();
+
+	if (is_little_endian() == false) return Error("Binary mesh files are only supported on little-endian machines.");
+
+	// map the file into memory
+#ifdef WIN32
+	HANDLE hf = CreateFileA(szfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hf == INVALID_HANDLE_VALUE) return Error("Failed opening binary mesh file.");
+	LARGE_INTEGER fs;
+	GetFileSizeEx(hf, &fs);
+	m_size = (size_t) fs.QuadPart;
+	HANDLE hm = (m_size > 0 ? CreateFileMapping(hf, NULL, PAGE_READONLY, 0, 0, NULL) : NULL);
+	if (hm)
+	{
+		m_buf = (const char*) MapViewOfFile(hm, FILE_MAP_READ, 0, 0, 0);
+		if (m_buf) m_map = (void*) hm; else CloseHandle(hm);
+	}
+	CloseHandle(hf);
+#else
+	int fd = open(szfile, O_RDONLY);
+	if (fd < 0) return Error("Failed opening binary mesh file.");
+	struct stat st;
+	fstat(fd, &st);
+	m_size = (size_t) st.st_size;
+	if (m_size > 0)
+	{
+		void* p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) { m_map = p; m_buf = (const char*) p; }
+	}
+	close(fd);
+#endif
+
+	// if the file could not be mapped, we just read it
+	if (m_buf == nullptr)
+	{
+		FILE* fp = fopen(szfile, "rb");
+		if (fp == nullptr) return Error("Failed opening binary mesh file.");
+		m_copy.resize(m_size);
+		size_t nread = (m_size > 0 ? fread(&m_copy[0], 1, m_size, fp) : 0);
+		fclose(fp);
+		if (nread != m_size) { Close(); return Error("Failed reading binary mesh file."); }
+		if (m_size > 0) m_buf = &m_copy[0];
+	}
+
+	// check the header
+	FEBlockReader hdr(m_buf, m_size);
+	char magic[4] = { 0 };
+	if (m_size >= 4) memcpy(magic, m_buf, 4);
+	hdr.read4();
+	uint32_t version = hdr.read4();
+	uint32_t endian  = hdr.read4();
+	hdr.read4();
+	if ((hdr.ok() == false) || (strncmp(magic, FEBM_MAGIC, 4) != 0)) { Close(); return Error("This is not a binary mesh file."); }
+	if (endian != FEBM_ENDIAN) { Close(); return Error("Invalid byte order in binary mesh file."); }
+	if (version > FEBM_VERSION) { Close(); return Error("Unsupported version of binary mesh file."); }
+
+	// build the block list
+	size_t pos = 16;
+	while (pos < m_size)
+	{
+		if (m_size - pos < 16) { Close(); return Error("Binary mesh file is truncated."); }
+
+		BLOCK b;
+		memcpy(b.id, m_buf + pos, 4);
+		uint64_t size;
+		memcpy(&size, m_buf + pos + 8, 8);
+		pos += 16;
+		if (size > m_size - pos) { Close(); return Error("Binary mesh file is truncated."); }
+
+		b.data = m_buf + pos;
+		b.size = (size_t) size;
+		m_block.push_back(b);
+
+		pos += pad8((size_t) size);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBinaryMeshFile::ReadPart(FEModelBuilder& builder, FEBModel::Part& part)
+{
+	for (size_t i=0; i<m_block.size(); ++i)
+	{
+		BLOCK& b = m_block[i];
+		FEBlockReader r(b.data, b.size);
+
+		if (strncmp(b.id, "NODE", 4) == 0)
+		{
+			uint64_t n = r.read8();
+			const int* id = r.readInts(n);
+			const double* x = r.readDoubles(3*n);
+			if (r.ok() == false) return Error("Invalid NODE block in binary mesh file.");
+
+			vector<FEBModel::NODE> node((size_t) n);
+			for (size_t j=0; j<n; ++j)
+			{
+				node[j].id = id[j];
+				node[j].r = vec3d(x[3*j], x[3*j+1], x[3*j+2]);
+			}
+			part.AddNodes(node);
+		}
+		else if (strncmp(b.id, "DOMN", 4) == 0)
+		{
+			std::string name = r.readString();
+			std::string type = r.readString();
+			uint64_t n = r.read8();
+			uint64_t m = r.read8();
+			const int* id = r.readInts(n);
+			const int* en = r.readInts(n*m);
+			if ((r.ok() == false) || (m > FEElement::MAX_NODES)) return Error("Invalid DOMN block in binary mesh file.");
+
+			FE_Element_Spec spec = builder.ElementSpec(type.c_str());
+			if (FEElementLibrary::IsValid(spec) == false) return Error("Invalid element type in binary mesh file.");
+
+			FEBModel::Domain* dom = new FEBModel::Domain(spec);
+			dom->SetName(name);
+			part.AddDomain(dom);
+
+			dom->Create((int) n);
+			for (size_t j=0; j<n; ++j)
+			{
+				FEBModel::ELEMENT& el = dom->GetElement((int) j);
+				el.id = id[j];
+				for (size_t k=0; k<m; ++k) el.node[k] = en[j*m + k];
+			}
+		}
+		else if (strncmp(b.id, "NSET", 4) == 0)
+		{
+			std::string name = r.readString();
+			uint64_t n = r.read8();
+			const int* id = r.readInts(n);
+			if (r.ok() == false) return Error("Invalid NSET block in binary mesh file.");
+
+			FEBModel::NodeSet* set = new FEBModel::NodeSet(name);
+			set->SetNodeList(vector<int>(id, id + n));
+			part.AddNodeSet(set);
+		}
+		else if (strncmp(b.id, "ESET", 4) == 0)
+		{
+			std::string name = r.readString();
+			uint64_t n = r.read8();
+			const int* id = r.readInts(n);
+			if (r.ok() == false) return Error("Invalid ESET block in binary mesh file.");
+
+			FEBModel::ElementSet* set = new FEBModel::ElementSet(name);
+			set->SetElementList(vector<int>(id, id + n));
+			part.AddElementSet(set);
+		}
+		else if (strncmp(b.id, "SURF", 4) == 0)
+		{
+			std::string name = r.readString();
+			uint64_t n = r.read8();
+			const int* ntype = r.readInts(n);
+			uint64_t m = r.read8();
+			const int* fn = r.readInts(m);
+			if (r.ok() == false) return Error("Invalid SURF block in binary mesh file.");
+
+			FEBModel::Surface* surf = new FEBModel::Surface(name);
+			part.AddSurface(surf);
+			surf->Create((int) n);
+			size_t k = 0;
+			for (size_t j=0; j<n; ++j)
+			{
+				FEBModel::FACET& face = surf->GetFacet((int) j);
+				face.id = (int) j + 1;
+				face.ntype = ntype[j];
+				if ((face.ntype <= 0) || (face.ntype > FEElement::MAX_NODES) || (k + face.ntype > m)) return Error("Invalid SURF block in binary mesh file.");
+				for (int l=0; l<face.ntype; ++l) face.node[l] = fn[k++];
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBinaryMeshFile::ReadDataMaps(FEMesh& mesh)
+{
+	for (size_t i=0; i<m_block.size(); ++i)
+	{
+		BLOCK& b = m_block[i];
+		if (strncmp(b.id, "DMAP", 4) != 0) continue;
+
+		FEBlockReader r(b.data, b.size);
+		int mapType = (int) r.read4();
+		FEDataType dataType = (FEDataType) r.read4();
+		Storage_Fmt fmt = (Storage_Fmt) r.read4();
+		r.read4();
+		std::string name = r.readString();
+		std::string setName = r.readString();
+		uint64_t n = r.read8();
+		const double* v = r.readDoubles(n);
+		if (r.ok() == false) return Error("Invalid DMAP block in binary mesh file.");
+
+		// create the map on its set
+		FEDataMap* map = nullptr;
+		if (mapType == FE_NODE_DATA_MAP)
+		{
+			FENodeSet* set = mesh.FindNodeSet(setName);
+			if (set == nullptr) return Error("Invalid node set in binary mesh file data map.");
+			FENodeDataMap* nodeMap = new FENodeDataMap(dataType);
+			nodeMap->Create(set);
+			map = nodeMap;
+		}
+		else if (mapType == FE_SURFACE_MAP)
+		{
+			FEFacetSet* set = mesh.FindFacetSet(setName);
+			if (set == nullptr) return Error("Invalid surface in binary mesh file data map.");
+			FESurfaceMap* surfMap = new FESurfaceMap(dataType);
+			surfMap->Create(set, 0.0, fmt);
+			map = surfMap;
+		}
+		else if (mapType == FE_DOMAIN_MAP)
+		{
+			FEElementSet* set = mesh.FindElementSet(setName);
+			if (set == nullptr) return Error("Invalid element set in binary mesh file data map.");
+			FEDomainMap* domMap = new FEDomainMap(dataType, fmt);
+			domMap->Create(set);
+			map = domMap;
+		}
+		else continue;
+
+		// copy the values
+		if (map->BufferSize() != (int) n)
+		{
+			delete map;
+			return Error("Data map size mismatch in binary mesh file.");
+		}
+		if (n > 0) memcpy(map->GetBuffer(), v, n * sizeof(double));
+
+		map->SetName(name);
+		mesh.AddDataMap(map);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// the element type string for an element shape (see FEModelBuilder::ElementSpec)
+static const char* element_type_string(int shape)
+{
+	switch (shape)
+	{
+	case ET_TET4   : return "tet4";
+	case ET_TET5   : return "tet5";
+	case ET_TET10  : return "tet10";
+	case ET_TET15  : return "tet15";
+	case ET_TET20  : return "tet20";
+	case ET_PENTA6 : return "penta6";
+	case ET_PENTA15: return "penta15";
+	case ET_HEX8   : return "hex8";
+	case ET_HEX20  : return "hex20";
+	case ET_HEX27  : return "hex27";
+	case ET_PYRA5  : return "pyra5";
+	case ET_QUAD4  : return "quad4";
+	case ET_QUAD8  : return "quad8";
+	case ET_QUAD9  : return "quad9";
+	case ET_TRI3   : return "tri3";
+	case ET_TRI6   : return "tri6";
+	case ET_TRUSS2 : return "truss2";
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBinaryMeshFile::Write(const char* szfile, FEMesh& mesh)
+{
+	if (is_little_endian() == false) return false;
+
+	FILE* fp = fopen(szfile, "wb");
+	if (fp == nullptr) return false;
+
+	// header
+	uint32_t hdr[4] = { 0, FEBM_VERSION, FEBM_ENDIAN, 0 };
+	memcpy(hdr, FEBM_MAGIC, 4);
+	bool bok = (fwrite(hdr, 4, 4, fp) == 4);
+
+	// nodes
+	int NN = mesh.Nodes();
+	{
+		FEBlockWriter b("NODE");
+		vector<int> id(NN);
+		vector<double> x(3*NN);
+		for (int i=0; i<NN; ++i)
+		{
+			FENode& node = mesh.Node(i);
+			id[i] = node.GetID();
+			x[3*i  ] = node.m_r0.x;
+			x[3*i+1] = node.m_r0.y;
+			x[3*i+2] = node.m_r0.z;
+		}
+		b.write8(NN);
+		b.writeInts(id);
+		b.writeDoubles(x.empty() ? nullptr : &x[0], x.size());
+		bok = bok && b.flush(fp);
+	}
+
+	// domains
+	for (int i=0; i<mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		int NE = dom.Elements();
+		if (NE == 0) continue;
+
+		// we can only store domains that can be defined in the Mesh section
+		const char* sztype = element_type_string(dom.ElementRef(0).Shape());
+		if ((sztype == nullptr) || (dom.Class() == FE_DOMAIN_DISCRETE)) continue;
+
+		int neln = dom.ElementRef(0).Nodes();
+		vector<int> id(NE), en(NE*neln);
+		for (int j=0; j<NE; ++j)
+		{
+			FEElement& el = dom.ElementRef(j);
+			id[j] = el.GetID();
+			for (int k=0; k<neln; ++k) en[j*neln + k] = mesh.Node(el.m_node[k]).GetID();
+		}
+
+		FEBlockWriter b("DOMN");
+		b.writeString(dom.GetName());
+		b.writeString(sztype);
+		b.write8(NE);
+		b.write8(neln);
+		b.writeInts(id);
+		b.writeInts(en);
+		bok = bok && b.flush(fp);
+	}
+
+	// node sets
+	for (int i=0; i<mesh.NodeSets(); ++i)
+	{
+		FENodeSet& set = *mesh.NodeSet(i);
+		int n = set.Size();
+		vector<int> id(n);
+		for (int j=0; j<n; ++j) id[j] = mesh.Node(set[j]).GetID();
+
+		FEBlockWriter b("NSET");
+		b.writeString(set.GetName());
+		b.write8(n);
+		b.writeInts(id);
+		bok = bok && b.flush(fp);
+	}
+
+	// element sets
+	for (int i=0; i<mesh.ElementSets(); ++i)
+	{
+		FEElementSet& set = mesh.ElementSet(i);
+
+		FEBlockWriter b("ESET");
+		b.writeString(set.GetName());
+		b.write8(set.Elements());
+		b.writeInts(set.GetElementIDList());
+		bok = bok && b.flush(fp);
+	}
+
+	// surfaces
+	for (int i=0; i<mesh.FacetSets(); ++i)
+	{
+		FEFacetSet& set = mesh.FacetSet(i);
+		int NF = set.Faces();
+		vector<int> ntype(NF), fn;
+		for (int j=0; j<NF; ++j)
+		{
+			FEFacetSet::FACET& face = set.Face(j);
+			ntype[j] = face.ntype;
+			for (int k=0; k<face.ntype; ++k) fn.push_back(mesh.Node(face.node[k]).GetID());
+		}
+
+		FEBlockWriter b("SURF");
+		b.writeString(set.GetName());
+		b.write8(NF);
+		b.writeInts(ntype);
+		b.write8(fn.size());
+		b.writeInts(fn);
+		bok = bok && b.flush(fp);
+	}
+
+	// data maps
+	for (int i=0; i<mesh.DataMaps(); ++i)
+	{
+		FEDataMap* map = mesh.GetDataMap(i);
+
+		int fmt = 0;
+		std::string setName;
+		if (map->DataMapType() == FE_NODE_DATA_MAP)
+		{
+			FENodeDataMap* nodeMap = dynamic_cast<FENodeDataMap*>(map);
+			if (nodeMap && nodeMap->GetNodeSet()) setName = nodeMap->GetNodeSet()->GetName();
+		}
+		else if (map->DataMapType() == FE_SURFACE_MAP)
+		{
+			FESurfaceMap* surfMap = dynamic_cast<FESurfaceMap*>(map);
+			if (surfMap && surfMap->GetFacetSet()) setName = surfMap->GetFacetSet()->GetName();
+			if (surfMap) fmt = surfMap->StorageFormat();
+		}
+		else if (map->DataMapType() == FE_DOMAIN_MAP)
+		{
+			FEDomainMap* domMap = dynamic_cast<FEDomainMap*>(map);
+			if (domMap && domMap->GetElementSet()) setName = domMap->GetElementSet()->GetName();
+			if (domMap) fmt = domMap->StorageFormat();
+		}
+
+		// skip maps that are not defined on a named set
+		if (setName.empty()) continue;
+
+		FEBlockWriter b("DMAP");
+		b.write4(map->DataMapType());
+		b.write4(map->DataType());
+		b.write4(fmt);
+		b.write4(0);
+		b.writeString(map->GetName());
+		b.writeString(setName);
+		b.write8(map->BufferSize());
+		b.writeDoubles(map->GetBuffer(), map->BufferSize());
+		bok = bok && b.flush(fp);
+	}
+
+	fclose(fp);
+
+	return bok;
+}
@@ -0,0 +1,105 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "febioxml_api.h"
+#include "FEBModel.h"
+#include <vector>
+#include <string>
+
+//-----------------------------------------------------------------------------
+class FEMesh;
+class FEModelBuilder;
+
+//-----------------------------------------------------------------------------
+// This class reads and writes the binary mesh file format (.febm). 
+// A binary mesh file can be referenced from the Mesh section (or a Part) 
+// and the MeshData section of an feb file with an Include tag, e.g.
+//
+//   <Mesh>
+//     <Include>model.febm</Include>
+//   </Mesh>
+//
+// The file is little-endian and consists of a header, followed by a list of 
+// blocks. Each block has a 16-byte header (4-character id, 4 reserved bytes and
+// the 8-byte size of the block data) and its data. All block data is padded to
+// 8 bytes so that arrays can be read directly from the memory-mapped file.
+// Blocks that are not recognized are skipped. The following blocks are defined
+// ("str" is an 8-byte length followed by the characters, "int[n]" and "dbl[n]"
+// are arrays of 4-byte integers and 8-byte doubles, each padded to 8 bytes):
+//
+//   NODE: count n, int[n] node IDs, dbl[3n] coordinates
+//   DOMN: str name, str element type, count n, nodes per element m, int[n] element IDs, int[nm] node IDs
+//   NSET: str name, count n, int[n] node IDs
+//   ESET: str name, count n, int[n] element IDs
+//   SURF: str name, count n, int[n] facet types (= nr of nodes), count m, int[m] node IDs
+//   DMAP: map type, data type, format and zero (4 bytes each), str name, str set name, count n, dbl[n] values
+//
+class FEBIOXML_API FEBinaryMeshFile
+{
+public:
+	FEBinaryMeshFile();
+	~FEBinaryMeshFile();
+
+	//! open (and memory-map) a binary mesh file
+	bool Open(const char* szfile);
+
+	//! close the file
+	void Close();
+
+	//! Read the nodes, domains and sets into a part
+	bool ReadPart(FEModelBuilder& builder, FEBModel::Part& part);
+
+	//! Create the data maps of the file in the mesh
+	//! (this requires that the sets of the maps were already created)
+	bool ReadDataMaps(FEMesh& mesh);
+
+	//! get the error message of the last failed operation
+	const std::string& GetErrorString() const { return m_err; }
+
+public:
+	//! write the mesh of a model to a binary mesh file
+	static bool Write(const char* szfile, FEMesh& mesh);
+
+private:
+	struct BLOCK
+	{
+		char			id[4];
+		const char*		data;
+		size_t			size;
+	};
+
+	bool Error(const char* sz);
+
+private:
+	const char*		m_buf;		//!< start of the file in memory
+	size_t			m_size;		//!< size of file
+	void*			m_map;		//!< platform handle of the memory map
+	std::vector<char>	m_copy;	//!< file data, if the file could not be mapped
+	std::vector<BLOCK>	m_block;	//!< block list
+	std::string		m_err;		//!< error string
+};
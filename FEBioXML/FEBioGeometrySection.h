@@ -142,6 +142,7 @@ protected:
 	void ParsePartNodeSetSection(XMLTag& tag, FEBModel::Part* part);
 	void ParsePartSurfaceSection(XMLTag& tag, FEBModel::Part* part);
 	void ParsePartElementSetSection(XMLTag& tag, FEBModel::Part* part);
+	void ParsePartIncludeSection(XMLTag& tag, FEBModel::Part* part);
 
 protected:
 	FEBModel			m_feb;
@@ -36,6 +36,8 @@ SOFTWARE.*/
 #include "FEBioMech/FEElasticMaterial.h"
 #include "FECore/FECoreKernel.h"
 #include <FECore/FENodeNodeList.h>
+#include "FEBinaryMeshFile.h"
+#include "XMLBlockReader.h"
 
 //-----------------------------------------------------------------------------
 // functions defined in FEBioGeometrySection
@@ -137,12 +139,24 @@ void FEBioGeometrySection3::ParsePart(XMLTag& tag, FEBModel::Part* part)
 		else if (tag == "NodeSet"    ) ParsePartNodeSetSection(tag, part);
 		else if (tag == "Surface"    ) ParsePartSurfaceSection(tag, part);
 		else if (tag == "ElementSet" ) ParsePartElementSetSection(tag, part);
+		else if (tag == "Include"    ) ParsePartIncludeSection(tag, part);
 		else throw XMLReader::InvalidTag(tag);
 		++tag;
 	}
 	while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+//! Reads the part's mesh from a binary mesh file (see FEBinaryMeshFile).
+void FEBioGeometrySection3::ParsePartIncludeSection(XMLTag& tag, FEBModel::Part* part)
+{
+	std::string fileName = GetReferencedFilePath(tag);
+
+	FEBinaryMeshFile file;
+	if ((file.Open(fileName.c_str()) == false) || (file.ReadPart(*GetBuilder(), *part) == false))
+		throw XMLReader::Error(tag, "Failed reading binary mesh file " + fileName + ": " + file.GetErrorString());
+}
+
 //-----------------------------------------------------------------------------
 void FEBioGeometrySection3::ParseInstanceSection(XMLTag& tag)
 {
@@ -334,10 +348,6 @@ void FEBioGeometrySection3::ParsePartNodeSection(XMLTag& tag, FEBModel::Part* pa
 	FEMesh& mesh = fem.GetMesh();
 	int N0 = mesh.Nodes();
 
-	// first we need to figure out how many nodes there are
-	XMLTag t(tag);
-	int nodes = tag.children();
-
 	// see if this list defines a set
 	const char* szname = tag.AttributeValue("name", true);
 	FEBModel::NodeSet* ps = 0;
@@ -347,23 +357,28 @@ void FEBioGeometrySection3::ParsePartNodeSection(XMLTag& tag, FEBModel::Part* pa
 		part->AddNodeSet(ps);
 	}
 
-	// allocate node
-	vector<FEBModel::NODE> node(nodes);
-	vector<int> nodeList(nodes);
+	// read all nodes at once
+	XMLBlockReader block;
+	block.Read(tag);
+	int nodes = block.Elements();
 
-	// read nodal coordinates
-	++tag;
+	// get the nodal IDs
+	vector<int> nodeList;
+	block.AttributeValues("id", nodeList);
+
+	// get the nodal coordinates
+	vector<double> r(3*nodes);
+	vector<int> count(nodes);
+	if (nodes > 0) block.Values(&r[0], 3, &count[0]);
+
+	vector<FEBModel::NODE> node(nodes);
 	for (int i = 0; i<nodes; ++i)
 	{
-		FEBModel::NODE& nd = node[i];
-		value(tag, nd.r);
+		if (count[i] != 3) throw XMLReader::XMLSyntaxError(block.LineNumber(i));
 
-		// get the nodal ID
-		tag.AttributeValue("id", nd.id);
-		nodeList[i] = nd.id;
-
-		// go on to the next node
-		++tag;
+		FEBModel::NODE& nd = node[i];
+		nd.id = nodeList[i];
+		nd.r = vec3d(r[3*i], r[3*i+1], r[3*i+2]);
 	}
 
 	// add nodes to the part
@@ -495,8 +510,10 @@ void FEBioGeometrySection3::ParsePartElementSection(XMLTag& tag, FEBModel::Part*
 	if (szname) dom->SetName(szname);
 	if (szmat) dom->SetMaterialName(szmat);
 
-	// count elements
-	int elems = tag.children();
+	// read all elements at once
+	XMLBlockReader block;
+	block.Read(tag);
+	int elems = block.Elements();
 	assert(elems);
 
 	// add domain it to the mesh
@@ -511,23 +528,19 @@ void FEBioGeometrySection3::ParsePartElementSection(XMLTag& tag, FEBModel::Part*
 		part->AddElementSet(pg);
 	}
 
-	vector<int> elemList(elems);
+	// get the element IDs
+	vector<int> elemList;
+	block.AttributeValues("id", elemList);
 
 	// read element data
-	++tag;
+	const int M = FEElement::MAX_NODES;
+	vector<int> en(elems*M);
+	if (elems > 0) block.Values(&en[0], M);
 	for (int i = 0; i<elems; ++i)
 	{
 		FEBModel::ELEMENT& el = dom->GetElement(i);
-
-		// get the element ID
-		tag.AttributeValue("id", el.id);
-		elemList[i] = el.id;
-
-		// read the element data
-		tag.value(el.node, FEElement::MAX_NODES);
-
-		// go to next tag
-		++tag;
+		el.id = elemList[i];
+		for (int j = 0; j<M; ++j) el.node[j] = en[i*M + j];
 	}
 
 	// set the element list
@@ -68,6 +68,17 @@ FEBioFileSection::FEBioFileSection(FEBioImport* feb) : FEFileSection(feb) {}
 
 FEBioImport* FEBioFileSection::GetFEBioImport() { return static_cast<FEBioImport*>(GetFileReader()); }
 
+std::string FEBioFileSection::GetReferencedFilePath(XMLTag& tag)
+{
+	const char* szfile = tag.szvalue();
+	if ((strchr(szfile, '/') == 0) && (strchr(szfile, '\\') == 0))
+	{
+		// pre-pend the name with the input path
+		return std::string(GetFileReader()->GetFilePath()) + szfile;
+	}
+	return szfile;
+}
+
 //-----------------------------------------------------------------------------
 FEBioImport::InvalidVersion::InvalidVersion()
 {
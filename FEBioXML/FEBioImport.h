@@ -50,6 +50,10 @@ public:
 	FEBioFileSection(FEBioImport* feb);
 
 	FEBioImport* GetFEBioImport();
+
+	// returns the path of a file that is referenced by the tag's value.
+	// Relative names are taken relative to the input file.
+	std::string GetReferencedFilePath(XMLTag& tag);
 };
 
 //=============================================================================
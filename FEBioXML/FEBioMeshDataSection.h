@@ -83,6 +83,7 @@ protected:
 	void ParseNodalData(XMLTag& tag);
 	void ParseSurfaceData(XMLTag& tag);
 	void ParseElementData(XMLTag& tag);
+	void ParseIncludeData(XMLTag& tag);
 
 protected:
 //	void ParseModelParameter(XMLTag& tag, FEParamValue param);
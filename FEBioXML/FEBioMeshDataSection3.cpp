@@ -38,6 +38,8 @@ SOFTWARE.*/
 #include <FECore/FEDomainMap.h>
 #include <FECore/FESurfaceLoad.h>
 #include <FECore/FEBodyLoad.h>
+#include "FEBinaryMeshFile.h"
+#include "XMLBlockReader.h"
 #include <FECore/FEPrescribedDOF.h>
 #include <FECore/FEMaterialPointProperty.h>
 #include <FECore/FEConstDataGenerator.h>
@@ -76,12 +78,28 @@ void FEBioMeshDataSection3::Parse(XMLTag& tag)
 		if      (tag == "NodeData"   ) ParseNodalData  (tag);
 		else if (tag == "SurfaceData") ParseSurfaceData(tag);
 		else if (tag == "ElementData") ParseElementData(tag);
+		else if (tag == "Include"    ) ParseIncludeData(tag);
 		else throw XMLReader::InvalidTag(tag);
 		++tag;
 	}
 	while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+//! Reads the data maps of a binary mesh file (see FEBinaryMeshFile).
+//! The sets that the maps are defined on must already exist in the mesh.
+void FEBioMeshDataSection3::ParseIncludeData(XMLTag& tag)
+{
+	FEModel& fem = *GetFEModel();
+	FEMesh& mesh = fem.GetMesh();
+
+	std::string fileName = GetReferencedFilePath(tag);
+
+	FEBinaryMeshFile file;
+	if ((file.Open(fileName.c_str()) == false) || (file.ReadDataMaps(mesh) == false))
+		throw XMLReader::Error(tag, "Failed reading binary mesh file " + fileName + ": " + file.GetErrorString());
+}
+
 //-----------------------------------------------------------------------------
 void FEBioMeshDataSection3::ParseNodalData(XMLTag& tag)
 {
@@ -992,25 +1010,35 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEDomainMap& map)
 	FEDataType dataType = map.DataType();
 	int dataSize = map.DataSize();
 	int m = map.MaxNodes();
-	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
 	// TODO: For vec3d values, I sometimes need to normalize the vectors (e.g. for fibers). How can I do this?
 
-	int ncount = 0;
-	++tag;
-	do
+	// read all values at once
+	XMLBlockReader block;
+	block.Read(tag);
+	int ncount = block.Elements();
+
+	vector<int> lid;
+	block.AttributeValues("lid", lid);
+
+	const int nmax = m*dataSize;
+	vector<double> values(ncount*nmax);
+	vector<int> count(ncount);
+	if (ncount > 0) block.Values(&values[0], nmax, &count[0]);
+
+	for (int l = 0; l < ncount; ++l)
 	{
 		// get the local element number
-		const char* szlid = tag.AttributeValue("lid");
-		int n = atoi(szlid) - 1;
+		int n = lid[l] - 1;
 
 		// make sure the number is valid
-		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
+		if ((n < 0) || (n >= nelems)) block.Error(l, "invalid value for attribute \"lid\"");
 
-		int nread = tag.value(data, m*dataSize);
+		const double* data = &values[l*nmax];
+		int nread = count[l];
 		if (nread == dataSize)
 		{
-			double* v = data;
+			const double* v = data;
 			switch (dataType)
 			{
 			case FE_DOUBLE:	map.setValue(n, v[0]); break;
@@ -1023,7 +1051,7 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEDomainMap& map)
 		}
 		else if (nread == m*dataSize)
 		{
-			double* v = data;
+			const double* v = data;
 			for (int i = 0; i < m; ++i, v += dataSize)
 			{
 				switch (dataType)
@@ -1036,12 +1064,8 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEDomainMap& map)
 				}
 			}
 		}
-		else throw XMLReader::InvalidValue(tag);
-		++tag;
-
-		ncount++;
+		else block.Error(l, "invalid value");
 	}
-	while (!tag.isend());
 
 	if (ncount != nelems) throw FEBioImport::MeshDataError();
 }
@@ -1058,19 +1082,28 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEElementSet& set, vec
 	values.resize(nelems);
 	for (int i=0; i<nelems; ++i) values[i].nval = 0;
 
-	++tag;
-	do
+	// read all values at once
+	XMLBlockReader block;
+	block.Read(tag);
+	int N = block.Elements();
+
+	vector<int> lid;
+	block.AttributeValues("lid", lid);
+
+	vector<double> val(N*nvalues);
+	vector<int> count(N);
+	if (N > 0) block.Values(&val[0], nvalues, &count[0]);
+
+	for (int i=0; i<N; ++i)
 	{
 		// get the local element number
-		const char* szlid = tag.AttributeValue("lid");
-		int n = atoi(szlid)-1;
+		int n = lid[i]-1;
 
 		// make sure the number is valid
-		if ((n<0) || (n>=nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
+		if ((n<0) || (n>=nelems)) block.Error(i, "invalid value for attribute \"lid\"");
 
 		ELEMENT_DATA& data = values[n];
-		data.nval = tag.value(data.val, nvalues);
-		++tag;
+		data.nval = count[i];
+		for (int j=0; j<count[i]; ++j) data.val[j] = val[i*nvalues + j];
 	}
-	while (!tag.isend());
 }
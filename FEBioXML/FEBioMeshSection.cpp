@@ -36,6 +36,8 @@ SOFTWARE.*/
 #include <FEBioMech/FEElasticMaterial.h>
 #include <FECore/FECoreKernel.h>
 #include <FECore/FENodeNodeList.h>
+#include "FEBinaryMeshFile.h"
+#include "XMLBlockReader.h"
 
 //-----------------------------------------------------------------------------
 FEBioMeshSection::FEBioMeshSection(FEBioImport* pim) : FEBioFileSection(pim) {}
@@ -65,12 +67,25 @@ void FEBioMeshSection::Parse(XMLTag& tag)
 		else if (tag == "ElementSet" ) ParseElementSetSection (tag, part);
 		else if (tag == "SurfacePair") ParseSurfacePairSection(tag, part);
 		else if (tag == "DiscreteSet") ParseDiscreteSetSection(tag, part);
+		else if (tag == "Include"    ) ParseIncludeSection    (tag, part);
 		else throw XMLReader::InvalidTag(tag);
 		++tag;
 	}
 	while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+//! Reads the nodes, domains and sets of a binary mesh file (see FEBinaryMeshFile).
+//! The file name is relative to the input file.
+void FEBioMeshSection::ParseIncludeSection(XMLTag& tag, FEBModel::Part* part)
+{
+	std::string fileName = GetReferencedFilePath(tag);
+
+	FEBinaryMeshFile file;
+	if ((file.Open(fileName.c_str()) == false) || (file.ReadPart(*GetBuilder(), *part) == false))
+		throw XMLReader::Error(tag, "Failed reading binary mesh file " + fileName + ": " + file.GetErrorString());
+}
+
 //-----------------------------------------------------------------------------
 //! Reads the Nodes section of the FEBio input file
 void FEBioMeshSection::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
@@ -88,28 +103,29 @@ void FEBioMeshSection::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
 		part->AddNodeSet(ps);
 	}
 
-	// allocate node
+	// read all nodes at once
+	XMLBlockReader block;
+	block.Read(tag);
+	int nodes = block.Elements();
 
-	vector<FEBModel::NODE> node; node.reserve(10000);
-	vector<int> nodeList; nodeList.reserve(10000);
+	// get the nodal IDs
+	vector<int> nodeList;
+	block.AttributeValues("id", nodeList);
 
-	// read nodal coordinates
-	++tag;
-	do {
-		// nodal coordinates
-		FEBModel::NODE nd;
-		value(tag, nd.r);
+	// get the nodal coordinates
+	vector<double> r(3*nodes);
+	vector<int> count(nodes);
+	if (nodes > 0) block.Values(&r[0], 3, &count[0]);
 
-		// get the nodal ID
-		tag.AttributeValue("id", nd.id);
-
-		// add it to the pile
-		node.push_back(nd);
-		nodeList.push_back(nd.id);
+	vector<FEBModel::NODE> node(nodes);
+	for (int i=0; i<nodes; ++i)
+	{
+		if (count[i] != 3) throw XMLReader::XMLSyntaxError(block.LineNumber(i));
 
-		// go on to the next node
-		++tag;
-	} while (!tag.isend());
+		FEBModel::NODE& nd = node[i];
+		nd.id = nodeList[i];
+		nd.r = vec3d(r[3*i], r[3*i+1], r[3*i+2]);
+	}
 
 	// add nodes to the part
 	part->AddNodes(node);
@@ -152,27 +168,27 @@ void FEBioMeshSection::ParseElementSection(XMLTag& tag, FEBModel::Part* part)
 		part->AddElementSet(pg);
 	}
 
-	dom->Reserve(10000);
-	vector<int> elemList; elemList.reserve(10000);
+	// read all elements at once
+	XMLBlockReader block;
+	block.Read(tag);
+	int elems = block.Elements();
 
-	// read element data
-	++tag;
-	do
-	{
-		FEBModel::ELEMENT el;
-
-		// get the element ID
-		tag.AttributeValue("id", el.id);
-
-		// read the element data
-		tag.value(el.node, FEElement::MAX_NODES);
+	// get the element IDs
+	vector<int> elemList;
+	block.AttributeValues("id", elemList);
 
-		dom->AddElement(el);
-		elemList.push_back(el.id);
+	// read the element data
+	const int M = FEElement::MAX_NODES;
+	vector<int> en(elems*M);
+	if (elems > 0) block.Values(&en[0], M);
 
-		// go to next tag
-		++tag;
-	} while (!tag.isend());
+	dom->Create(elems);
+	for (int i=0; i<elems; ++i)
+	{
+		FEBModel::ELEMENT& el = dom->GetElement(i);
+		el.id = elemList[i];
+		for (int j=0; j<M; ++j) el.node[j] = en[i*M + j];
+	}
 
 	// set the element list
 	if (pg) pg->SetElementList(elemList);
@@ -48,6 +48,7 @@ protected:
 	void ParseEdgeSection       (XMLTag& tag, FEBModel::Part* part);
 	void ParseSurfacePairSection(XMLTag& tag, FEBModel::Part* part);
 	void ParseDiscreteSetSection(XMLTag& tag, FEBModel::Part* part);
+	void ParseIncludeSection    (XMLTag& tag, FEBModel::Part* part);
 };
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,296 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "XMLBlockReader.h"
+#include <stdint.h>
+#include <stdarg.h>
+
+//-----------------------------------------------------------------------------
+// defined in XMLReader.cpp
+string format_string(const char* sz, ...);
+
+//-----------------------------------------------------------------------------
+// Converts a number in the range [sz, end). This returns the same as atof, but 
+// numbers that can be represented exactly (which is nearly always the case for
+// mesh data) are converted without the overhead of strtod. 
+static double fast_atof(const char* sz, const char* end)
+{
+	// powers of ten that are exactly representable
+	static const double p10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const char* p = sz;
+	while ((p < end) && isspace((unsigned char)*p)) ++p;
+
+	bool neg = false;
+	if ((p < end) && ((*p == '-') || (*p == '+'))) { neg = (*p == '-'); ++p; }
+
+	// read the mantissa
+	uint64_t m = 0;
+	int nd = 0, e10 = 0;
+	while ((p < end) && (*p >= '0') && (*p <= '9')) { m = 10*m + (*p - '0'); ++nd; ++p; }
+	if ((p < end) && (*p == '.'))
+	{
+		++p;
+		while ((p < end) && (*p >= '0') && (*p <= '9')) { m = 10*m + (*p - '0'); ++nd; --e10; ++p; }
+	}
+
+	// Anything else (inf, nan, invalid input, ...) is handled by strtod.
+	// Note that the text is always terminated by a '<' or a null character.
+	if ((nd == 0) || (nd > 19)) return strtod(sz, nullptr);
+
+	// read the exponent
+	if ((p < end) && ((*p == 'e') || (*p == 'E')))
+	{
+		++p;
+		bool eneg = false;
+		if ((p < end) && ((*p == '-') || (*p == '+'))) { eneg = (*p == '-'); ++p; }
+		if ((p >= end) || (*p < '0') || (*p > '9')) return strtod(sz, nullptr);
+		int e = 0;
+		while ((p < end) && (*p >= '0') && (*p <= '9')) { if (e < 10000) e = 10*e + (*p - '0'); ++p; }
+		e10 += (eneg ? -e : e);
+	}
+
+	// The result is correctly rounded if both the mantissa and the power
+	// of ten are exact doubles. Otherwise, we leave it to strtod.
+	if ((m > ((uint64_t)1 << 53)) || (e10 < -22) || (e10 > 22)) return strtod(sz, nullptr);
+
+	double d = (double) m;
+	d = (e10 < 0 ? d / p10[-e10] : d * p10[e10]);
+	return (neg ? -d : d);
+}
+
+//-----------------------------------------------------------------------------
+// Converts an integer in the range [sz, end) (as atoi)
+static int fast_atoi(const char* sz, const char* end)
+{
+	const char* p = sz;
+	while ((p < end) && isspace((unsigned char)*p)) ++p;
+
+	bool neg = false;
+	if ((p < end) && ((*p == '-') || (*p == '+'))) { neg = (*p == '-'); ++p; }
+
+	int n = 0;
+	while ((p < end) && (*p >= '0') && (*p <= '9')) { n = 10*n + (*p - '0'); ++p; }
+	return (neg ? -n : n);
+}
+
+//-----------------------------------------------------------------------------
+static inline double convert(const char* sz, const char* end, double*) { return fast_atof(sz, end); }
+static inline int    convert(const char* sz, const char* end, int*   ) { return fast_atoi(sz, end); }
+
+//-----------------------------------------------------------------------------
+// reads a comma separated list of at most n values
+template <typename T> static int read_list(const char* sz, const char* end, T* v, int n)
+{
+	int nr = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		v[i] = convert(sz, end, v);
+		nr++;
+
+		const char* sze = (const char*) memchr(sz, ',', end - sz);
+		if (sze) sz = sze + 1;
+		else break;
+	}
+	return nr;
+}
+
+//=============================================================================
+XMLBlockReader::XMLBlockReader()
+{
+	m_line = 0;
+}
+
+//-----------------------------------------------------------------------------
+void XMLBlockReader::Read(XMLTag& tag)
+{
+	m_rec.clear();
+	m_line = tag.m_ncurrent_line;
+
+	// read the text of the block
+	tag.m_preader->ReadChildText(tag, m_buf);
+	if (m_buf.empty()) return;
+
+	// Find the start tags of all child elements. 
+	// This only looks at the tag delimiters, so it is a quick scan over the data. 
+	const char* pb = &m_buf[0];
+	const char* pe = pb + m_buf.size() - 1;
+	const char* p = pb;
+	while ((p = (const char*) memchr(p, '<', pe - p)))
+	{
+		if (p + 1 >= pe) throw XMLReader::XMLSyntaxError(LineNumber((int)m_rec.size()));
+		char ch = p[1];
+		if (ch == '!')
+		{
+			// skip comment
+			const char* pc = p + 2;
+			while ((pc = (const char*) memchr(pc, '>', pe - pc)) && (strncmp(pc - 2, "--", 2) != 0)) ++pc;
+			if (pc == nullptr) throw XMLReader::XMLSyntaxError(m_line);
+			p = pc + 1;
+		}
+		else if (ch == '/')
+		{
+			// end tag of the last child
+			p += 2;
+		}
+		else
+		{
+			// start tag of a new child element; find the end of the start tag
+			RECORD r;
+			r.start = p - pb;
+			const char* pc = p + 1;
+			char quot = 0;
+			while ((pc < pe) && ((*pc != '>') || quot))
+			{
+				if (quot) { if (*pc == quot) quot = 0; }
+				else if ((*pc == '"') || (*pc == '\'')) quot = *pc;
+				++pc;
+			}
+			if (pc >= pe) throw XMLReader::XMLSyntaxError(LineNumber((int)m_rec.size()));
+
+			// the value runs until the next tag
+			r.vbeg = pc + 1 - pb;
+			if (pc[-1] == '/') r.vend = r.vbeg;
+			else
+			{
+				const char* pv = (const char*) memchr(pc, '<', pe - pc);
+				r.vend = (pv ? pv - pb : pe - pb);
+			}
+			m_rec.push_back(r);
+
+			p = pb + r.vend;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+int XMLBlockReader::LineNumber(int n) const
+{
+	size_t pos = (n < (int) m_rec.size() ? m_rec[n].start : m_buf.size());
+	int line = m_line;
+	for (size_t i = 0; i < pos; ++i) if (m_buf[i] == '\n') line++;
+	return line;
+}
+
+//-----------------------------------------------------------------------------
+void XMLBlockReader::Error(int n, const std::string& err) const
+{
+	// get the name of the child element
+	std::string name;
+	if (n < (int) m_rec.size())
+	{
+		const char* p = &m_buf[0] + m_rec[n].start + 1;
+		while (*p && !isspace((unsigned char)*p) && (*p != '>') && (*p != '/')) name.push_back(*p++);
+	}
+
+	throw XMLReader::Error(format_string("tag \"%s\" (line %d) : ", name.c_str(), LineNumber(n)) + err);
+}
+
+//-----------------------------------------------------------------------------
+void XMLBlockReader::AttributeValues(const char* szatt, std::vector<int>& val)
+{
+	int N = Elements();
+	val.resize(N);
+
+	const size_t L = strlen(szatt);
+	int nerr = -1;
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i)
+	{
+		const RECORD& r = m_rec[i];
+		const char* pb = &m_buf[0] + r.start;
+		const char* pe = &m_buf[0] + r.vbeg;
+
+		// skip the tag name
+		const char* p = pb + 1;
+		while ((p < pe) && !isspace((unsigned char)*p) && (*p != '>') && (*p != '/')) ++p;
+
+		// find the attribute
+		bool bfound = false;
+		while ((p < pe) && !bfound)
+		{
+			while ((p < pe) && isspace((unsigned char)*p)) ++p;
+			const char* pn = p;
+			while ((p < pe) && (*p != '=') && !isspace((unsigned char)*p) && (*p != '>')) ++p;
+			size_t ln = p - pn;
+			while ((p < pe) && (*p != '"') && (*p != '\'') && (*p != '>')) ++p;
+			if ((p >= pe) || (*p == '>')) break;
+
+			char quot = *p++;
+			const char* pv = p;
+			while ((p < pe) && (*p != quot)) ++p;
+			if ((ln == L) && (strncmp(pn, szatt, L) == 0))
+			{
+				val[i] = fast_atoi(pv, p);
+				bfound = true;
+			}
+			++p;
+		}
+
+		if (bfound == false)
+		{
+#pragma omp critical (xml_block_error)
+			if ((nerr < 0) || (i < nerr)) nerr = i;
+		}
+	}
+
+	if (nerr >= 0) Error(nerr, format_string("missing attribute \"%s\"", szatt));
+}
+
+//-----------------------------------------------------------------------------
+void XMLBlockReader::Values(double* data, int stride, int* count)
+{
+	int N = Elements();
+	const char* buf = (m_buf.empty() ? nullptr : &m_buf[0]);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i)
+	{
+		const RECORD& r = m_rec[i];
+		int n = read_list(buf + r.vbeg, buf + r.vend, data + (size_t)i*stride, stride);
+		if (count) count[i] = n;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void XMLBlockReader::Values(int* data, int stride, int* count)
+{
+	int N = Elements();
+	const char* buf = (m_buf.empty() ? nullptr : &m_buf[0]);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i)
+	{
+		const RECORD& r = m_rec[i];
+		int n = read_list(buf + r.vbeg, buf + r.vend, data + (size_t)i*stride, stride);
+		if (count) count[i] = n;
+	}
+}
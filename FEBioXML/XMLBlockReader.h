@@ -0,0 +1,77 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "XMLReader.h"
+
+//-----------------------------------------------------------------------------
+//! This class reads the child elements of a (large) xml element in bulk. It is
+//! used for sections like Nodes and Elements, which can contain millions of leaf 
+//! elements of the form <name att="...">v1,v2,...</name>. 
+//! Instead of reading these one tag at a time, the text of the entire block is read 
+//! at once, the child elements are located with a pre-scan, and then the attributes
+//! and values of all child elements are converted in parallel.
+class FEBIOXML_API XMLBlockReader
+{
+	struct RECORD
+	{
+		size_t	start;	// offset of the start tag
+		size_t	vbeg;	// offset of the start of the value
+		size_t	vend;	// offset of the end of the value
+	};
+
+public:
+	XMLBlockReader();
+
+	//! Read all child elements of the tag. 
+	//! On return, the tag is positioned at its end tag.
+	void Read(XMLTag& tag);
+
+	//! number of child elements that were read
+	int Elements() const { return (int) m_rec.size(); }
+
+	//! Get the (integer) value of an attribute of all child elements
+	void AttributeValues(const char* szatt, std::vector<int>& val);
+
+	//! Get the values of all child elements. The values are comma separated lists 
+	//! of which at most stride values are read (as XMLTag::value). The values of
+	//! child element i are stored at data[i*stride], and the number of values that
+	//! were read are returned in count (if not null).
+	void Values(double* data, int stride, int* count = nullptr);
+	void Values(int* data, int stride, int* count = nullptr);
+
+	//! Get the line number of a child element (for error reporting)
+	int LineNumber(int n) const;
+
+	//! throw an error for a child element
+	void Error(int n, const std::string& err) const;
+
+private:
+	std::vector<char>	m_buf;		//!< text of the child elements
+	std::vector<RECORD>	m_rec;		//!< location of the child elements in the text
+	int					m_line;		//!< line number of the start of the text
+};
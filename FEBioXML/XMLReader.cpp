@@ -949,3 +949,66 @@ void XMLReader::SkipTag(XMLTag& tag)
 
 	++tag;
 }
+
+//-----------------------------------------------------------------------------
+//! Read the raw text of all child elements of a tag. The text is read directly from
+//! the file, up to (but not including) the end tag, which is then read as the next tag.
+//! Note that no entity references are resolved and comments are not removed.
+void XMLReader::ReadChildText(XMLTag& tag, std::vector<char>& buf)
+{
+	assert(tag.m_preader == this);
+
+	buf.clear();
+	if (tag.isleaf() || tag.isend()) return;
+
+	// this is what we're looking for
+	std::string endTag = std::string("</") + tag.m_sztag;
+	const size_t L = endTag.size();
+
+	// read the file in large chunks until we find the end tag
+	const size_t CHUNK_SIZE = 1 << 22;
+	fseek(m_fp, tag.m_fpos, SEEK_SET);
+	size_t nsearch = 0;
+	size_t nend = 0;
+	bool bfound = false;
+	while (bfound == false)
+	{
+		size_t n0 = buf.size();
+		buf.resize(n0 + CHUNK_SIZE);
+		size_t nread = fread(&buf[n0], 1, CHUNK_SIZE, m_fp);
+		buf.resize(n0 + nread);
+		if (nread == 0) throw UnexpectedEOF();
+
+		const char* pb = &buf[0];
+		const char* pe = pb + buf.size();
+		const char* p = pb + nsearch;
+		while ((p = (const char*) memchr(p, '<', pe - p)))
+		{
+			// we need one more character to see where the tag name ends
+			if ((size_t)(pe - p) <= L) break;
+			if ((strncmp(p, endTag.c_str(), L) == 0) && ((p[L] == '>') || isspace(p[L])))
+			{
+				bfound = true;
+				nend = p - pb;
+				break;
+			}
+			++p;
+		}
+		nsearch = (p ? p - pb : buf.size());
+	}
+
+	// update the line count
+	int nlines = 0;
+	for (size_t i = 0; i < nend; ++i) if (buf[i] == '\n') nlines++;
+
+	buf.resize(nend);
+	buf.push_back(0);
+
+	// position the tag at the end tag and read it
+	tag.m_fpos += nend;
+	tag.m_ncurrent_line += nlines;
+	m_currentPos = -1;
+	m_bufSize = m_bufIndex = 0;
+	m_eof = false;
+	NextTag(tag);
+}
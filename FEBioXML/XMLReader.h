@@ -244,6 +244,10 @@ public:
 	//! Skip a tag
 	void SkipTag(XMLTag& tag);
 
+	//! Read the raw text of all child elements of a tag and move the tag to its end tag
+	//! (see XMLBlockReader)
+	void ReadChildText(XMLTag& tag, std::vector<char>& buf);
+
 protected: // helper functions
 
 	//! Get the next character in the file
@@ -72,6 +72,10 @@ void CompactMatrix::Clear()
 	m_pindices = 0;
 	m_ppointers = 0;
 
+	m_rowPointers.clear();
+	m_rowColumns.clear();
+	m_rowValues.clear();
+
 	SparseMatrix::Clear();
 }
 
@@ -128,3 +132,47 @@ int CompactMatrix::bandWidth()
 
 	return kmax;
 }
+
+//-----------------------------------------------------------------------------
+void CompactMatrix::buildRowIndex(bool skipDiagonal)
+{
+	assert(isRowBased() == false);
+	int NR = Rows();
+	int NC = Columns();
+
+	// count the entries in each row
+	m_rowPointers.assign(NR + 1, 0);
+	for (int j = 0; j < NC; ++j)
+	{
+		int* pi = m_pindices + (m_ppointers[j] - m_offset);
+		int n = m_ppointers[j + 1] - m_ppointers[j];
+		for (int k = 0; k < n; ++k)
+		{
+			int i = pi[k] - m_offset;
+			if ((skipDiagonal == false) || (i != j)) m_rowPointers[i + 1]++;
+		}
+	}
+	for (int i = 0; i < NR; ++i) m_rowPointers[i + 1] += m_rowPointers[i];
+
+	// fill the index
+	// Since we loop over the columns in order, the columns of each row will be sorted.
+	int nnz = m_rowPointers[NR];
+	m_rowColumns.resize(nnz);
+	m_rowValues.resize(nnz);
+	vector<int> pos(m_rowPointers.begin(), m_rowPointers.end() - 1);
+	for (int j = 0; j < NC; ++j)
+	{
+		int n0 = m_ppointers[j] - m_offset;
+		int n = m_ppointers[j + 1] - m_ppointers[j];
+		for (int k = 0; k < n; ++k)
+		{
+			int i = m_pindices[n0 + k] - m_offset;
+			if ((skipDiagonal == false) || (i != j))
+			{
+				int m = pos[i]++;
+				m_rowColumns[m] = j;
+				m_rowValues[m] = n0 + k;
+			}
+		}
+	}
+}
@@ -83,6 +83,12 @@ public:
 	//! calculate bandwidth of matrix
 	int bandWidth();
 
+protected:
+	//! Build a row-wise index of a column-based matrix. This allows column-based
+	//! formats to compute matrix-vector products in parallel without write conflicts.
+	//! The index is released when the matrix structure changes.
+	void buildRowIndex(bool skipDiagonal);
+
 protected:
 	double*	m_pd;			//!< matrix values
 	int*	m_pindices;		//!< indices
@@ -92,4 +98,9 @@ protected:
 
 protected:
 	std::vector<int>	P;
+
+	// row-wise index (see buildRowIndex)
+	std::vector<int>	m_rowPointers;	//!< start of each row in the row index
+	std::vector<int>	m_rowColumns;	//!< (zero-based) column indices
+	std::vector<int>	m_rowValues;	//!< (zero-based) locations of the values in m_pd
 };
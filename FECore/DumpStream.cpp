@@ -34,6 +34,7 @@ DumpStream::DumpStream(FEModel& fem) : m_fem(fem)
 {
 	m_bsave = false;
 	m_bshallow = false;
+	m_bnoElemData = false;
 	m_bytes_serialized = 0;
 	m_ptr_lock = false;
 }
@@ -50,10 +51,19 @@ bool DumpStream::IsLoading() const { return !m_bsave; }
 //! See if shallow flag is set
 bool DumpStream::IsShallow() const { return m_bshallow; }
 
+//-----------------------------------------------------------------------------
+//! Exclude the element state data from shallow archives
+void DumpStream::ExcludeElementData(bool b) { m_bnoElemData = b; }
+
+//-----------------------------------------------------------------------------
+//! See if the element state data is excluded
+bool DumpStream::IsElementDataExcluded() const { return m_bnoElemData; }
+
 //-----------------------------------------------------------------------------
 DumpStream::~DumpStream()
 {
 	m_ptr.clear();
+	m_ptrId.clear();
 	m_bytes_serialized = 0;
 }
 
@@ -67,8 +77,9 @@ void DumpStream::Open(bool bsave, bool bshallow)
 
 	// add the "null" pointer
 	m_ptr.clear();
-	Pointer p = { 0, 0 };
-	m_ptr.push_back(p);
+	m_ptrId.clear();
+	m_ptr.push_back(nullptr);
+	if (m_bsave) m_ptrId[nullptr] = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -197,21 +208,14 @@ DumpStream& DumpStream::operator >> (double a[3][3])
 //-----------------------------------------------------------------------------
 int DumpStream::FindPointer(void* p)
 {
-	for (int i = 0; i < (int)m_ptr.size(); ++i)
-	{
-		if (m_ptr[i].pd == p) return i;
-	}
-	return -1;
+	std::unordered_map<void*, int>::iterator it = m_ptrId.find(p);
+	return (it != m_ptrId.end() ? it->second : -1);
 }
 
 //-----------------------------------------------------------------------------
 int DumpStream::FindPointer(int id)
 {
-	for (int i = 0; i < (int)m_ptr.size(); ++i)
-	{
-		if (m_ptr[i].id == id) return i;
-	}
-	return -1;
+	return ((id >= 0) && (id < (int)m_ptr.size()) ? id : -1);
 }
 
 //-----------------------------------------------------------------------------
@@ -219,11 +223,16 @@ void DumpStream::AddPointer(void* p)
 {
 	if (m_ptr_lock) return;
 	if (p == nullptr) { assert(false); return;	}
-	assert(FindPointer(p) == -1);
-	Pointer ptr;
-	ptr.pd = p;
-	ptr.id = (int)m_ptr.size();
-	m_ptr.push_back(ptr);
+	int id = (int)m_ptr.size();
+	m_ptr.push_back(p);
+
+	// the id of a pointer is only needed when saving
+	// (If the same address is added twice, the first id is kept.)
+	if (m_bsave)
+	{
+		assert(m_ptrId.find(p) == m_ptrId.end());
+		m_ptrId.insert(std::make_pair(p, id));
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <string.h>
 #include "vec3d.h"
 #include "mat3d.h"
@@ -49,11 +50,6 @@ class matrix;
 //! to implement the actual storage mechanism.
 class FECORE_API DumpStream
 {
-	struct Pointer {
-		void*			pd;
-		unsigned int	id;
-	};
-
 public:
 	// This class is thrown when an error occurs reading the dumpfile
 	class ReadError{};
@@ -74,6 +70,13 @@ public:
 	//! See if shallow flag is set
 	bool IsShallow() const;
 
+	//! Exclude the element state data (incl. material points) from shallow archives.
+	//! This is used when this data is stored separately (see FEModelSnapshot).
+	void ExcludeElementData(bool b);
+
+	//! See if the element state data is excluded
+	bool IsElementDataExcluded() const;
+
 	// open the stream
 	virtual void Open(bool bsave, bool bshallow);
 
@@ -140,12 +143,16 @@ private:
 private:
 	bool		m_bsave;	//!< true if output stream, false for input stream
 	bool		m_bshallow;	//!< if true only shallow data needs to be serialized
+	bool		m_bnoElemData;	//!< if true, element data is not serialized in shallow archives
 	FEModel&	m_fem;		//!< the FE Model that is being serialized
 
 	size_t	m_bytes_serialized;	//!< number or bytes serialized
 
-	bool					m_ptr_lock;
-	std::vector<Pointer>	m_ptr;
+	// The pointer table. Each pointer that is serialized is assigned an id, which is its
+	// index in m_ptr. When saving, m_ptrId is used to find the id of a pointer.
+	bool							m_ptr_lock;
+	std::vector<void*>				m_ptr;		//!< id to pointer table
+	std::unordered_map<void*, int>	m_ptrId;	//!< pointer to id table (only used when saving)
 };
 
 template <typename T> DumpStream& DumpStream::write_raw(const T& o)
@@ -296,13 +303,13 @@ template <typename A, typename B> DumpStream& DumpStream::operator >> (std::map<
 
 template <typename T, std::size_t N> DumpStream& DumpStream::operator << (T(&a)[N])
 {
-	for (int i = 0; i < N; ++i) (*this) << a[i];
+	for (std::size_t i = 0; i < N; ++i) (*this) << a[i];
 	return *this;
 }
 
 template <typename T, std::size_t N> DumpStream& DumpStream::operator >> (T(&a)[N])
 {
-	for (int i = 0; i < N; ++i) (*this) >> a[i];
+	for (std::size_t i = 0; i < N; ++i) (*this) >> a[i];
 	return *this;
 }
 
@@ -352,7 +359,8 @@ template <typename T> DumpStream& DumpStream::operator >> (T* &a)
 	ar >> pid;
 	if (pid != -1)
 	{
-		a = (T*)(m_ptr[pid].pd);
+		if ((pid < 0) || (pid >= (int)m_ptr.size())) throw ReadError();
+		a = (T*)(m_ptr[pid]);
 		return ar;
 	}
 
@@ -34,7 +34,7 @@ SOFTWARE.*/
 #include "DOFS.h"
 #include "MatrixProfile.h"
 #include "FEBoundaryCondition.h"
-#include "DumpMemStream.h"
+#include "FEModelSnapshot.h"
 #include "FELinearConstraintManager.h"
 #include "FEShellDomain.h"
 #include "FEMeshAdaptor.h"
@@ -61,6 +61,7 @@ END_FECORE_CLASS()
 FEAnalysis::FEAnalysis(FEModel* fem) : FECoreBase(fem)
 {
 	m_psolver = nullptr;
+	m_bremesh = false;
 	m_tend = 0.0;
 
 	m_timeController = nullptr;
@@ -369,8 +370,8 @@ bool FEAnalysis::Solve()
 		if (m_timeController) m_timeController->AutoTimeStep(0);
 	}
 
-	// dump stream for running restarts
-	DumpMemStream dmp(fem);
+	// snapshot of the model state for running restarts
+	FEModelSnapshot snapshot(fem);
 
 	// repeat for all timesteps
 	if (m_timeController) m_timeController->m_nretries = 0;
@@ -380,8 +381,7 @@ bool FEAnalysis::Solve()
 		// we need to retry this time step
 		if (m_timeController && (m_timeController->m_maxretries > 0))
 		{ 
-			dmp.clear();
-			fem.Serialize(dmp); 
+			snapshot.Save();
 		}
 
 		// Inform that the time is about to change. (Plugins can use 
@@ -407,6 +407,9 @@ bool FEAnalysis::Solve()
 		// Solve the time step
 		int ierr = SolveTimeStep();
 
+		// the snapshot cannot reuse any of its data when the mesh was changed
+		if (m_bremesh) snapshot.Invalidate();
+
 		// see if we want to abort
 		if (ierr == 2) 
 		{
@@ -463,8 +466,7 @@ bool FEAnalysis::Solve()
 			if (m_timeController && (m_timeController->m_nretries < m_timeController->m_maxretries))
 			{
 				// restore the previous state
-				dmp.Open(false, true);
-				fem.Serialize(dmp);
+				snapshot.Restore();
 				
 				// let's try again
 				m_timeController->Retry();
@@ -495,6 +497,7 @@ bool FEAnalysis::Solve()
 int FEAnalysis::SolveTimeStep()
 {
 	int nerr = 0;
+	m_bremesh = false;
 	try
 	{
 		// solve this timestep,
@@ -513,25 +516,38 @@ int FEAnalysis::SolveTimeStep()
 				{
 					fem.GetTime().augmentation = niter;
 					feLog("\n=== Applying mesh adaptors: iteration %d\n", niter + 1);
+
+					// collect the changes of all mesh adaptors
+					FEMeshChangeSet changes;
+					changes.SetLocal();
 					for (int i = 0; i < fem.MeshAdaptors(); ++i)
 					{
 						FEMeshAdaptor* meshAdaptor = fem.MeshAdaptor(i);
 						feLog("*mesh adaptor %d (%s):\n", i + 1, meshAdaptor->GetTypeStr());
-						bconv = (meshAdaptor->Apply(niter) && bconv);
+						meshAdaptor->ResetChanges();
+						bool bunchanged = meshAdaptor->Apply(niter);
+						if (bunchanged == false) changes.Merge(meshAdaptor->GetChanges());
+						bconv = (bunchanged && bconv);
 						feLog("\n");
 					}
 					niter++;
 
 					if (bconv == false)
 					{
-						// we need to clear the FE solver and then reinitialize it again
+						// If the mesh was only changed locally, the solver may be able to
+						// update its data, otherwise we need to clear the FE solver and 
+						// then reinitialize it again
 						FESolver* solver = GetFESolver();
-						solver->Clean();
+						if (changes.IsGlobal() || (solver->Reinit(changes) == false))
+						{
+							solver->Clean();
 
-						// reinitialize it
-						InitSolver();
+							// reinitialize it
+							InitSolver();
+						}
 
 						// inform listeners that the mesh was remeshed
+						m_bremesh = true;
 						fem.DoCallback(CB_REMESH);
 					}
 					feLog("\n");
@@ -180,6 +180,7 @@ private:
 	// the FE solver
 	FESolver*	m_psolver;	//!< pointer to solver class that will solve this step.
 	bool		m_bactive;	//!< activation flag
+	bool		m_bremesh;	//!< the mesh was changed by the mesh adaptors in the last time step
 
 protected:
 	std::vector<int>				m_Dom;	//!< list of active domains for this analysis
@@ -0,0 +1,179 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEAssemblyMap.h"
+#include "FEGlobalMatrix.h"
+#include "CompactMatrix.h"
+#include "FEDomain.h"
+#include "FEMesh.h"
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+FEAssemblyMap::FEAssemblyMap()
+{
+	m_tag = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FEAssemblyMap::Clear()
+{
+	m_tag = 0;
+	m_color.clear();
+	m_off.clear();
+	m_loc.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEAssemblyMap::Update(FEGlobalMatrix& K, FEDomain& dom, UnpackLMFunc unpackLM)
+{
+	// the scatter map can only be built for compact matrices
+	CompactMatrix* pA = dynamic_cast<CompactMatrix*>(K.GetSparseMatrixPtr());
+	if (pA == nullptr) return false;
+
+	// the coloring only needs to be done once
+	int NE = dom.Elements();
+	int ncolored = 0;
+	for (int i = 0; i < Colors(); ++i) ncolored += (int)m_color[i].size();
+	if (ncolored != NE) BuildColors(dom);
+
+	// see if we need to rebuild the scatter map
+	if ((m_tag == K.ProfileTag()) && ((int)m_off.size() == NE + 1)) return true;
+
+	// allocate the scatter map
+	m_off.resize(NE + 1);
+	m_off[0] = 0;
+	vector<int> lm;
+	for (int i = 0; i < NE; ++i)
+	{
+		unpackLM(dom.ElementRef(i), lm);
+		size_t n = lm.size();
+		m_off[i + 1] = m_off[i] + n*n;
+	}
+	m_loc.resize(m_off[NE]);
+
+	int* indices = pA->Indices();
+	int* pointers = pA->Pointers();
+	const int offset = pA->Offset();
+	const bool bsymm = pA->isSymmetric();
+	const bool browBased = pA->isRowBased();
+
+	// find the location of each element matrix entry
+	#pragma omp parallel for
+	for (int iel = 0; iel < NE; ++iel)
+	{
+		vector<int> lm;
+		unpackLM(dom.ElementRef(iel), lm);
+		const int N = (int)lm.size();
+		int* loc = &m_loc[0] + m_off[iel];
+		for (int i = 0; i < N; ++i)
+		{
+			int I = lm[i];
+			for (int j = 0; j < N; ++j, ++loc)
+			{
+				int J = lm[j];
+				*loc = -1;
+				if ((I < 0) || (J < 0)) continue;
+
+				// symmetric formats only store one half of the matrix
+				if (bsymm && (browBased ? (I > J) : (I < J))) continue;
+
+				// row-based formats store the column indices per row and vice versa
+				int r = (browBased ? I : J);
+				int c = (browBased ? J : I) + offset;
+				int* p0 = indices + (pointers[r] - offset);
+				int* p1 = indices + (pointers[r + 1] - offset);
+				int* pc = std::lower_bound(p0, p1, c);
+				if ((pc != p1) && (*pc == c)) *loc = (int)(pc - indices);
+			}
+		}
+	}
+
+	m_tag = K.ProfileTag();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Greedy coloring of the elements such that elements of the same color 
+// do not share any nodes.
+void FEAssemblyMap::BuildColors(FEDomain& dom)
+{
+	m_color.clear();
+
+	int NE = dom.Elements();
+	int NN = dom.GetMesh()->Nodes();
+
+	// build the node-element table
+	vector<int> pval(NN + 1, 0);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = dom.ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) pval[el.m_node[j] + 1]++;
+	}
+	for (int i = 0; i < NN; ++i) pval[i + 1] += pval[i];
+	vector<int> nel(pval[NN]);
+	vector<int> pos(pval.begin(), pval.end() - 1);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = dom.ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) nel[pos[el.m_node[j]]++] = i;
+	}
+
+	// assign colors
+	vector<int> col(NE, -1);
+	vector<int> tag;
+	for (int i = 0; i < NE; ++i)
+	{
+		// mark the colors of all neighbors that were already assigned one
+		FEElement& el = dom.ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j)
+		{
+			int nj = el.m_node[j];
+			for (int k = pval[nj]; k < pval[nj + 1]; ++k)
+			{
+				int ck = col[nel[k]];
+				if (ck >= 0) tag[ck] = i;
+			}
+		}
+
+		// pick the first available color
+		int c = 0;
+		while ((c < (int)tag.size()) && (tag[c] == i)) ++c;
+		if (c == (int)tag.size())
+		{
+			tag.push_back(-1);
+			m_color.push_back(vector<int>());
+		}
+		col[i] = c;
+		m_color[c].push_back(i);
+	}
+}
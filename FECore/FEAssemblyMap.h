@@ -0,0 +1,81 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <functional>
+
+//-----------------------------------------------------------------------------
+class FEDomain;
+class FEElement;
+class FEGlobalMatrix;
+
+//-----------------------------------------------------------------------------
+// This class supports lock-free assembly of a domain's element matrices into a 
+// compact global matrix. For each element it stores the location of every entry
+// of the element matrix in the value array of the global matrix (the "scatter map"),
+// so that assembly becomes a simple indexed add. In addition, the elements are 
+// grouped into colors such that no two elements of the same color share a node.
+// Elements of the same color can therefore be assembled concurrently without 
+// atomics or locks.
+// The scatter map is rebuilt automatically when the matrix profile changes. 
+// The coloring only depends on the mesh connectivity and is computed once.
+class FECORE_API FEAssemblyMap
+{
+public:
+	// function that returns the equation numbers of an element's matrix
+	typedef std::function<void(FEElement& el, std::vector<int>& lm)> UnpackLMFunc;
+
+public:
+	FEAssemblyMap();
+
+	// clear all data
+	void Clear();
+
+	// Make sure the map is up-to-date with the profile of K.
+	// Returns false if the matrix format of K does not support scatter maps.
+	bool Update(FEGlobalMatrix& K, FEDomain& dom, UnpackLMFunc unpackLM);
+
+	// number of colors
+	int Colors() const { return (int)m_color.size(); }
+
+	// the (local) element indices of a color
+	const std::vector<int>& ColorElements(int n) const { return m_color[n]; }
+
+	// the scatter map of an element
+	const int* ScatterMap(int iel) const { return &m_loc[m_off[iel]]; }
+
+private:
+	void BuildColors(FEDomain& dom);
+
+private:
+	int		m_tag;		//!< profile tag of the matrix the map was built for
+	std::vector< std::vector<int> >	m_color;	//!< element lists of each color
+	std::vector<size_t>	m_off;		//!< offset of each element's map in m_loc
+	std::vector<int>	m_loc;		//!< locations in the value array (-1 if not stored)
+};
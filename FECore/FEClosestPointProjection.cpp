@@ -51,7 +51,9 @@ FEClosestPointProjection::FEClosestPointProjection(FESurface& s) : m_surf(s)
 //! Initialization of data structures
 bool FEClosestPointProjection::Init()
 {
-	// initialize the nearest neighbor search
+	// initialize the nearest neighbor search. This refits the bounding volume
+	// hierarchy of the surface to the current configuration, which both Project
+	// functions use, so this must be called before each pass of projections.
 	m_SNQ.Attach(&m_surf);
 	m_SNQ.Init();
 
@@ -300,29 +302,9 @@ FESurfaceElement* FEClosestPointProjection::Project(int n, vec3d& q, vec2d& r)
 	// get the node's position
 	vec3d x = mesh.Node(n).m_rt;
 	
-	// see if we need to initialize the NQ structure
-//	if (binit_nq) m_SNQ.Init();
-	
-	// let's find the closest node
-//	int mn = m_SNQ.Find(x);
-
-	// do it the hard way
-	int mn = -1;
-	double d0;
-	int N = m_surf.Nodes();
-	for (int i=0; i<N; ++i)
-	{
-		if (m_surf.NodeIndex(i) != n)
-		{
-			vec3d r = m_surf.Node(i).m_rt;
-			double d = (r - x)*(r - x);
-			if ((mn == -1) || (d < d0))
-			{
-				d0 = d;
-				mn = i;
-			}
-		}
-	}
+	// let's find the closest node (excluding the node itself)
+	int mn = m_surf.GetBVH().FindNearestNode(x, -1, n);
+	if (mn < 0) return 0;
 	
 	// mn is a local index, so get the global node number too
 	int m = m_surf.NodeIndex(mn);
@@ -57,6 +57,7 @@ void FEDomain::CreateMaterialPointData()
 {
 	FEMaterial* pmat = GetMaterial();
 	FEMesh* mesh = GetMesh();
+	FEMaterialPointArena::Scope scope(m_mpArena);
 	if (pmat) ForEachElement([=](FEElement& el) {
 
 		vec3d r[FEElement::MAX_NODES];
@@ -81,14 +82,7 @@ void FEDomain::Serialize(DumpStream& ar)
 
 	if (ar.IsShallow())
 	{
-		int NEL = Elements();
-		for (int i = 0; i < NEL; ++i)
-		{
-			FEElement& el = ElementRef(i);
-			el.Serialize(ar);
-			int nint = el.GaussPoints();
-			for (int j = 0; j < nint; ++j) el.GetMaterialPoint(j)->Serialize(ar);
-		}
+		if (ar.IsElementDataExcluded() == false) SerializeElementState(ar, 0, Elements());
 	}
 	else
 	{
@@ -118,6 +112,7 @@ void FEDomain::Serialize(DumpStream& ar)
 			int NEL = 0;
 			ar >> NEL;
 			Create(NEL, espec);
+			FEMaterialPointArena::Scope scope(m_mpArena);
 			for (int i = 0; i < NEL; ++i)
 			{
 				FEElement& el = ElementRef(i);
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FEMeshPartition.h"
+#include "FEMaterialPointArena.h"
 
 // forward declaration of material class
 class FEMaterial;
@@ -56,6 +57,9 @@ public:
 	// serialization
 	void Serialize(DumpStream& ar) override;
 
+	//! serialize the (shallow) state of the elements [n0, n1) and their material points
+	void SerializeElementState(DumpStream& ar, int n0, int n1);
+
 	//! augmentation
 	// NOTE: This is here so that the FESolver can do the augmentations
 	// for the 3-field hex/shell domains.
@@ -83,4 +87,9 @@ protected:
 
 	// helper function for unpacking element dofs
 	void UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm);
+
+protected:
+	// The material point data of the elements is allocated from this arena.
+	// (Since it is a member of the base class, it outlives the elements.)
+	FEMaterialPointArena	m_mpArena;
 };
@@ -159,6 +159,9 @@ bool FEErosionAdaptor::Apply(int iteration)
 	// reactivate the linear constraints
 	LCM.Activate();
 
+	// Since no nodes or elements were added or removed, this is a local change.
+	m_changes.SetLocal();
+
 	feLog("\tDeactivated elements: %d\n", deactiveElems);
 	return (deactiveElems == 0);
 }
@@ -36,6 +36,7 @@ SOFTWARE.*/
 FEElementMatrix::FEElementMatrix(const FEElement& el)
 {
 	m_node = el.m_node;
+	m_scatter = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +45,7 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke) : matrix(ke)
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_scatter = ke.m_scatter;
 }
 
 //-----------------------------------------------------------------------------
@@ -52,6 +54,7 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_scatter = ke.m_scatter;
 	matrix& T = *this;
 	const matrix& K = ke;
 	T = (scale == 1.0 ? K : K*scale);
@@ -63,6 +66,7 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, const vector<int>& lmi) :
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmi;
+	m_scatter = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -71,6 +75,7 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, vector<int>& lmi, vector<i
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmj;
+	m_scatter = nullptr;
 };
 
 //-----------------------------------------------------------------------------
@@ -90,6 +95,11 @@ FEGlobalMatrix::FEGlobalMatrix(SparseMatrix* pK, bool del)
 	m_pMP = 0;
 	m_nlm = 0;
 	m_delA = del;
+	m_bcolored = false;
+	m_profileTag = 0;
+	m_bincremental = false;
+	m_bchanged = true;
+	m_envelopeTag = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -105,6 +115,7 @@ FEGlobalMatrix::~FEGlobalMatrix()
 void FEGlobalMatrix::Clear()
 { 
 	if (m_pA) m_pA->Clear(); 
+	m_envelopeTag = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -169,10 +180,31 @@ void FEGlobalMatrix::build_end()
 {
 	if (m_nlm > 0) build_flush();
 	m_pA->Create(*m_pMP);
+
+	// Tags are unique over all global matrices so that a scatter map that 
+	// was built for another matrix is never mistaken for a valid one.
+	// (Matrices can be built concurrently, e.g. for the RVEs of multiscale models.)
+	static int profileCounter = 0;
+	int tag;
+	#pragma omp atomic capture
+	tag = ++profileCounter;
+	m_profileTag = tag;
 }
 
 //-----------------------------------------------------------------------------
 bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
+{
+	if (BuildProfile(pfem, neq, breset) == false) return false;
+	if (m_bchanged) CreateFromProfile();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Build the matrix profile of the model, without creating the sparse matrix.
+//! In incremental mode, ProfileChanged() returns false after this call if the 
+//! current sparse matrix can be kept. Otherwise, CreateFromProfile must be called
+//! to create the new sparse matrix.
+bool FEGlobalMatrix::BuildProfile(FEModel* pfem, int neq, bool breset)
 {
 	// The first time we come here we build the "static" profile.
 	// This static profile stores the contribution to the matrix profile
@@ -213,11 +245,50 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		// Add the "dynamic" profile
 		pfem->BuildMatrixProfile(*this, false);
 	}
+
+	// In incremental mode we first see if the new profile fits inside the 
+	// profile of the current sparse matrix. If so, the matrix (and anything the
+	// linear solver derived from its structure) can be reused as is. 
+	m_bchanged = true;
+	if (m_bincremental)
+	{
+		if (m_nlm > 0) build_flush();
+
+		if ((m_envelopeTag != 0) && (m_envelopeTag == m_profileTag) && (m_pA->Rows() == neq) && m_MPe.Contains(*m_pMP))
+		{
+			m_bchanged = false;
+			return true;
+		}
+
+		// The new profile does not fit, so we grow the profile to the union
+		// of the old and new profile. This way, contact pairs that separate
+		// and come back later do not trigger another reshape. However, when
+		// the union gets much larger than what is actually needed, we start
+		// over from the new profile to keep the matrix from filling up.
+		if ((m_envelopeTag != 0) && (m_envelopeTag == m_profileTag) && (m_MPe.Rows() == neq))
+		{
+			size_t nnew = m_pMP->Entries();
+			m_MPe.Merge(*m_pMP);
+			if (m_MPe.Entries() < nnew + nnew / 2) *m_pMP = m_MPe;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Create the sparse matrix from the profile that was built with BuildProfile.
+void FEGlobalMatrix::CreateFromProfile()
+{
 	// All done! We can now finish building the profile and create 
 	// the actual sparse matrix. This is done in the following function
 	build_end();
 
-	return true;
+	// Remember the profile of the matrix we just created. This is also done when
+	// the incremental mode is off, since it can be switched on for a single 
+	// update (see FENewtonSolver::Reinit).
+	m_MPe = *m_pMP;
+	m_envelopeTag = m_profileTag;
 }
 
 //-----------------------------------------------------------------------------
@@ -316,5 +387,22 @@ bool FEGlobalMatrix::Create(const FESurface& surf, const std::vector<int>& equat
 
 void FEGlobalMatrix::Assemble(const FEElementMatrix& ke)
 {
-	m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
+	const int* loc = ke.ScatterMap();
+	if (loc)
+	{
+		// direct assembly using the precomputed scatter map
+		double* pv = m_pA->Values();
+		const int N = ke.rows();
+		const int M = ke.columns();
+		for (int i = 0; i < N; ++i)
+		{
+			const double* ki = ke[i];
+			const int* li = loc + i*M;
+			for (int j = 0; j < M; ++j)
+			{
+				if (li[j] >= 0) pv[li[j]] += ki[j];
+			}
+		}
+	}
+	else m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
 }
@@ -45,8 +45,8 @@ class FECORE_API FEElementMatrix : public matrix
 {
 public:
 	// default constructor
-	FEElementMatrix(){}
-	FEElementMatrix(int nr, int nc) : matrix(nr, nc) {}
+	FEElementMatrix() : m_scatter(nullptr) {}
+	FEElementMatrix(int nr, int nc) : matrix(nr, nc), m_scatter(nullptr) {}
 	FEElementMatrix(const FEElement& el);
 
 	// constructor for symmetric matrices
@@ -82,10 +82,19 @@ public:
 	// get the nodes
 	const std::vector<int>& Nodes() const { return m_node; }
 
+	// Set the scatter map (see FEAssemblyMap)
+	// When set, the matrix is assembled directly into the global value array without atomics.
+	// It is the caller's responsibility that no other thread assembles into the same locations.
+	void SetScatterMap(const int* loc) { m_scatter = loc; }
+
+	// get the scatter map
+	const int* ScatterMap() const { return m_scatter; }
+
 private:
 	std::vector<int>	m_node;	//!< node indices
 	std::vector<int>	m_lmi;	//!< row indices
 	std::vector<int>	m_lmj;	//!< column indices
+	const int*			m_scatter;	//!< locations in the global value array (or null)
 };
 
 //-----------------------------------------------------------------------------
@@ -116,6 +125,12 @@ public:
 	//! construct the stiffness matrix from a FEM object
 	bool Create(FEModel* pfem, int neq, bool breset);
 
+	//! build the matrix profile of a FEM object (see Create), but don't create the sparse matrix yet
+	bool BuildProfile(FEModel* pfem, int neq, bool breset);
+
+	//! create the sparse matrix from the profile built by BuildProfile
+	void CreateFromProfile();
+
 	//! construct the stiffness matrix from a mesh
 	bool Create(FEMesh& mesh, int neq);
 
@@ -153,6 +168,27 @@ public:
 	//! get the sparse matrix profile
 	SparseMatrixProfile* GetSparseMatrixProfile() { return m_pMP; }
 
+	//! returns a tag that changes each time the matrix profile is rebuilt
+	int ProfileTag() const { return m_profileTag; }
+
+	//! enable or disable colored (lock-free) assembly
+	void SetColoredAssembly(bool b) { m_bcolored = b; }
+
+	//! see if colored assembly was requested
+	bool ColoredAssembly() const { return m_bcolored; }
+
+	//! enable or disable the incremental profile mode
+	//! In this mode, Create(FEModel*,...) keeps the sparse matrix when the new profile
+	//! fits inside the profile of the current matrix, and otherwise grows the matrix
+	//! profile to the union of the old and new profile.
+	void SetIncrementalProfile(bool b) { m_bincremental = b; }
+
+	//! see if the incremental profile mode is used
+	bool IncrementalProfile() const { return m_bincremental; }
+
+	//! returns true if the last call to Create(FEModel*,...) or BuildProfile requires a new sparse matrix
+	bool ProfileChanged() const { return m_bchanged; }
+
 public:
 	void build_begin(int neq);
 	void build_add(std::vector<int>& lm);
@@ -162,6 +198,12 @@ public:
 protected:
 	SparseMatrix*	m_pA;	//!< the actual global stiffness matrix
 	bool			m_delA;	//!< delete A in destructor
+	bool			m_bcolored;		//!< use colored assembly where supported
+	int				m_profileTag;	//!< changes each time the profile is rebuilt
+	bool			m_bincremental;	//!< keep the matrix when the new profile fits inside the old one
+	bool			m_bchanged;		//!< was the matrix reallocated by the last Create
+	int				m_envelopeTag;	//!< profile tag of the matrix that m_MPe describes (0 = none)
+	SparseMatrixProfile	m_MPe;		//!< the profile of the current matrix
 
 	// The following data structures are used to incrementally
 	// build the profile of the sparse matrix
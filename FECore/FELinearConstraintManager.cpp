@@ -99,14 +99,7 @@ void FELinearConstraintManager::Serialize(DumpStream& ar)
 	if (ar.IsSaving())
 	{
 		ar << m_LinC;
-
-		int nr = m_LCT.rows();
-		int nc = m_LCT.columns();
-		ar << nr << nc;
-		if (nr*nc > 0)
-		{
-			ar.write(&m_LCT(0,0), sizeof(int), nr*nc);
-		}
+		ar << m_LCTnode << m_LCTdof << m_LCTlc;
 	}
 	else
 	{
@@ -114,14 +107,7 @@ void FELinearConstraintManager::Serialize(DumpStream& ar)
 
 		// linear constraints
 		ar >> m_LinC;
-
-		int nr, nc;
-		ar >> nr >> nc;
-		if (nr*nc > 0)
-		{
-			m_LCT.resize(nr, nc);
-			ar.read(&m_LCT(0,0), sizeof(int), nr*nc);
-		}
+		ar >> m_LCTnode >> m_LCTdof >> m_LCTlc;
 	}
 }
 
@@ -130,7 +116,7 @@ void FELinearConstraintManager::Serialize(DumpStream& ar)
 void FELinearConstraintManager::BuildMatrixProfile(FEGlobalMatrix& G)
 {
 	int nlin = (int)m_LinC.size();
-	if (nlin == 0) return;
+	if ((nlin == 0) || m_LCTnode.empty()) return;
 
 	FEAnalysis* pstep = m_fem->GetCurrentStep();
 	FEMesh& mesh = m_fem->GetMesh();
@@ -158,35 +144,32 @@ void FELinearConstraintManager::BuildMatrixProfile(FEGlobalMatrix& G)
 			vector<int> constraintList;
 
 			// see if this element connects to the 
-			// parent node of a linear constraint ...
+			// parent node of a linear constraint
 			int m = el.Nodes();
 			for (int j = 0; j<m; ++j)
 			{	
-				int ncols = m_LCT.columns();
-				for (int k = 0; k<ncols; ++k)
+				int nj = el.m_node[j];
+				for (int k = m_LCTnode[nj]; k < m_LCTnode[nj + 1]; ++k)
 				{
-					int n = m_LCT(el.m_node[j], k);
-					if (n >= 0)
+					// the node has a constrained dof, so we need to connect the 
+					// element to the linear constraint
+					int n = m_LCTlc[k];
+					FELinearConstraint* plc = &m_LinC[n];
+					constraintList.push_back(n);
+					
+					int ns = (int)plc->m_childDof.size();
+
+					lm.resize(ne + ns);
+					for (int l = 0; l<ne; ++l) lm[l] = elm[l];
+
+					vector<FELinearConstraint::DOF>::iterator is = plc->m_childDof.begin();
+					for (int l = ne; l<ne + ns; ++l, ++is) 
 					{
-						// ... it does so we need to connect the 
-						// element to the linear constraint
-						FELinearConstraint* plc = &m_LinC[n];
-						constraintList.push_back(n);
-						
-						int ns = (int)plc->m_childDof.size();
-
-						lm.resize(ne + ns);
-						for (int l = 0; l<ne; ++l) lm[l] = elm[l];
-
-						vector<FELinearConstraint::DOF>::iterator is = plc->m_childDof.begin();
-						for (int l = ne; l<ne + ns; ++l, ++is) 
-						{
-							int neq = mesh.Node(is->node).m_ID[is->dof];
-							lm[l] = neq;
-						}
-
-						G.build_add(lm);
+						int neq = mesh.Node(is->node).m_ID[is->dof];
+						lm[l] = neq;
 					}
+
+					G.build_add(lm);
 				}
 			}
 
@@ -277,23 +260,74 @@ void FELinearConstraintManager::PrepStep()
 void FELinearConstraintManager::InitTable()
 {
 	FEMesh& mesh = m_fem->GetMesh();
+	int NN = mesh.Nodes();
+	int nlin = LinearConstraints();
 
-	// create the linear constraint table
-	DOFS& fedofs = m_fem->GetDOFS();
-	int MAX_NDOFS = fedofs.GetTotalDOFS();
-	m_LCT.resize(mesh.Nodes(), MAX_NDOFS, -1);
-	m_LCT.set(-1);
+	// count the constrained dofs of each node
+	m_LCTnode.assign(NN + 1, 0);
+	for (int i = 0; i<nlin; ++i) m_LCTnode[m_LinC[i].m_parentDof.node + 1]++;
+	for (int i = 0; i<NN; ++i) m_LCTnode[i + 1] += m_LCTnode[i];
 
-	vector<FELinearConstraint>::iterator ic = m_LinC.begin();
-	int nlin = LinearConstraints();
-	for (int i = 0; i<nlin; ++i, ++ic)
+	// fill the table
+	m_LCTdof.assign(nlin, -1);
+	m_LCTlc.assign(nlin, -1);
+	vector<int> pos(m_LCTnode.begin(), m_LCTnode.end() - 1);
+	for (int i = 0; i<nlin; ++i)
 	{
-		FELinearConstraint& lc = *ic;
+		FELinearConstraint& lc = m_LinC[i];
 		int n = lc.m_parentDof.node;
 		int m = lc.m_parentDof.dof;
 
-		m_LCT(n, m) = i;
+		// if a dof is constrained more than once, the last constraint wins
+		int k;
+		for (k = m_LCTnode[n]; k < pos[n]; ++k) if (m_LCTdof[k] == m) break;
+		if (k == pos[n]) pos[n]++;
+
+		m_LCTdof[k] = m;
+		m_LCTlc[k] = i;
+	}
+
+	// If a dof was constrained more than once, not all slots were used,
+	// so squeeze out the unused slots.
+	int nfill = 0;
+	for (int i = 0; i<NN; ++i)
+	{
+		int n0 = m_LCTnode[i];
+		m_LCTnode[i] = nfill;
+		for (int k = n0; k < pos[i]; ++k, ++nfill)
+		{
+			m_LCTdof[nfill] = m_LCTdof[k];
+			m_LCTlc[nfill] = m_LCTlc[k];
+		}
+	}
+	m_LCTnode[NN] = nfill;
+	m_LCTdof.resize(nfill);
+	m_LCTlc.resize(nfill);
+}
+
+//-----------------------------------------------------------------------------
+// returns the linear constraint of a dof (or -1 if the dof is not constrained)
+int FELinearConstraintManager::ConstraintIndex(int node, int dof) const
+{
+	if ((node < 0) || (node + 1 >= (int)m_LCTnode.size())) return -1;
+	for (int k = m_LCTnode[node]; k < m_LCTnode[node + 1]; ++k)
+	{
+		if (m_LCTdof[k] == dof) return m_LCTlc[k];
 	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// see if any of the nodes has a constrained (i.e. parent) dof
+bool FELinearConstraintManager::IsConstrained(const vector<int>& en) const
+{
+	int NN = (int)m_LCTnode.size() - 1;
+	for (size_t i = 0; i<en.size(); ++i)
+	{
+		int n = en[i];
+		if ((n >= 0) && (n < NN) && (m_LCTnode[n + 1] > m_LCTnode[n])) return true;
+	}
+	return false;
 }
 
 //-----------------------------------------------------------------------------
@@ -316,7 +350,7 @@ bool FELinearConstraintManager::Activate()
 			for (int k = 0; k<n; ++k)
 			{
 				FELinearConstraint::DOF& childDOF = lci.m_childDof[k];
-				int n = m_LCT(childDOF.node, childDOF.dof);
+				int n = ConstraintIndex(childDOF.node, childDOF.dof);
 				if (n != -1)
 				{
 					return false;
@@ -342,6 +376,9 @@ bool FELinearConstraintManager::Activate()
 //-----------------------------------------------------------------------------
 void FELinearConstraintManager::AssembleResidual(vector<double>& R, vector<int>& en, vector<int>& elm, vector<double>& fe)
 {
+	// nothing to do if the element doesn't touch a constrained dof
+	if (IsConstrained(en) == false) return;
+
 	FEMesh& mesh = m_fem->GetMesh();
 
 	int ndof = (int)fe.size();
@@ -354,7 +391,7 @@ void FELinearConstraintManager::AssembleResidual(vector<double>& R, vector<int>&
 		int nodei = i / ndn;
 		if (nodei < nodes) {
 			// see if this dof belongs to a linear constraint
-			int l = m_LCT(en[nodei], i%ndn);
+			int l = ConstraintIndex(en[nodei], i%ndn);
 			if (l >= 0)
 			{
 				// if so, get the linear constraint
@@ -381,68 +418,72 @@ void FELinearConstraintManager::AssembleResidual(vector<double>& R, vector<int>&
 }
 
 //-----------------------------------------------------------------------------
-void FELinearConstraintManager::AssembleStiffness(FEGlobalMatrix& G, vector<double>& R, vector<double>& ui, const vector<int>& en, const vector<int>& lmi, const vector<int>& lmj, const matrix& ke)
+// This evaluates the element's contribution to the product T^T*K*T, where T maps
+// the parent dofs of the linear constraints onto their child dofs. The values are 
+// stored in the buffer, so that this function can be called concurrently.
+void FELinearConstraintManager::AssembleStiffness(FEStiffnessBuffer& buf, const vector<double>& ui, const vector<int>& en, const vector<int>& lmi, const vector<int>& lmj, const matrix& ke) const
 {
+	// nothing to do if the element doesn't touch a constrained dof
+	if (IsConstrained(en) == false) return;
+
 	FEMesh& mesh = m_fem->GetMesh();
 
 	int ndof = ke.rows();
 	int ndn = ndof / (int)en.size();
 	const int nodes = (int)en.size();
 
-	SparseMatrix& K = *(&G);
-
 	// loop over all stiffness components 
 	// and correct for linear constraints
 	for (int i = 0; i<ndof; ++i)
 	{
 		int nodei = i / ndn;
-		int li = (nodei < nodes ? m_LCT(en[nodei], i%ndn) : -1);
+		int li = (nodei < nodes ? ConstraintIndex(en[nodei], i%ndn) : -1);
 		for (int j = 0; j < ndof; ++j)
 		{
 			int nodej = j / ndn;
-			int lj = (nodej < nodes ? m_LCT(en[nodej], j%ndn) : -1);
+			int lj = (nodej < nodes ? ConstraintIndex(en[nodej], j%ndn) : -1);
 			if ((li >= 0) && (lj < 0))
 			{
 				// dof i is constrained
-				FELinearConstraint& Li = m_LinC[li];
+				const FELinearConstraint& Li = m_LinC[li];
 
 				assert(lmi[i] == -1);
 
-				vector<FELinearConstraint::DOF>::iterator is = Li.m_childDof.begin();
+				vector<FELinearConstraint::DOF>::const_iterator is = Li.m_childDof.begin();
 				for (int k = 0; k < (int)Li.m_childDof.size(); ++k, ++is)
 				{
 					int I = mesh.Node(is->node).m_ID[is->dof];
 					int J = lmj[j];
 					double kij = is->val*ke[i][j];
-					if ((J >= 0) && (I >= 0)) K.add(I, J, kij);
+					if ((J >= 0) && (I >= 0)) buf.Add(I, J, kij);
 					else
 					{
 						// adjust for prescribed dofs
 						J = -J - 2;
-						if ((J >= 0) && (I >= 0)) R[I] -= kij*ui[J];
+						if ((J >= 0) && (I >= 0)) buf.AddRHS(I, -kij*ui[J]);
 					}
 				}
 			}
 			else if ((lj >= 0) && (li < 0))
 			{
 				// dof j is constrained
-				FELinearConstraint& Lj = m_LinC[lj];
+				const FELinearConstraint& Lj = m_LinC[lj];
 
 				assert(lmj[j] == -1);
 
-				vector<FELinearConstraint::DOF>::iterator js = Lj.m_childDof.begin();
+				vector<FELinearConstraint::DOF>::const_iterator js = Lj.m_childDof.begin();
 
 				for (int k = 0; k < (int)Lj.m_childDof.size(); ++k, ++js)
 				{
 					int I = lmi[i];
 					int J = mesh.Node(js->node).m_ID[js->dof];
 					double kij = js->val*ke[i][j];
-					if ((J >= 0) && (I >= 0)) K.add(I, J, kij);
+					if ((J >= 0) && (I >= 0)) buf.Add(I, J, kij);
 					else
 					{
 						// adjust for prescribed dofs
 						J = -J - 2;
-						if ((J >= 0) && (I >= 0)) R[I] -= kij*ui[J];
+						if ((J >= 0) && (I >= 0)) buf.AddRHS(I, -kij*ui[J]);
 					}
 				}
 
@@ -451,17 +492,17 @@ void FELinearConstraintManager::AssembleStiffness(FEGlobalMatrix& G, vector<doub
 				{
 					double ri = ke[i][j] * m_up[lj];
 					int I = lmi[i];
-					if (I >= 0) R[i] -= ri;
+					if (I >= 0) buf.AddRHS(i, -ri);
 				}
 			}
 			else if ((li >= 0) && (lj >= 0))
 			{
 				// both dof i and j are constrained
-				FELinearConstraint& Li = m_LinC[li];
-				FELinearConstraint& Lj = m_LinC[lj];
+				const FELinearConstraint& Li = m_LinC[li];
+				const FELinearConstraint& Lj = m_LinC[lj];
 
-				vector<FELinearConstraint::DOF>::iterator is = Li.m_childDof.begin();
-				vector<FELinearConstraint::DOF>::iterator js = Lj.m_childDof.begin();
+				vector<FELinearConstraint::DOF>::const_iterator is = Li.m_childDof.begin();
+				vector<FELinearConstraint::DOF>::const_iterator js = Lj.m_childDof.begin();
 
 				assert(lmi[i] == -1);
 				assert(lmj[j] == -1);
@@ -475,12 +516,12 @@ void FELinearConstraintManager::AssembleStiffness(FEGlobalMatrix& G, vector<doub
 						int J = mesh.Node(js->node).m_ID[js->dof];;
 						double kij = ke[i][j] * is->val*js->val;
 
-						if ((J >= 0) && (I >= 0)) K.add(I, J, kij);
+						if ((J >= 0) && (I >= 0)) buf.Add(I, J, kij);
 						else
 						{
 							// adjust for prescribed dofs
 							J = -J - 2;
-							if ((J >= 0) && (I >= 0)) R[I] -= kij*ui[J];
+							if ((J >= 0) && (I >= 0)) buf.AddRHS(I, -kij*ui[J]);
 						}
 					}
 				}
@@ -493,7 +534,7 @@ void FELinearConstraintManager::AssembleStiffness(FEGlobalMatrix& G, vector<doub
 					{
 						int I = mesh.Node(is->node).m_ID[is->dof];
 						double ri = is->val * ke[i][j] * m_up[lj];
-						if (I >= 0) R[i] -= ri;
+						if (I >= 0) buf.AddRHS(i, -ri);
 					}
 				}
 			}
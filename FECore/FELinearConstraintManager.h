@@ -28,7 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FELinearConstraint.h"
-#include "table.h"
+#include "FEStiffnessBuffer.h"
 
 class FEGlobalMatrix;
 class matrix;
@@ -77,8 +77,12 @@ public:
 	// assemble element residual into global residual
 	void AssembleResidual(vector<double>& R, vector<int>& en, vector<int>& elm, vector<double>& fe);
 
-	// assemble element matrix into (reduced) global matrix
-	void AssembleStiffness(FEGlobalMatrix& K, vector<double>& R, vector<double>& ui, const vector<int>& en, const vector<int>& lmi, const vector<int>& lmj, const matrix& ke);
+	// evaluate the contributions of the element matrix to the (reduced) global matrix
+	// and store them in the buffer
+	void AssembleStiffness(FEStiffnessBuffer& buf, const vector<double>& ui, const vector<int>& en, const vector<int>& lmi, const vector<int>& lmj, const matrix& ke) const;
+
+	// see if any of the nodes has a constrained (i.e. parent) dof
+	bool IsConstrained(const vector<int>& en) const;
 
 	// called before the first reformation for each time step
 	void PrepStep();
@@ -89,9 +93,17 @@ public:
 protected:
 	void InitTable();
 
+	// returns the linear constraint of a dof (or -1 if the dof is not constrained)
+	int ConstraintIndex(int node, int dof) const;
+
 private:
 	FEModel* m_fem;
 	vector<FELinearConstraint>	m_LinC;		//!< linear constraints data
-	table<int>					m_LCT;		//!< linear constraint table
 	vector<double>				m_up;		//!< the inhomogenous component of the linear constraint
+
+	// The linear constraint table (LCT) stores for each node the constrained dofs
+	// and the linear constraint they belong to, in compressed row format.
+	vector<int>		m_LCTnode;		//!< offset into m_LCTdof for each node (size = nodes + 1)
+	vector<int>		m_LCTdof;		//!< constrained dof
+	vector<int>		m_LCTlc;		//!< linear constraint of constrained dof
 };
@@ -254,6 +254,9 @@ bool FELinearSolver::ReformStiffness()
 		FELinearSystem K(this, *m_pK, m_R, m_u, (m_msymm == REAL_SYMMETRIC));
 		if (!StiffnessMatrix(K)) return false;
 
+		// make sure the matrix is complete before the callback sees it
+		K.FinalizeAssembly();
+
 		// do call back
 		FEModel& fem = *GetFEModel();
 		fem.DoCallback(CB_MATRIX_REFORM);
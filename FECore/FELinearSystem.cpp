@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FELinearSystem.h"
 #include "FELinearConstraintManager.h"
 #include "FEModel.h"
+#include <omp.h>
 
 //-----------------------------------------------------------------------------
 FELinearSystem::FELinearSystem(FESolver* solver, FEGlobalMatrix& K, vector<double>& F, vector<double>& u, bool bsymm) : m_K(K), m_F(F), m_u(u), m_solver(solver)
@@ -40,7 +41,72 @@ FELinearSystem::FELinearSystem(FESolver* solver, FEGlobalMatrix& K, vector<doubl
 //-----------------------------------------------------------------------------
 FELinearSystem::~FELinearSystem()
 {
+	for (size_t i = 0; i < m_buf.size(); ++i) delete m_buf[i];
+	m_buf.clear();
+	m_freeBuf.clear();
+}
 
+//-----------------------------------------------------------------------------
+// Add the buffered contributions to the global matrix and the RHS vector.
+// This is called once per assembly, after all parallel regions have ended.
+void FELinearSystem::FinalizeAssembly()
+{
+	assert(omp_in_parallel() == 0);
+	assert(m_freeBuf.size() == m_buf.size());
+	SparseMatrix& K = m_K;
+	for (size_t i = 0; i < m_buf.size(); ++i)
+	{
+		if (m_buf[i]->IsEmpty() == false) m_buf[i]->Assemble(K, m_F);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Get an assembly buffer that is not in use. Buffers are handed out to whichever 
+// thread asks for one, so this does not depend on thread numbers (which are not 
+// unique in nested parallel regions). New buffers are only created when all
+// buffers are in use, so there are never more buffers than concurrent threads.
+FEStiffnessBuffer* FELinearSystem::AcquireBuffer()
+{
+	FEStiffnessBuffer* buf = nullptr;
+	#pragma omp critical (FELinearSystem_buffer)
+	{
+		if (m_freeBuf.empty())
+		{
+			buf = new FEStiffnessBuffer;
+			m_buf.push_back(buf);
+		}
+		else
+		{
+			buf = m_freeBuf.back();
+			m_freeBuf.pop_back();
+		}
+	}
+	return buf;
+}
+
+//-----------------------------------------------------------------------------
+// Return a buffer that was obtained with AcquireBuffer
+void FELinearSystem::ReleaseBuffer(FEStiffnessBuffer* buf)
+{
+	#pragma omp critical (FELinearSystem_buffer)
+	m_freeBuf.push_back(buf);
+}
+
+//-----------------------------------------------------------------------------
+// Assembles the contributions of linear constraints into an assembly buffer
+void FELinearSystem::AssembleLinearConstraints(const FEElementMatrix& ke)
+{
+	FEModel* fem = m_solver->GetFEModel();
+	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+	if (LCM.LinearConstraints() == 0) return;
+
+	// skip elements that don't touch any of the constrained dofs
+	const vector<int>& en = ke.Nodes();
+	if (LCM.IsConstrained(en) == false) return;
+
+	FEStiffnessBuffer* buf = AcquireBuffer();
+	LCM.AssembleStiffness(*buf, m_u, en, ke.RowIndices(), ke.ColumnsIndices(), ke);
+	ReleaseBuffer(buf);
 }
 
 //-----------------------------------------------------------------------------
@@ -57,6 +123,13 @@ FESolver* FELinearSystem::GetSolver()
 	return m_solver;
 }
 
+//-----------------------------------------------------------------------------
+// Get the global stiffness matrix
+FEGlobalMatrix& FELinearSystem::GetStiffnessMatrix()
+{
+	return m_K;
+}
+
 //-----------------------------------------------------------------------------
 //! assemble global stiffness matrix
 void FELinearSystem::Assemble(const FEElementMatrix& ke)
@@ -98,16 +171,8 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 	}
 
-#pragma omp critical
-	{
-	FEModel* fem = m_solver->GetFEModel();
-	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
-	if (LCM.LinearConstraints())
-	{
-		const vector<int>& en = ke.Nodes();
-		LCM.AssembleStiffness(m_K, m_F, m_u, en, lmi, lmj, ke);
-	}
-	} // omp critical
+	// adjust for linear constraints
+	AssembleLinearConstraints(ke);
 }
 
 //-----------------------------------------------------------------------------
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "FEGlobalMatrix.h"
 #include "matrix.h"
+#include "FEStiffnessBuffer.h"
 #include <vector>
 using namespace std;
 
@@ -56,6 +57,9 @@ public:
 	// Get the solver that is using this linear system
 	FESolver* GetSolver();
 
+	// Get the global stiffness matrix
+	FEGlobalMatrix& GetStiffnessMatrix();
+
 public:
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -69,10 +73,29 @@ public:
 	// This assembles a vetor to the RHS
 	void AssembleRHS(vector<int>& lm, vector<double>& fe);
 
+	// Add the buffered contributions (e.g. of linear constraints) to the global matrix
+	// and the RHS vector. This must be called (outside of any parallel region) when 
+	// the assembly is done. Contributions that are not finalized are discarded.
+	void FinalizeAssembly();
+
+protected:
+	// Get an assembly buffer that is not in use. The calling thread owns the buffer 
+	// until it returns it with ReleaseBuffer, so it can be filled without locking.
+	FEStiffnessBuffer* AcquireBuffer();
+
+	// Return a buffer that was obtained with AcquireBuffer
+	void ReleaseBuffer(FEStiffnessBuffer* buf);
+
+	// Assembles the contributions of linear constraints into the thread's buffer
+	void AssembleLinearConstraints(const FEElementMatrix& ke);
+
 protected:
 	bool			m_bsymm;	//!< symmetry flag
 	FESolver*		m_solver;
 	FEGlobalMatrix& m_K;	//!< The global stiffness matrix
 	vector<double>&	m_F;	//!< Contributions from prescribed degrees of freedom
 	vector<double>&	m_u;	//!< the array with prescribed values
+
+	vector<FEStiffnessBuffer*>	m_buf;		//!< all assembly buffers
+	vector<FEStiffnessBuffer*>	m_freeBuf;	//!< assembly buffers that are not in use
 };
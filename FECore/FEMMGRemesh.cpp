@@ -32,7 +32,7 @@ SOFTWARE.*/
 #include "FESolidDomain.h"
 #include "FESurface.h"
 #include "log.h"
-#include "FEOctreeSearch.h"
+#include "FEPointLocator.h"
 #include "FENNQuery.h"
 
 #ifdef HAS_MMG
@@ -397,16 +397,19 @@ bool FEMMGRemesh::MMG::build_new_mesh(MMG5_pMesh mmgMesh, MMG5_pSol mmgSol, FEMo
 
 	if (transferMethod == 0)
 	{
-		FEOctreeSearch octree(&mesh);
-		octree.Init();
+		FEPointLocator locator(&mesh);
+		if (locator.Init() == false) return false;
+
+		// locate the new nodes
+		vector<int> elem;
+		vector<vec3d> R;
+		locator.FindElements(nodePos0, elem, R);
 
 		// update solution
 		for (int i = 0; i < nodes; ++i)
 		{
-			vec3d ri = nodePos0[i];
-
-			double r[3] = { 0 };
-			FESolidElement* el = (FESolidElement*)octree.FindElement(ri, r);
+			double r[3] = { R[i].x, R[i].y, R[i].z };
+			FESolidElement* el = (elem[i] >= 0 ? locator.Element(elem[i]) : nullptr);
 			if (el == nullptr)
 			{
 				assert(false);
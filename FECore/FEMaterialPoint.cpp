@@ -29,8 +29,77 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEMaterialPoint.h"
 #include "DumpStream.h"
+#include "FEMaterialPointArena.h"
 #include <string.h>
+#include <new>
+#include <map>
+#include <string>
+#include <deque>
 
+//-----------------------------------------------------------------------------
+// Each allocation is preceded by a header that stores the arena and block it 
+// came from (the arena is null if it was allocated on the heap). The header 
+// size keeps the alignment.
+union FEMaterialPointHeader
+{
+	struct
+	{
+		FEMaterialPointArena*	arena;
+		int						block;
+	} info;
+	double	align[2];
+};
+
+void* FEMaterialPoint::operator new(size_t size)
+{
+	size_t n = size + sizeof(FEMaterialPointHeader);
+	FEMaterialPointArena* arena = FEMaterialPointArena::Current();
+	int block = -1;
+	void* p = (arena ? arena->Allocate(n, block) : ::operator new(n));
+	FEMaterialPointHeader* h = (FEMaterialPointHeader*)p;
+	h->info.arena = arena;
+	h->info.block = block;
+	return (void*)(h + 1);
+}
+
+void FEMaterialPoint::operator delete(void* p)
+{
+	if (p == 0) return;
+	FEMaterialPointHeader* h = ((FEMaterialPointHeader*)p) - 1;
+	if (h->info.arena) h->info.arena->Release(h->info.block);
+	else ::operator delete((void*)h);
+}
+
+//-----------------------------------------------------------------------------
+// The slots are assigned by type name, since a type can have a different 
+// type_info object in each module.
+int FEMaterialPointLookupSlot(const std::type_info& t)
+{
+	static std::map<std::string, int> slots;
+	int n = 0;
+	#pragma omp critical (FEMaterialPointLookupSlot)
+	{
+		std::map<std::string, int>::iterator it = slots.find(t.name());
+		if (it == slots.end())
+		{
+			n = (int)slots.size();
+			slots[t.name()] = n;
+		}
+		else n = it->second;
+	}
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+// The tables are stored in a deque, so that adding tables does not move the existing ones.
+FEMaterialPointLookup& FEMaterialPointLookupTable(int slot)
+{
+	static thread_local std::deque<FEMaterialPointLookup> lut;
+	if (slot >= (int)lut.size()) lut.resize(slot + 1);
+	return lut[slot];
+}
+
+//-----------------------------------------------------------------------------
 FEMaterialPoint::FEMaterialPoint(FEMaterialPoint* ppt)
 {
 	m_pPrev = 0;
@@ -31,9 +31,66 @@ SOFTWARE.*/
 #include "mat3d.h"
 #include "FETimeInfo.h"
 #include <vector>
+#include <typeinfo>
+#include <type_traits>
+#include "fecore_api.h"
 using namespace std;
 
 class FEElement;
+class FEMaterialPoint;
+
+//-----------------------------------------------------------------------------
+//! Lookup table for FEMaterialPoint::ExtractData. 
+//! Finding the data requires a dynamic_cast for each visited point of the 
+//! material point list. However, the outcome only depends on the types of the
+//! visited points, and all material points of a domain have the same structure.
+//! Therefore, the sequence of visited types is stored together with the offset
+//! of the result, so that the next search of a list with the same types only
+//! needs to compare the type_info pointers.
+class FEMaterialPointLookup
+{
+public:
+	enum { MAX_PATH = 8, MAX_ENTRIES = 4 };
+
+	// a visited point: its type and whether it was found by going up the list
+	struct Step
+	{
+		const std::type_info*	type;
+		bool					up;
+	};
+
+	struct Path
+	{
+		Step	step[MAX_PATH];
+		int		n;
+		Path() : n(0) {}
+
+		// add a step (paths that are too long are not stored)
+		void Add(const FEMaterialPoint* pt, bool up);
+	};
+
+public:
+	FEMaterialPointLookup() : m_entries(0), m_next(0) {}
+
+	//! see if the list starting at mp has been searched before. If so, returns
+	//! the point that contains the data and the offset of the data in it, otherwise null.
+	template <class MP> MP* Find(MP* mp, ptrdiff_t& offset) const;
+
+	//! store the result of a search. pt is the point that was found and p the
+	//! (adjusted) pointer to the data.
+	void Add(const Path& path, const FEMaterialPoint* pt, const void* p);
+
+private:
+	struct Entry
+	{
+		Path		path;
+		ptrdiff_t	offset;
+	};
+
+	Entry	m_entry[MAX_ENTRIES];
+	int		m_entries;	//!< number of entries in use
+	int		m_next;		//!< next entry to overwrite
+};
 
 //-----------------------------------------------------------------------------
 //! Material point class
@@ -69,9 +126,11 @@ public:
 
 	//! Get the next material point data
 	FEMaterialPoint* Next() { return m_pNext; }
+	const FEMaterialPoint* Next() const { return m_pNext; }
 
 	//! Get the previous (parent) material point data
 	FEMaterialPoint* Prev() { return m_pPrev; }
+	const FEMaterialPoint* Prev() const { return m_pPrev; }
     
 	//! Extract data (\todo Is it safe for a plugin to use this function?)
 	template <class T> T* ExtractData();
@@ -88,6 +147,12 @@ public:
 	// serialization
 	virtual void Serialize(DumpStream& ar);
 
+public:
+	//! Material points are allocated from the current arena, if there is one
+	//! (see FEMaterialPointArena).
+	static void* operator new(size_t size);
+	static void operator delete(void* p);
+
 public:
 	vec3d		m_r0;		//!< material point position
 	double		m_J0;		//!< reference Jacobian
@@ -104,63 +169,129 @@ protected:
 };
 
 //-----------------------------------------------------------------------------
-template <class T> inline T* FEMaterialPoint::ExtractData()
+inline void FEMaterialPointLookup::Path::Add(const FEMaterialPoint* pt, bool up)
 {
-	// first see if this is the correct type
-	T* p = dynamic_cast<T*>(this);
-	if (p) return p;
-
-	// check all the child classes 
-	FEMaterialPoint* pt = this;
-	while (pt->m_pNext)
+	if (n < MAX_PATH)
 	{
-		pt = pt->m_pNext;
-		p = dynamic_cast<T*>(pt);
-		if (p) return p;
+		step[n].type = &typeid(*pt);
+		step[n].up = up;
 	}
+	n++;
+}
 
-	// search up
-	pt = this;
-	while (pt->m_pPrev)
+//-----------------------------------------------------------------------------
+// The list is walked in the same order as in ExtractData: first this point, 
+// then down the list, then up.
+template <class MP> inline MP* FEMaterialPointLookup::Find(MP* mp, ptrdiff_t& offset) const
+{
+	for (int i = 0; i < m_entries; ++i)
 	{
-		pt = pt->m_pPrev;
-		p = dynamic_cast<T*>(pt);
-		if (p) return p;
+		const Path& path = m_entry[i].path;
+		if (&typeid(*mp) != path.step[0].type) continue;
+
+		MP* pt = mp;
+		bool up = false;
+		int j;
+		for (j = 1; j < path.n; ++j)
+		{
+			const Step& s = path.step[j];
+			if (s.up && (up == false))
+			{
+				// the search only goes up after it reached the bottom of the list
+				if (pt->Next()) break;
+				up = true;
+				pt = mp;
+			}
+			pt = (up ? pt->Prev() : pt->Next());
+			if ((pt == 0) || (&typeid(*pt) != s.type)) break;
+		}
+		if (j == path.n)
+		{
+			offset = m_entry[i].offset;
+			return pt;
+		}
 	}
-
-	// Everything has failed. Material point data can not be found
 	return 0;
 }
 
 //-----------------------------------------------------------------------------
-template <class T> inline const T* FEMaterialPoint::ExtractData() const
+inline void FEMaterialPointLookup::Add(const Path& path, const FEMaterialPoint* pt, const void* p)
+{
+	if ((path.n == 0) || (path.n > MAX_PATH)) return;
+	Entry& e = m_entry[m_next];
+	e.path = path;
+	e.offset = (const char*)p - (const char*)pt;
+	m_next = (m_next + 1) % MAX_ENTRIES;
+	if (m_entries < MAX_ENTRIES) m_entries++;
+}
+
+//-----------------------------------------------------------------------------
+// Each thread has its own lookup table for each type. The tables are stored in
+// FECore, so that all modules share them, and each module only looks up the 
+// slot of a type once.
+FECORE_API int FEMaterialPointLookupSlot(const std::type_info& t);
+FECORE_API FEMaterialPointLookup& FEMaterialPointLookupTable(int slot);
+
+template <class T> inline FEMaterialPointLookup& FEMaterialPointLookupTable()
+{
+	static const int slot = FEMaterialPointLookupSlot(typeid(T));
+	return FEMaterialPointLookupTable(slot);
+}
+
+//-----------------------------------------------------------------------------
+// This implements ExtractData for both const and non-const points, i.e. MP is
+// FEMaterialPoint or const FEMaterialPoint, and T has the same constness.
+template <class T, class MP> inline T* FEMaterialPointExtractData(MP* mp)
 {
+	typedef typename std::conditional<std::is_const<MP>::value, const char, char>::type C;
+
+	// see if we searched a list of the same structure before
+	FEMaterialPointLookup& lut = FEMaterialPointLookupTable<typename std::remove_const<T>::type>();
+	ptrdiff_t offset = 0;
+	MP* pt = lut.Find(mp, offset);
+	if (pt) return reinterpret_cast<T*>(reinterpret_cast<C*>(pt) + offset);
+
 	// first see if this is the correct type
-	const T* p = dynamic_cast<const T*>(this);
-	if (p) return p;
+	FEMaterialPointLookup::Path path;
+	path.Add(mp, false);
+	T* p = dynamic_cast<T*>(mp);
+	if (p) { lut.Add(path, mp, p); return p; }
 
 	// check all the child classes 
-	const FEMaterialPoint* pt = this;
-	while (pt->m_pNext)
+	pt = mp;
+	while (pt->Next())
 	{
-		pt = pt->m_pNext;
-		p = dynamic_cast<const T*>(pt);
-		if (p) return p;
+		pt = pt->Next();
+		path.Add(pt, false);
+		p = dynamic_cast<T*>(pt);
+		if (p) { lut.Add(path, pt, p); return p; }
 	}
 
 	// search up
-	pt = this;
-	while (pt->m_pPrev)
+	pt = mp;
+	while (pt->Prev())
 	{
-		pt = pt->m_pPrev;
-		p = dynamic_cast<const T*>(pt);
-		if (p) return p;
+		pt = pt->Prev();
+		path.Add(pt, true);
+		p = dynamic_cast<T*>(pt);
+		if (p) { lut.Add(path, pt, p); return p; }
 	}
 
 	// Everything has failed. Material point data can not be found
 	return 0;
 }
 
+//-----------------------------------------------------------------------------
+template <class T> inline T* FEMaterialPoint::ExtractData()
+{
+	return FEMaterialPointExtractData<T>(this);
+}
+
+//-----------------------------------------------------------------------------
+template <class T> inline const T* FEMaterialPoint::ExtractData() const
+{
+	return FEMaterialPointExtractData<const T>(this);
+}
 
 //-----------------------------------------------------------------------------
 // Material point base class for materials that define vector properties
@@ -0,0 +1,154 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEMaterialPointArena.h"
+#include <new>
+#include <assert.h>
+
+// allocations are aligned to this boundary
+#define ARENA_ALIGN 16
+
+// the arena that is used by the current thread
+static thread_local FEMaterialPointArena* current_arena = nullptr;
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::Scope::Scope(FEMaterialPointArena& arena)
+{
+	m_prev = current_arena;
+	current_arena = &arena;
+}
+
+FEMaterialPointArena::Scope::~Scope()
+{
+	current_arena = m_prev;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena* FEMaterialPointArena::Current()
+{
+	return current_arena;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::FEMaterialPointArena()
+{
+	m_nblock = -1;
+	m_nalloc = 0;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::~FEMaterialPointArena()
+{
+	assert(m_nalloc == 0);
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointArena::Clear()
+{
+	for (size_t i = 0; i < m_block.size(); ++i) ::operator delete(m_block[i].data);
+	m_block.clear();
+	m_free.clear();
+	m_nblock = -1;
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMaterialPointArena::Capacity() const
+{
+	size_t n = 0;
+	for (size_t i = 0; i < m_block.size(); ++i) n += m_block[i].size;
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+// Allocations are taken from the current block. If it is full, we continue in 
+// a block whose allocations have all been released, or allocate a new one.
+void* FEMaterialPointArena::Allocate(size_t size, int& nblock)
+{
+	size = ((size + ARENA_ALIGN - 1) / ARENA_ALIGN)*ARENA_ALIGN;
+
+	void* p = 0;
+	#pragma omp critical (FEMaterialPointArena)
+	{
+		if ((m_nblock < 0) || (m_block[m_nblock].pos + size > m_block[m_nblock].size))
+		{
+			// look for a free block that is large enough
+			int nfree = -1;
+			for (size_t i = 0; i < m_free.size(); ++i)
+			{
+				if (m_block[m_free[i]].size >= size) { nfree = (int)i; break; }
+			}
+
+			if (nfree >= 0)
+			{
+				m_nblock = m_free[nfree];
+				m_free[nfree] = m_free.back();
+				m_free.pop_back();
+			}
+			else
+			{
+				Block b;
+				b.size = (size > BLOCK_SIZE ? size : (size_t)BLOCK_SIZE);
+				b.data = (char*) ::operator new(b.size);
+				b.pos = 0;
+				b.nalloc = 0;
+				m_block.push_back(b);
+				m_nblock = (int)m_block.size() - 1;
+			}
+		}
+
+		Block& b = m_block[m_nblock];
+		p = b.data + b.pos;
+		b.pos += size;
+		b.nalloc++;
+		m_nalloc++;
+		nblock = m_nblock;
+	}
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+// A block is rewound when its last allocation is released. If it is not the 
+// current block, it is put on the free list.
+void FEMaterialPointArena::Release(int nblock)
+{
+	// material points are usually deleted one element at a time, but this may
+	// happen in parallel
+	#pragma omp critical (FEMaterialPointArena)
+	{
+		Block& b = m_block[nblock];
+		assert(b.nalloc > 0);
+		b.nalloc--;
+		m_nalloc--;
+		if (b.nalloc == 0)
+		{
+			b.pos = 0;
+			if (nblock != m_nblock) m_free.push_back(nblock);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------
+//! Arena for allocating material point data. 
+//! The material points of a domain are allocated in large contiguous blocks
+//! instead of individually. Material points are allocated from an arena 
+//! while an FEMaterialPointArena::Scope object exists on the allocating thread
+//! (see FEMaterialPoint::operator new). Deleting a material point does not 
+//! release its memory, but each block keeps track of its live allocations and
+//! is reused once all of them have been deleted. The arena must outlive the 
+//! material points that were allocated from it.
+class FECORE_API FEMaterialPointArena
+{
+public:
+	enum { BLOCK_SIZE = 65536 };
+
+	//! While this object exists, material points created on this thread are 
+	//! allocated from the arena.
+	class FECORE_API Scope
+	{
+	public:
+		Scope(FEMaterialPointArena& arena);
+		~Scope();
+
+	private:
+		FEMaterialPointArena*	m_prev;
+	};
+
+public:
+	FEMaterialPointArena();
+	~FEMaterialPointArena();
+
+	//! allocate memory. The block that the memory came from is returned in nblock.
+	void* Allocate(size_t size, int& nblock);
+
+	//! release one allocation of block nblock
+	void Release(int nblock);
+
+	//! number of allocations that are still alive
+	int Allocations() const { return m_nalloc; }
+
+	//! total size of the allocated blocks
+	size_t Capacity() const;
+
+	//! the arena of the current thread (or null)
+	static FEMaterialPointArena* Current();
+
+private:
+	void Clear();
+
+	FEMaterialPointArena(const FEMaterialPointArena&) {}
+	void operator = (const FEMaterialPointArena&) {}
+
+private:
+	struct Block
+	{
+		char*	data;
+		size_t	size;
+		size_t	pos;	//!< position of the next allocation
+		int		nalloc;	//!< number of live allocations in this block
+	};
+
+	std::vector<Block>	m_block;	//!< allocated blocks
+	std::vector<int>	m_free;		//!< blocks without live allocations (other than the current one)
+	int			m_nblock;	//!< current block
+	int			m_nalloc;	//!< number of live allocations
+};
@@ -67,6 +67,7 @@ FEDataMap* CreateDataMap(int mapType)
 FEMesh::FEMesh(FEModel* fem) : m_fem(fem)
 {
 	m_LUT = 0;
+	m_bnodeStore = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -97,6 +98,9 @@ void FEMesh::Serialize(DumpStream& ar)
 	}
 	ar.UnlockPointerTable();
 
+	// loaded nodes own their dof arrays, so move them back into the nodal store
+	if ((ar.IsShallow() == false) && ar.IsLoading()) UpdateNodeStorage();
+
 	// stream domain data
 	ar & m_Domain;
 
@@ -218,6 +222,8 @@ void FEMesh::CreateNodes(int nodes)
 	for (int i=0; i<nodes; ++i) Node(i).SetID(i+1);
 
 	m_NEL.Clear();
+
+	UpdateNodeStorage();
 }
 
 //-----------------------------------------------------------------------------
@@ -235,6 +241,9 @@ void FEMesh::AddNodes(int nodes)
 
 	m_Node.resize(N0 + nodes);
 	for (int i=0; i<nodes; ++i) m_Node[i+N0].SetID(n0+i);
+
+	// resizing the node array copied the nodes, which detached them from the store
+	UpdateNodeStorage();
 }
 
 //-----------------------------------------------------------------------------
@@ -242,6 +251,56 @@ void FEMesh::SetDOFS(int n)
 {
 	int NN = Nodes();
 	for (int i=0; i<NN; ++i) m_Node[i].SetDOFS(n);
+	UpdateNodeStorage();
+}
+
+//-----------------------------------------------------------------------------
+void FEMesh::SetContiguousNodeStorage(bool b)
+{
+	if (b == m_bnodeStore) return;
+	m_bnodeStore = b;
+	UpdateNodeStorage();
+}
+
+//-----------------------------------------------------------------------------
+// (Re)allocate the contiguous nodal store and attach all nodes to it. This needs
+// to be called whenever the node array or the number of dofs of a node changes.
+// Nodes whose dof count changes afterwards (e.g. via FENode::SetDOFS) simply
+// fall back to their own storage until the store is updated again.
+void FEMesh::UpdateNodeStorage()
+{
+	int NN = Nodes();
+	if (m_bnodeStore == false)
+	{
+		for (int i = 0; i < NN; ++i) m_Node[i].DetachStorage();
+		m_nodeBC.clear(); m_nodeBC.shrink_to_fit();
+		m_nodeVal_t.clear(); m_nodeVal_t.shrink_to_fit();
+		m_nodeVal_p.clear(); m_nodeVal_p.shrink_to_fit();
+		m_nodeFr.clear(); m_nodeFr.shrink_to_fit();
+		return;
+	}
+
+	// count the dofs
+	int N = 0;
+	for (int i = 0; i < NN; ++i) N += m_Node[i].dofs();
+
+	// The nodes may still point into the old arrays, so we allocate new ones
+	// and only release the old arrays after all nodes are attached.
+	vector<int> BC(N, 0);
+	vector<double> vt(N, 0.0), vp(N, 0.0), fr(N, 0.0);
+	int n0 = 0;
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = m_Node[i];
+		int n = node.dofs();
+		if (n > 0) node.AttachStorage(&BC[n0], &vt[n0], &vp[n0], &fr[n0]);
+		n0 += n;
+	}
+
+	m_nodeBC.swap(BC);
+	m_nodeVal_t.swap(vt);
+	m_nodeVal_p.swap(vp);
+	m_nodeFr.swap(fr);
 }
 
 //-----------------------------------------------------------------------------
@@ -341,6 +400,10 @@ void FEMesh::InitMaterialPoints()
 void FEMesh::Clear()
 {
 	m_Node.clear();
+	m_nodeBC.clear();
+	m_nodeVal_t.clear();
+	m_nodeVal_p.clear();
+	m_nodeFr.clear();
 	for (size_t i=0; i<m_Domain.size (); ++i) delete m_Domain [i];
 
 	// TODO: Surfaces are currently managed by the classes that use them so don't delete them
@@ -103,6 +103,14 @@ public:
 	//! Set the number of degrees of freedom on this mesh
 	void SetDOFS(int n);
 
+	//! Store the dof arrays of all nodes in one contiguous array per field
+	//! (current and previous values, nodal forces, bc flags) instead of
+	//! separately allocated arrays for each node.
+	void SetContiguousNodeStorage(bool b);
+
+	//! see if the nodal dof arrays are stored contiguously
+	bool ContiguousNodeStorage() const { return m_bnodeStore; }
+
 	//! update bounding box
 	void UpdateBox();
 
@@ -254,10 +262,18 @@ public: // data maps
 
 protected:
 	double SolidElementVolume(FESolidElement& el);
+	void UpdateNodeStorage();
 	double ShellElementVolume(FEShellElement& el);
 
 private:
 	vector<FENode>		m_Node;		//!< nodes
+
+	// contiguous nodal storage (only used when m_bnodeStore is set)
+	bool				m_bnodeStore;	//!< store nodal dof arrays contiguously
+	vector<int>			m_nodeBC;		//!< bc flags of all nodes
+	vector<double>		m_nodeVal_t;	//!< current dof values of all nodes
+	vector<double>		m_nodeVal_p;	//!< previous dof values of all nodes
+	vector<double>		m_nodeFr;		//!< nodal forces of all nodes
 	vector<FEDomain*>	m_Domain;	//!< list of domains
 	vector<FESurface*>	m_Surf;		//!< surfaces
 	vector<FEEdge*>		m_Edge;		//!< Edges
@@ -36,6 +36,33 @@ class FEModel;
 class FEElement;
 class FEMaterialPoint;
 
+//-----------------------------------------------------------------------------
+// This class describes the changes that a mesh adaptor made to the mesh. By default,
+// it is assumed that the entire mesh was changed (i.e. it is a "global" change). 
+// Mesh adaptors that only change the state of existing nodes and elements (e.g. 
+// deactivate elements), without adding or removing any, can report a "local" change.
+// This allows the solver to be updated incrementally.
+class FECORE_API FEMeshChangeSet
+{
+public:
+	FEMeshChangeSet() { Reset(); }
+
+	// reset the change set, i.e. assume that the entire mesh has changed
+	void Reset() { m_bglobal = true; }
+
+	// mark the changes as local
+	void SetLocal() { m_bglobal = false; }
+
+	// add the changes of another change set
+	void Merge(const FEMeshChangeSet& c) { if (c.IsGlobal()) m_bglobal = true; }
+
+	// returns true if the entire mesh may have changed
+	bool IsGlobal() const { return m_bglobal; }
+
+private:
+	bool	m_bglobal;
+};
+
 //-----------------------------------------------------------------------------
 // Base class for all mesh adaptors
 class FECORE_API FEMeshAdaptor : public FECoreBase
@@ -49,6 +76,15 @@ public:
 	// otherwise, it should return false.
 	// iteration is the iteration number of the mesh adaptation loop
 	virtual bool Apply(int iteration) = 0;
+
+	// The changes that the last call to Apply made to the mesh.
+	const FEMeshChangeSet& GetChanges() const { return m_changes; }
+
+	// This is called before Apply
+	void ResetChanges() { m_changes.Reset(); }
+
+protected:
+	FEMeshChangeSet	m_changes;	//!< changes made by the last call to Apply
 };
 
 //-----------------------------------------------------------------------------
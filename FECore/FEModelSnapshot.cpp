@@ -0,0 +1,163 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEModelSnapshot.h"
+#include "FEModel.h"
+#include "FEMesh.h"
+#include "FEDomain.h"
+
+//-----------------------------------------------------------------------------
+// number of elements per block
+#define SNAPSHOT_BLOCK_SIZE	1024
+
+//-----------------------------------------------------------------------------
+FEModelSnapshot::FEModelSnapshot(FEModel& fem) : m_fem(fem), m_ar(fem)
+{
+	m_bvalid = false;
+
+	// element data is stored in the blocks
+	m_ar.ExcludeElementData(true);
+}
+
+//-----------------------------------------------------------------------------
+FEModelSnapshot::~FEModelSnapshot()
+{
+	for (size_t i = 0; i < m_blockData.size(); ++i) delete m_blockData[i];
+	m_blockData.clear();
+}
+
+//-----------------------------------------------------------------------------
+// The blocks are cheap to determine, so we do this for each snapshot in case 
+// the mesh has changed. The streams are only allocated when more are needed.
+bool FEModelSnapshot::UpdateBlocks()
+{
+	std::vector<Block> oldBlocks;
+	oldBlocks.swap(m_block);
+
+	FEMesh& mesh = m_fem.GetMesh();
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		int NEL = dom.Elements();
+		for (int n0 = 0; n0 < NEL; n0 += SNAPSHOT_BLOCK_SIZE)
+		{
+			int n1 = n0 + SNAPSHOT_BLOCK_SIZE;
+			if (n1 > NEL) n1 = NEL;
+			Block b = { &dom, n0, n1, false };
+			m_block.push_back(b);
+		}
+	}
+
+	while (m_blockData.size() < m_block.size()) m_blockData.push_back(new DumpMemStream(m_fem));
+
+	// see if the blocks are the same as before, and if so, copy their state
+	if (oldBlocks.size() != m_block.size()) return false;
+	for (size_t i = 0; i < m_block.size(); ++i)
+	{
+		Block& b = m_block[i];
+		const Block& o = oldBlocks[i];
+		if ((b.dom != o.dom) || (b.n0 != o.n0) || (b.n1 != o.n1)) return false;
+		b.inactive = o.inactive;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEModelSnapshot::Invalidate()
+{
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEModelSnapshot::Save()
+{
+	bool breuse = UpdateBlocks() && m_bvalid;
+
+	// store all the shallow data, except the element data
+	m_ar.Open(true, true);
+	m_fem.Serialize(m_ar);
+
+	// store the element data
+	// A block that was inactive for the last snapshot, and still is, did not change.
+	int NB = (int)m_block.size();
+	#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < NB; ++i)
+	{
+		Block& b = m_block[i];
+
+		bool inactive = true;
+		for (int j = b.n0; (j < b.n1) && inactive; ++j) inactive = (b.dom->ElementRef(j).isActive() == false);
+
+		if ((breuse == false) || (b.inactive == false) || (inactive == false))
+		{
+			DumpMemStream& ar = *m_blockData[i];
+			ar.Open(true, true);
+			b.dom->SerializeElementState(ar, b.n0, b.n1);
+		}
+		b.inactive = inactive;
+	}
+
+	m_bvalid = true;
+}
+
+//-----------------------------------------------------------------------------
+void FEModelSnapshot::Restore()
+{
+	// restore all the shallow data, except the element data
+	m_ar.Open(false, true);
+	m_fem.Serialize(m_ar);
+
+	// restore the element data
+	// (exceptions cannot leave a parallel region, so we rethrow them afterwards)
+	bool bok = true;
+	int NB = (int)m_block.size();
+	#pragma omp parallel for schedule(dynamic) reduction(&&:bok)
+	for (int i = 0; i < NB; ++i)
+	{
+		Block& b = m_block[i];
+		DumpMemStream& ar = *m_blockData[i];
+		try {
+			ar.Open(false, true);
+			b.dom->SerializeElementState(ar, b.n0, b.n1);
+		}
+		catch (...)
+		{
+			bok = false;
+		}
+	}
+	if (bok == false) throw DumpStream::ReadError();
+}
+
+//-----------------------------------------------------------------------------
+size_t FEModelSnapshot::size() const
+{
+	size_t nsize = m_ar.size();
+	for (size_t i = 0; i < m_block.size(); ++i) nsize += m_blockData[i]->size();
+	return nsize;
+}
@@ -0,0 +1,86 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "DumpMemStream.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+class FEModel;
+class FEDomain;
+
+//-----------------------------------------------------------------------------
+// This class stores a copy of the state of a model so that it can be restored
+// later. It is used by the analysis to roll back time steps that failed to converge.
+// The bulk of the state, i.e. the element and material point data, is stored in 
+// separate memory streams, one per block of elements. These blocks are saved and 
+// restored in parallel. All other (shallow) model data is stored in one stream.
+// The buffers are retained between snapshots so that, after the first save, 
+// taking a snapshot does not need to allocate any memory.
+// Only element data that may have changed since the last snapshot is stored again.
+// The state of inactive elements is never updated, so a block of elements that 
+// was already inactive when the last snapshot was taken keeps its stored data.
+// This assumption no longer holds when elements are (re)activated, so the snapshot
+// must be invalidated whenever the mesh is changed (see Invalidate).
+class FECORE_API FEModelSnapshot
+{
+	struct Block
+	{
+		FEDomain*	dom;		// the domain
+		int			n0, n1;		// element range [n0, n1)
+		bool		inactive;	// all elements of the block were inactive when saved
+	};
+
+public:
+	FEModelSnapshot(FEModel& fem);
+	~FEModelSnapshot();
+
+	// store the current state of the model
+	void Save();
+
+	// restore the model to the last saved state
+	void Restore();
+
+	// return the size (in bytes) of the snapshot
+	size_t size() const;
+
+	// Call this when the mesh was changed, so that the next Save stores all element data.
+	void Invalidate();
+
+private:
+	// divide the elements of all domains into blocks
+	// (returns false if the blocks differ from the blocks of the last snapshot)
+	bool UpdateBlocks();
+
+private:
+	FEModel&			m_fem;
+	DumpMemStream		m_ar;		//!< stream for all data except element data
+	std::vector<Block>	m_block;	//!< element data blocks
+	std::vector<DumpMemStream*>	m_blockData;	//!< streams storing the element data of each block
+	bool				m_bvalid;	//!< the stored element data can be reused by the next Save
+};
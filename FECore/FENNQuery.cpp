@@ -48,6 +48,8 @@ int cmp_node(const void* e1, const void* e2)
 FENNQuery::FENNQuery(FESurface* ps)
 {
 	m_ps = ps;
+	m_imin = 0;
+	m_bbvh = false;
 }
 
 FENNQuery::~FENNQuery()
@@ -56,60 +58,13 @@ FENNQuery::~FENNQuery()
 }
 
 //-----------------------------------------------------------------------------
-
+// For the current configuration, the search uses the bounding volume hierarchy
+// of the surface, which only needs to be refitted when the surface moves.
 void FENNQuery::Init()
 {
 	assert(m_ps);
-
-	int i;
-	vec3d r0, r;
-	int N = m_ps->Nodes();
-
-	// pick a random point as pivot
-	r0 = m_q1 = m_ps->Node(0).m_rt;
-
-	// find the farthest node of this node
-	double dmax = 0, d;
-	for (i=0; i<N; ++i)
-	{
-		r = m_ps->Node(i).m_rt;
-		d = (r - r0)*(r - r0);
-		if (d > dmax)
-		{
-			m_q1 = r;
-			dmax = d;
-		}
-	}
-
-	// let's find the farthest node of this node
-	r0 = m_q2 = m_q1;
-	dmax = 0;
-	for (i=0; i<N; ++i)
-	{
-		r = m_ps->Node(i).m_rt;
-		d = (r - r0)*(r - r0);
-		if (d > dmax)
-		{
-			m_q2 = r;
-			dmax = d;
-		}
-	}
-
-	// create the BK-"tree"
-	m_bk.resize(N);
-	for (i=0; i<N; ++i) 
-	{
-		r = m_ps->Node(i).m_rt;
-		m_bk[i].i = i;
-		m_bk[i].r = r;
-		m_bk[i].d1 = (m_q1 - r)*(m_q1 - r);
-		m_bk[i].d2 = (m_q2 - r)*(m_q2 - r);
-	}
-
-	// sort the tree
-	qsort(&m_bk[0], N, sizeof(NODE), cmp_node);
-
-	// set the initial search item
+	m_ps->GetBVH().Update();
+	m_bbvh = true;
 	m_imin = 0;
 }
 
@@ -118,6 +73,7 @@ void FENNQuery::Init()
 void FENNQuery::InitReference()
 {
 	assert(m_ps);
+	m_bbvh = false;
 
 	int i;
 	vec3d r0, r;
@@ -181,6 +137,23 @@ int FENNQuery::Find(vec3d x)
 	double d, d1, d2, dmin;
 	vec3d r;
 
+	// The last found item is used as the initial guess. Find can be called from 
+	// multiple threads, so m_imin is accessed atomically. Since it is only a 
+	// starting point for the search, it does not matter which thread wrote it last.
+	int imin;
+	#pragma omp atomic read
+	imin = m_imin;
+
+	if (m_bbvh)
+	{
+		imin = m_ps->GetBVH().FindNearestNode(x, imin);
+
+		#pragma omp atomic write
+		m_imin = imin;
+
+		return imin;
+	}
+
 	// set the initial search radii
 	d1 = sqrt((m_q1 - x)*(m_q1 - x)); 
 	rmin1 = 0;
@@ -191,7 +164,6 @@ int FENNQuery::Find(vec3d x)
 	rmax2 = 2*d2;
 
 	// check the last found item
-	int imin = m_imin;
 	r = m_ps->Node(imin).m_rt;
 	dmin = (r - x)*(r - x);
 	d = sqrt(dmin);
@@ -258,7 +230,7 @@ int FENNQuery::Find(vec3d x)
 	assert(imin == m_imin);
 */
 
-	#pragma omp critical
+	#pragma omp atomic write
 	m_imin = imin;
 
 	return imin;
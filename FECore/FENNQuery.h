@@ -73,6 +73,7 @@ protected:
 	vec3d	m_q2;	// pivot 2
 
 	int		m_imin;	// last found index
+	bool	m_bbvh;	// use the bounding volume hierarchy of the surface (current configuration only)
 };
 
 // function for finding the k closest neighbors
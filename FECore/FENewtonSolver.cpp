@@ -39,6 +39,8 @@ SOFTWARE.*/
 #include "FEDomain.h"
 #include "DumpStream.h"
 #include "FELinearSystem.h"
+#include "FESolutionHistory.h"
+#include "FEMeshAdaptor.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -50,6 +52,8 @@ BEGIN_FECORE_CLASS(FENewtonSolver, FESolver)
 	ADD_PARAMETER(m_bzero_diagonal      , "check_zero_diagonal");
 	ADD_PARAMETER(m_zero_tol            , "zero_diagonal_tol"  );
 	ADD_PARAMETER(m_force_partition     , "force_partition");
+	ADD_PARAMETER(m_bcoloredAssembly    , "colored_assembly");
+	ADD_PARAMETER(m_bincrementalProfile , "incremental_profile");
 	ADD_PARAMETER(m_breformtimestep     , "reform_each_time_step");
 	ADD_PARAMETER(m_breformAugment      , "reform_augment");
 	ADD_PARAMETER(m_bdivreform          , "diverge_reform");
@@ -105,8 +109,14 @@ FENewtonSolver::FENewtonSolver(FEModel* pfem) : FESolver(pfem)
 	m_zero_tol = 0.0;
 
 	m_force_partition = 0;
+	m_bcoloredAssembly = false;
+	m_bincrementalProfile = false;
+	m_bincrementalReshape = false;
 	m_breformtimestep = true;
 	m_breformAugment = false;
+
+	m_recordHistory = nullptr;
+	m_initialGuess = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -181,7 +191,16 @@ bool FENewtonSolver::ReformStiffness()
     if (m_breshape)
     {
         // reshape the stiffness matrix
-        if (!CreateStiffness(m_niter == 0)) return false;
+		// After a local mesh change (see Reinit) the matrix is reshaped in incremental 
+		// mode, after which the configured mode is restored.
+		if (m_bincrementalReshape) m_pK->SetIncrementalProfile(true);
+		bool bok = CreateStiffness(m_niter == 0);
+		if (m_bincrementalReshape)
+		{
+			m_pK->SetIncrementalProfile(m_bincrementalProfile);
+			m_bincrementalReshape = false;
+		}
+		if (bok == false) return false;
         
         // reset reshape flag, except for contact
 		m_breshape = (((fem.SurfacePairConstraints() > 0) || (fem.NonlinearConstraints() > 0)) ? true : false);
@@ -266,35 +285,61 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 {
 	{
 		TRACK_TIME(TimerID::Timer_Reform);
-		// clean up the solver
-		m_plinsolve->Destroy();
-
-		// clean up the stiffness matrix
-		m_pK->Clear();
 
 		// create the stiffness matrix
 		feLog("===== reforming stiffness matrix:\n");
-		if (m_pK->Create(GetFEModel(), m_neq, breset) == false)
+		if (m_pK->IncrementalProfile() == false)
 		{
-			feLogError("An error occured while building the stiffness matrix\n\n");
-			return false;
+			// clean up the solver
+			m_plinsolve->Destroy();
+
+			// clean up the stiffness matrix
+			m_pK->Clear();
+
+			if (m_pK->Create(GetFEModel(), m_neq, breset) == false)
+			{
+				feLogError("An error occured while building the stiffness matrix\n\n");
+				return false;
+			}
 		}
 		else
 		{
-			// output some information about the direct linear solver
-			int neq = m_pK->Rows();
-			int nnz = m_pK->NonZeroes();
-			feLog("\tNr of equations ........................... : %d\n", neq);
-			feLog("\tNr of nonzeroes in stiffness matrix ....... : %d\n", nnz);
-
-			int parts = m_plinsolve->Partitions();
-			if (parts > 1)
+			// In incremental mode the old matrix is kept until we know
+			// whether the new profile still fits inside it.
+			if (m_pK->BuildProfile(GetFEModel(), m_neq, breset) == false)
 			{
-				feLog("\tNr of partitions .......................... : %d\n", parts);
-				for (int i = 0; i < parts; ++i)
-				{
-					feLog("\t\tpartition %d ............................ : %d\n", i+1, m_plinsolve->GetPartitionSize(i));
-				}
+				feLogError("An error occured while building the stiffness matrix\n\n");
+				return false;
+			}
+
+			if (m_pK->ProfileChanged() == false)
+			{
+				// The matrix structure did not change, so the linear solver
+				// does not need to redo its preprocessing.
+				feLog("\tMatrix profile unchanged, reusing stiffness matrix\n");
+				return true;
+			}
+
+			// The old matrix will be replaced, so the solver must let go of its data
+			// before the old matrix is released.
+			m_plinsolve->Destroy();
+			m_pK->Clear();
+			m_pK->CreateFromProfile();
+		}
+
+		// output some information about the direct linear solver
+		int neq = m_pK->Rows();
+		int nnz = m_pK->NonZeroes();
+		feLog("\tNr of equations ........................... : %d\n", neq);
+		feLog("\tNr of nonzeroes in stiffness matrix ....... : %d\n", nnz);
+
+		int parts = m_plinsolve->Partitions();
+		if (parts > 1)
+		{
+			feLog("\tNr of partitions .......................... : %d\n", parts);
+			for (int i = 0; i < parts; ++i)
+			{
+				feLog("\t\tpartition %d ............................ : %d\n", i+1, m_plinsolve->GetPartitionSize(i));
 			}
 		}
 	}
@@ -393,6 +438,8 @@ bool FENewtonSolver::AllocateLinearSystem()
 		feLogError("Failed allocating stiffness matrix.");
 		return false;
 	}
+	m_pK->SetColoredAssembly(m_bcoloredAssembly);
+	m_pK->SetIncrementalProfile(m_bincrementalProfile);
 
 	return true;
 }
@@ -456,6 +503,51 @@ void FENewtonSolver::Clean()
 	if (m_qnstrategy) delete m_qnstrategy; m_qnstrategy = nullptr;
 }
 
+//-----------------------------------------------------------------------------
+//! Update the solver after a local change of the mesh. 
+//! When the equation numbering is not affected by the changes (e.g. when elements were
+//! deactivated, but all nodes remain connected) all solver data can be kept and only
+//! the matrix profile needs to be updated.
+bool FENewtonSolver::Reinit(const FEMeshChangeSet& changes)
+{
+	if (changes.IsGlobal() || (m_pK == nullptr) || (m_plinsolve == nullptr)) return false;
+
+	// store the current equation numbers
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	vector<int> ID;
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		ID.insert(ID.end(), node.m_ID.begin(), node.m_ID.end());
+	}
+	int neq = m_neq;
+
+	// renumber the equations
+	if (InitEquations() == false) return false;
+
+	// if any of the equation numbers changed, the solver data is no longer valid
+	if (m_neq != neq) return false;
+	size_t n = 0;
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		for (size_t j = 0; j < node.m_ID.size(); ++j, ++n)
+		{
+			if ((n >= ID.size()) || (node.m_ID[j] != ID[n])) return false;
+		}
+	}
+	if (n != ID.size()) return false;
+
+	// The matrix profile must be rebuilt. In incremental mode the stiffness matrix, and
+	// the preprocessing of the linear solver, are kept when the new profile fits inside
+	// the old one, which is always the case when elements were only removed.
+	feLog("\tEquation numbering unchanged, updating matrix profile only.\n");
+	m_bincrementalReshape = true;
+	m_breshape = true;
+
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 void FENewtonSolver::Serialize(DumpStream& ar)
 {
@@ -584,6 +676,9 @@ bool FENewtonSolver::SolveStep()
 		feLog("\nconvergence summary\n");
 		feLog("    number of iterations   : %d\n", m_niter);
 		feLog("    number of reformations : %d\n", m_nref);
+
+		// store the converged solution
+		if (m_recordHistory) m_recordHistory->Add(GetFEModel()->GetTime().currentTime, m_Ut);
 	}
 
 	return bret;
@@ -822,6 +917,9 @@ void FENewtonSolver::PrepStep()
 //! call this at the start of the quasi-newton loop (after PrepStep)
 bool FENewtonSolver::QNInit()
 {
+	// start from the initial guess, if we have one
+	if (m_initialGuess) ApplyInitialGuess();
+
 	// see if we reform at the start of every time step
 	bool breform = (m_breformtimestep || (m_qnstrategy->m_maxups == 0));
 
@@ -866,6 +964,37 @@ bool FENewtonSolver::QNInit()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! This moves the model to the initial guess for the current time step. This is
+//! called after PrepStep. Only the free nodal dofs are moved. The prescribed dofs
+//! (and the rigid body dofs) are left alone, so that the prescribed increments 
+//! that PrepStep stored in m_ui are still applied as usual.
+void FENewtonSolver::ApplyInitialGuess()
+{
+	const FETimeInfo& tp = GetFEModel()->GetTime();
+	const vector<double>* U = m_initialGuess->Find(tp.currentTime);
+	if ((U == nullptr) || (U->size() != m_Ut.size())) return;
+
+	// Only the free equations of the nodes get the initial guess. Note that the 
+	// nodes of rigid bodies have negative IDs, so the rigid equations are skipped as well.
+	vector<double> du(m_neq, 0.0);
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		for (int j = 0; j < (int)node.m_ID.size(); ++j)
+		{
+			int n = node.m_ID[j];
+			if ((n >= 0) && (n < m_neq)) du[n] = (*U)[n] - m_Ut[n] - m_Ui[n];
+		}
+	}
+
+	Update(du);
+	m_Ui += du;
+
+	feLog("\tstarting from initial guess\n");
+}
+
 //-----------------------------------------------------------------------------
 //! solve the equations
 void FENewtonSolver::SolveEquations(std::vector<double>& u, std::vector<double>& R)
@@ -1170,7 +1299,12 @@ bool FENewtonSolver::StiffnessMatrix()
 	FELinearSystem LS(this, *m_pK, m_Fd, m_ui, (m_msymm == REAL_SYMMETRIC));
 
 	// build the stiffness matrix
-	return StiffnessMatrix(LS);
+	if (StiffnessMatrix(LS) == false) return false;
+
+	// add the buffered contributions (e.g. of linear constraints)
+	LS.FinalizeAssembly();
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -37,6 +37,7 @@ SOFTWARE.*/
 class FEModel;
 class FEGlobalMatrix;
 class FELinearSystem;
+class FESolutionHistory;
 
 //-----------------------------------------------------------------------------
 enum QN_STRATEGY
@@ -107,6 +108,9 @@ public: // overloaded from FESolver
 	//! Clean up
 	void Clean() override;
 
+	//! Update the solver after a local change of the mesh
+	bool Reinit(const FEMeshChangeSet& changes) override;
+
 	//! serialization
 	void Serialize(DumpStream& ar) override;
 
@@ -152,6 +156,13 @@ public:
 	//! Get the total solution vector (for current Newton iteration)
 	virtual void GetSolutionVector(std::vector<double>& U);
 
+	//! Store the total solution of each converged time step in hist (null to stop recording)
+	void RecordSolutionHistory(FESolutionHistory* hist) { m_recordHistory = hist; }
+
+	//! Use the solutions in hist as the initial guess of the time steps (null to stop).
+	//! Time steps for which hist has no solution start from the previous time step as usual.
+	void SetInitialGuess(FESolutionHistory* hist) { m_initialGuess = hist; }
+
 public:
 	//! do augmentations
 	bool DoAugmentations();
@@ -209,6 +220,9 @@ public:
 protected:
 	bool AllocateLinearSystem();
 
+	//! start the time step from the initial guess, if there is one
+	void ApplyInitialGuess();
+
 public:
 	// line search options
 	FELineSearch*	m_lineSearch;
@@ -216,6 +230,8 @@ public:
 	// solver parameters
 	int					m_maxref;		//!< max nr of reformations per time step
 	int					m_force_partition;	//!< Force a partition of the global matrix (e.g. for testing with BIPN solver)
+	bool				m_bcoloredAssembly;	//!< use lock-free colored assembly (compact matrices only)
+	bool				m_bincrementalProfile;	//!< reuse the stiffness matrix when a new profile fits inside it
 	double				m_Rtol;			//!< residual convergence norm
 	double				m_Etol;			//!< energy convergence norm
 	double				m_Rmin;			//!< min residual value
@@ -241,6 +257,7 @@ public:
 	LinearSolver*		m_plinsolve;	//!< the linear solver
 	FEGlobalMatrix*		m_pK;			//!< global stiffness matrix
     bool				m_breshape;		//!< Matrix reshape flag
+	bool				m_bincrementalReshape;	//!< reshape the matrix in incremental mode (after a local mesh change)
 
 	// data used by Quasin
 	vector<double> m_R0;	//!< residual at iteration i-1
@@ -261,6 +278,9 @@ public:
 private:
 	double	m_ls;	//!< line search factor calculated in last call to QNSolve
 
+	FESolutionHistory*	m_recordHistory;	//!< converged solutions are stored here (if not null)
+	FESolutionHistory*	m_initialGuess;		//!< initial guesses for the time steps (if not null)
+
 private:
 	ConvergenceInfo			m_residuNorm;	// residual convergence info
 	ConvergenceInfo			m_energyNorm;	// energy convergence info
@@ -43,20 +43,90 @@ FENode::FENode()
 
 	// default ID
 	m_nID = -1;
+
+	// no dofs yet
+	m_BC = 0;
+	m_val_t = m_val_p = m_Fr = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Allocate the node's own storage for the dof arrays (this detaches the node
+// from the nodal store of the mesh).
+void FENode::AllocOwnStorage(int n)
+{
+	m_own.assign(3*n, 0.0);
+	m_ownBC.assign(n, 0);
+	if (n > 0)
+	{
+		m_BC = &m_ownBC[0];
+		m_val_t = &m_own[0];
+		m_val_p = m_val_t + n;
+		m_Fr = m_val_p + n;
+	}
+	else
+	{
+		m_BC = 0;
+		m_val_t = m_val_p = m_Fr = 0;
+	}
 }
 
 //-----------------------------------------------------------------------------
 void FENode::SetDOFS(int n)
 {
 	// initialize dof stuff
+	if (IsStorageAttached() && (n == dofs()))
+	{
+		// just reset the values in the external storage
+		for (int i = 0; i < n; ++i)
+		{
+			m_BC[i] = 0;
+			m_val_t[i] = m_val_p[i] = m_Fr[i] = 0.0;
+		}
+	}
+	else AllocOwnStorage(n);
 	m_ID.assign(n, -1);
-	m_BC.assign(n, 0);
-	m_val_t.assign(n, 0.0);
-	m_val_p.assign(n, 0.0);
-	m_Fr.assign(n, 0.0);
 }
 
 //-----------------------------------------------------------------------------
+void FENode::AttachStorage(int* bc, double* vt, double* vp, double* fr)
+{
+	int n = dofs();
+	for (int i = 0; i < n; ++i)
+	{
+		bc[i] = m_BC[i];
+		vt[i] = m_val_t[i];
+		vp[i] = m_val_p[i];
+		fr[i] = m_Fr[i];
+	}
+	m_BC = bc;
+	m_val_t = vt;
+	m_val_p = vp;
+	m_Fr = fr;
+	m_own.clear(); m_own.shrink_to_fit();
+	m_ownBC.clear(); m_ownBC.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+void FENode::DetachStorage()
+{
+	if (IsStorageAttached() == false) return;
+	int* bc = m_BC;
+	double* vt = m_val_t;
+	double* vp = m_val_p;
+	double* fr = m_Fr;
+	int n = dofs();
+	AllocOwnStorage(n);
+	for (int i = 0; i < n; ++i)
+	{
+		m_BC[i] = bc[i];
+		m_val_t[i] = vt[i];
+		m_val_p[i] = vp[i];
+		m_Fr[i] = fr[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+// A copy always owns its dof arrays.
 FENode::FENode(const FENode& n)
 {
 	m_r0 = n.m_r0;
@@ -74,15 +144,24 @@ FENode::FENode(const FENode& n)
 	m_nstate = n.m_nstate;
 
 	m_ID = n.m_ID;
-	m_BC = n.m_BC;
-	m_val_t = n.m_val_t;
-	m_val_p = n.m_val_p;
-	m_Fr = n.m_Fr;
+	int N = n.dofs();
+	AllocOwnStorage(N);
+	for (int i = 0; i < N; ++i)
+	{
+		m_BC[i] = n.m_BC[i];
+		m_val_t[i] = n.m_val_t[i];
+		m_val_p[i] = n.m_val_p[i];
+		m_Fr[i] = n.m_Fr[i];
+	}
 }
 
 //-----------------------------------------------------------------------------
+// If this node is attached to the nodal store and the number of dofs does not
+// change, the values are copied into the store.
 FENode& FENode::operator = (const FENode& n)
 {
+	if (&n == this) return (*this);
+
 	m_r0 = n.m_r0;
 	m_rt = n.m_rt;
 	m_at = n.m_at;
@@ -97,30 +176,87 @@ FENode& FENode::operator = (const FENode& n)
 	m_rid = n.m_rid;
 	m_nstate = n.m_nstate;
 
+	int N = n.dofs();
+	if ((IsStorageAttached() == false) || (N != dofs())) AllocOwnStorage(N);
 	m_ID = n.m_ID;
-	m_BC = n.m_BC;
-	m_val_t = n.m_val_t;
-	m_val_p = n.m_val_p;
-	m_Fr = n.m_Fr;
+	for (int i = 0; i < N; ++i)
+	{
+		m_BC[i] = n.m_BC[i];
+		m_val_t[i] = n.m_val_t[i];
+		m_val_p[i] = n.m_val_p[i];
+		m_Fr[i] = n.m_Fr[i];
+	}
 
 	return (*this);
 }
 
+//-----------------------------------------------------------------------------
+// The dof arrays are written in the same format as std::vector, so that
+// archives do not depend on where the arrays are stored.
+template <typename T> static void SerializeArray(DumpStream& ar, T* a, int n)
+{
+	if (ar.IsSaving())
+	{
+		ar.write(&n, sizeof(int), 1);
+		if (n > 0) ar.write(a, sizeof(T), n);
+	}
+	else
+	{
+		int m = 0;
+		ar.read(&m, sizeof(int), 1);
+		assert(m == n);
+		if (m > 0) ar.read(a, sizeof(T), m);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // Serialize
 void FENode::Serialize(DumpStream& ar)
 {
+	// the dof count is only known after reading the (deep) data, so in that case
+	// we need to read the arrays into temporary buffers
+	if (ar.IsLoading() && (ar.IsShallow() == false))
+	{
+		std::vector<double> Fr, vt, vp;
+		std::vector<int> BC;
+		ar & m_nID;
+		ar & m_rt & m_at;
+		ar & m_rp & m_vp & m_ap;
+		ar & Fr;
+		ar & vt & vp;
+		ar & m_dt & m_dp;
+		ar & m_nstate;
+		ar & m_ID;
+		ar & BC;
+		ar & m_r0;
+		ar & m_rid;
+		ar & m_d0;
+
+		int N = (int)m_ID.size();
+		AllocOwnStorage(N);
+		for (int i = 0; i < N; ++i)
+		{
+			if (i < (int)BC.size()) m_BC[i] = BC[i];
+			if (i < (int)vt.size()) m_val_t[i] = vt[i];
+			if (i < (int)vp.size()) m_val_p[i] = vp[i];
+			if (i < (int)Fr.size()) m_Fr[i] = Fr[i];
+		}
+		return;
+	}
+
+	int N = dofs();
 	ar & m_nID;
 	ar & m_rt & m_at;
 	ar & m_rp & m_vp & m_ap;
-	ar & m_Fr;
-	ar & m_val_t & m_val_p;
+	SerializeArray(ar, m_Fr, N);
+	SerializeArray(ar, m_val_t, N);
+	SerializeArray(ar, m_val_p, N);
     ar & m_dt & m_dp;
 	if (ar.IsShallow() == false)
 	{
 		ar & m_nstate;
 		ar & m_ID;
-		ar & m_BC;
+		SerializeArray(ar, m_BC, N);
 		ar & m_r0;
 		ar & m_rid;
 		ar & m_d0;
@@ -131,5 +267,6 @@ void FENode::Serialize(DumpStream& ar)
 //! Update nodal values, which copies the current values to the previous array
 void FENode::UpdateValues()
 {
-	m_val_p = m_val_t;
+	int N = dofs();
+	for (int i = 0; i < N; ++i) m_val_p[i] = m_val_t[i];
 }
@@ -69,6 +69,16 @@ public:
 	//! Set the number of DOFS
 	void SetDOFS(int n);
 
+	//! Let the dof arrays point into external storage (see FEMesh::SetContiguousNodeStorage).
+	//! The current values are copied into the new storage.
+	void AttachStorage(int* bc, double* vt, double* vp, double* fr);
+
+	//! Copy the dof arrays back into storage owned by the node
+	void DetachStorage();
+
+	//! See if the dof arrays are stored externally
+	bool IsStorageAttached() const { return m_own.empty() && (m_BC != 0); }
+
 	//! Get the nodal ID
 	int GetID() const { return m_nID; }
 
@@ -154,10 +164,18 @@ public:
     vec3d   m_sp() { return m_rp - m_dp; }
 
 private:
-	std::vector<int>		m_BC;		//!< boundary condition array
-	std::vector<double>		m_val_t;	//!< current nodal DOF values
-	std::vector<double>		m_val_p;	//!< previous nodal DOF values
-	std::vector<double>		m_Fr;		//!< equivalent nodal forces
+	void AllocOwnStorage(int n);
+
+private:
+	int*		m_BC;		//!< boundary condition array
+	double*		m_val_t;	//!< current nodal DOF values
+	double*		m_val_p;	//!< previous nodal DOF values
+	double*		m_Fr;		//!< equivalent nodal forces
+
+	// Storage for the arrays above, unless they point into the nodal store of the mesh.
+	// The values (current, previous, forces) share a single allocation.
+	std::vector<double>		m_own;
+	std::vector<int>		m_ownBC;
 
 public:
 	std::vector<int>		m_ID;	//!< nodal equation numbers
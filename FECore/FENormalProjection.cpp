@@ -31,17 +31,18 @@ SOFTWARE.*/
 #include "FEMesh.h"
 
 //-----------------------------------------------------------------------------
-FENormalProjection::FENormalProjection(FESurface& s) : m_surf(s)
+FENormalProjection::FENormalProjection(FESurface& s) : m_surf(s), m_bvh(s.GetBVH())
 {
 	m_tol = 0.0;
 	m_rad = 0.0;
 }
 
 //-----------------------------------------------------------------------------
+// The search structure is stored on the surface, so that it only needs to be 
+// refitted when the surface moves.
 void FENormalProjection::Init()
 {
-	m_OT.Attach(&m_surf);
-	m_OT.Init(m_tol);
+	m_bvh.Update();
 }
 
 //-----------------------------------------------------------------------------
@@ -52,19 +53,14 @@ void FENormalProjection::Init()
 //!
 FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 {
-	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist);
-	
-	// now that we found candidate surface elements, lets see if we can find 
-	// those that intersect the ray, then pick the closest intersection
-	set<int>::iterator it;
+	// loop over all the candidate surface elements and see if we can find 
+	// those that intersect the ray, then pick the closest intersection.
+	// (Equal intersections are resolved in favor of the lowest element index.)
 	bool found = false;
 	double rsl[2], gl, g;
+	int jmin = -1;
 	FESurfaceElement* pei = 0;
-	for (it=selist.begin(); it!=selist.end(); ++it) {
-		// get the surface element
-		int j = *it;
+	m_bvh.FindRayCandidates(r, n, m_tol, [&](int j) {
 		// project the node on the element
 		FESurfaceElement* pe = &m_surf.Element(j);
 		if (m_surf.Intersect(*pe, r, n, rsl, gl, m_tol)) {
@@ -74,14 +70,16 @@ FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 				rs[0] = rsl[0];
 				rs[1] = rsl[1];
 				pei = pe;
-			} else if ((gl < g) && (gl > -m_rad)) {
+				jmin = j;
+			} else if (((gl < g) || ((gl == g) && (j < jmin))) && (gl > -m_rad)) {
 				g = gl;
 				rs[0] = rsl[0];
 				rs[1] = rsl[1];
 				pei = pe;
+				jmin = j;
 			}
 		}
-	}
+	});
 	if (found) return pei;
 	
 	// we did not find a surface
@@ -96,19 +94,14 @@ FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 //!
 FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 {
-	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist);
-	
-	// now that we found candidate surface elements, lets see if we can find 
+	// loop over all the candidate surface elements and see if we can find 
 	// those that intersect the ray, then pick the closest intersection
-	set<int>::iterator it;
+	// (Equal intersections are resolved in favor of the lowest element index.)
 	bool found = false;
 	double rsl[2], gl, g;
+	int jmin = -1;
 	FESurfaceElement* pei = 0;
-	for (it=selist.begin(); it!=selist.end(); ++it) {
-		// get the surface element
-		int j = *it;
+	m_bvh.FindRayCandidates(r, n, m_tol, [&](int j) {
 		FESurfaceElement* pe = &m_surf.Element(j);
 		// project the node on the element
 		if (m_surf.Intersect(*pe, r, n, rsl, gl, m_tol)) {
@@ -118,14 +111,16 @@ FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 				rs[0] = rsl[0];
 				rs[1] = rsl[1];
 				pei = pe;
-			} else if ((fabs(gl) < fabs(g)) && (fabs(gl) < m_rad)) {
+				jmin = j;
+			} else if (((fabs(gl) < fabs(g)) || ((fabs(gl) == fabs(g)) && (j < jmin))) && (fabs(gl) < m_rad)) {
 				g = gl;
 				rs[0] = rsl[0];
 				rs[1] = rsl[1];
 				pei = pe;
+				jmin = j;
 			}
 		}
-	}
+	});
 	if (found) return pei;
 	
 	// we did not find a surface
@@ -139,19 +134,13 @@ FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 //!
 FESurfaceElement* FENormalProjection::Project3(const vec3d& r, const vec3d& n, double rs[2], int* pei)
 {
-	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist);
-
 	double g, gmax = -1e99, r2[2] = {rs[0], rs[1]};
 	int imin = -1;
 	FESurfaceElement* pme = 0;
 
-	// loop over all surface element
-	set<int>::iterator it;
-	for (it = selist.begin(); it != selist.end(); ++it)
-	{
-		FESurfaceElement& el = m_surf.Element(*it);
+	// loop over all candidate surface elements
+	m_bvh.FindRayCandidates(r, n, m_tol, [&](int i) {
+		FESurfaceElement& el = m_surf.Element(i);
 
 		// see if the ray intersects this element
 		if (m_surf.Intersect(el, r, n, r2, g, m_tol))
@@ -160,18 +149,18 @@ FESurfaceElement* FENormalProjection::Project3(const vec3d& r, const vec3d& n, d
 			// TODO: should I put a limit on how small g can
 			//       be to be considered a valid intersection?
 //			if (g < gmin)
-			if (g > gmax)
+			if ((g > gmax) || ((g == gmax) && (i < imin)))
 			{
 				// keep results
 				pme = &el;
 //				gmin = g;
 				gmax = g;
-				imin = *it;
+				imin = i;
 				rs[0] = r2[0];
 				rs[1] = r2[1];
 			}
 		}	
-	}
+	});
 
 	if (pei) *pei = imin;
 
@@ -212,3 +201,18 @@ vec3d FENormalProjection::Project2(const vec3d& x, const vec3d& N)
 	}
 	else return x;
 }
+
+//-----------------------------------------------------------------------------
+void FENormalProjection::Project(const std::vector<vec3d>& r, const std::vector<vec3d>& n, std::vector<FESurfaceElement*>& pe, std::vector<vec2d>& rs)
+{
+	int N = (int)r.size();
+	pe.resize(N);
+	rs.resize(N);
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (int i = 0; i < N; ++i)
+	{
+		double q[2] = { 0, 0 };
+		pe[i] = Project(r[i], n[i], q);
+		rs[i] = vec2d(q[0], q[1]);
+	}
+}
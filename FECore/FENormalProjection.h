@@ -28,7 +28,6 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FEOctree.h"
 
 //-----------------------------------------------------------------------------
 //! This class calculates the normal projection on to a surface.
@@ -54,11 +53,14 @@ public:
 	vec3d Project(const vec3d& r, const vec3d& N);
 	vec3d Project2(const vec3d& r, const vec3d& N);
 
+	//! project a batch of rays (same as Project, but the rays are processed in parallel)
+	void Project(const std::vector<vec3d>& r, const std::vector<vec3d>& n, std::vector<FESurfaceElement*>& pe, std::vector<vec2d>& rs);
+
 private:
 	double	m_tol;	//!< projection tolerance
 	double	m_rad;	//!< search radius
 
 private:
-	FESurface&	m_surf;	//!< the target surface
-	FEOctree	m_OT;	//!< used to optimize ray-surface intersections
+	FESurface&		m_surf;	//!< the target surface
+	FESurfaceBVH&	m_bvh;	//!< used to optimize ray-surface intersections
 };
@@ -0,0 +1,190 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEPointLocator.h"
+#include "FEMesh.h"
+#include "FESolidDomain.h"
+
+//-----------------------------------------------------------------------------
+FEPointLocator::FEPointLocator(FEMesh* mesh) : m_mesh(mesh), m_octree(mesh)
+{
+	m_maxSteps = 64;
+}
+
+//-----------------------------------------------------------------------------
+bool FEPointLocator::Init()
+{
+	if (m_mesh == nullptr) return false;
+	FEMesh& mesh = *m_mesh;
+
+	// build the octree
+	if (m_octree.Init() == false) return false;
+
+	// build the element neighbour list
+	if (m_EEL.Create(m_mesh) == false) return false;
+
+	// collect the solid elements and evaluate their centers and bounding boxes
+	int NE = mesh.Elements();
+	m_elem.assign(NE, nullptr);
+	m_dom.assign(NE, nullptr);
+	m_c.assign(NE, vec3d(0, 0, 0));
+	m_box.resize(NE);
+	m_faces.assign(NE, 0);
+	int n = 0;
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		FESolidDomain* sdom = dynamic_cast<FESolidDomain*>(&dom);
+		for (int j = 0; j < dom.Elements(); ++j, ++n)
+		{
+			FEElement& el = dom.ElementRef(j);
+			m_faces[n] = el.Faces();
+			if (sdom == nullptr) continue;
+
+			m_elem[n] = &sdom->Element(j);
+			m_dom[n] = sdom;
+
+			int neln = el.Nodes();
+			vec3d c(0, 0, 0);
+			FEBoundingBox box(mesh.Node(el.m_node[0]).m_r0);
+			for (int k = 0; k < neln; ++k)
+			{
+				vec3d& rk = mesh.Node(el.m_node[k]).m_r0;
+				box.add(rk);
+				c += rk;
+			}
+			m_c[n] = c / neln;
+
+			// inflate a little for round-off
+			double dr = box.radius()*1e-6;
+			box.inflate(dr, dr, dr);
+			m_box[n] = box;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEPointLocator::IsInside(int n, const vec3d& x, double r[3])
+{
+	if ((m_elem[n] == nullptr) || (m_box[n].IsInside(x) == false)) return false;
+	return m_dom[n]->ProjectToReferenceElement(*m_elem[n], x, r);
+}
+
+//-----------------------------------------------------------------------------
+// Walk from element n towards the point x. At each step we move to the neighbour 
+// whose center is closest to x. When no neighbour is closer than the current element
+// we check all neighbours one last time before giving up.
+int FEPointLocator::Walk(int n, const vec3d& x, double r[3])
+{
+	for (int step = 0; step < m_maxSteps; ++step)
+	{
+		if (IsInside(n, x, r)) return n;
+
+		// find the neighbour closest to the point
+		double dmin = (m_c[n] - x).norm2();
+		int nmin = -1;
+		for (int j = 0; j < m_faces[n]; ++j)
+		{
+			int nj = m_EEL.NeighborIndex(n, j);
+			if ((nj >= 0) && m_elem[nj])
+			{
+				double d = (m_c[nj] - x).norm2();
+				if (d < dmin) { dmin = d; nmin = nj; }
+			}
+		}
+
+		if (nmin == -1)
+		{
+			// we're stuck, but the point may still be in one of the neighbours
+			for (int j = 0; j < m_faces[n]; ++j)
+			{
+				int nj = m_EEL.NeighborIndex(n, j);
+				if ((nj >= 0) && IsInside(nj, x, r)) return nj;
+			}
+			return -1;
+		}
+
+		n = nmin;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+int FEPointLocator::FindElement(const vec3d& x, double r[3], int hint)
+{
+	// try to walk there first
+	if ((hint >= 0) && (hint < (int)m_elem.size()) && m_elem[hint])
+	{
+		int n = Walk(hint, x, r);
+		if (n >= 0) return n;
+	}
+
+	// use the octree instead
+	FEElement* pe = m_octree.FindElement(x, r);
+	if (pe == nullptr) return -1;
+
+	// find the index of this element
+	int n = pe->GetLocalID();
+	FEDomain* dom = dynamic_cast<FEDomain*>(pe->GetMeshPartition());
+	for (int i = 0, offset = 0; i < m_mesh->Domains(); ++i)
+	{
+		FEDomain& di = m_mesh->Domain(i);
+		if (&di == dom) return offset + n;
+		offset += di.Elements();
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+void FEPointLocator::FindElements(const std::vector<vec3d>& x, std::vector<int>& elem, std::vector<vec3d>& r)
+{
+	int N = (int)x.size();
+	bool bwarm = (elem.size() == x.size());
+	if (bwarm == false) elem.assign(N, -1);
+	r.resize(N);
+
+	// Each thread processes a contiguous block of points, so that consecutive
+	// points can be used as starting points for each other.
+	#pragma omp parallel
+	{
+		int last = -1;
+		#pragma omp for schedule(static)
+		for (int i = 0; i < N; ++i)
+		{
+			int hint = (bwarm && (elem[i] >= 0) ? elem[i] : last);
+			double ri[3] = { 0 };
+			int n = FindElement(x[i], ri, hint);
+			elem[i] = n;
+			r[i] = vec3d(ri[0], ri[1], ri[2]);
+			if (n >= 0) last = n;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "FEOctreeSearch.h"
+#include "FEElemElemList.h"
+#include "FEBoundingBox.h"
+#include <vector>
+
+class FEMesh;
+class FESolidElement;
+class FESolidDomain;
+
+//-----------------------------------------------------------------------------
+//! This class locates points in the solid elements of a mesh (in the reference
+//! configuration). Each search starts from a given element (e.g. the element that 
+//! contained the point during the previous search, or the element of a neighbouring
+//! point) and walks through the element neighbours towards the point. If the walk
+//! does not find the point (e.g. when the point lies across a concave boundary) 
+//! the octree search is used instead. 
+//! Elements are identified by their index in the mesh (i.e. in the order of FEElementList).
+class FECORE_API FEPointLocator
+{
+public:
+	FEPointLocator(FEMesh* mesh);
+
+	//! initialize search structures
+	bool Init();
+
+	//! Find the element that contains the point x, starting from the element with index hint 
+	//! (or the octree if hint is -1). Returns the element index (or -1 if the point is not 
+	//! found) and the isoparametric coordinates of the point.
+	int FindElement(const vec3d& x, double r[3], int hint = -1);
+
+	//! Locate a batch of points in parallel. On input, elem contains the elements to start 
+	//! each search from (or -1). If elem is empty, the result of the previous point is used 
+	//! as the starting element. On output, elem contains the element indices (or -1) and r 
+	//! the isoparametric coordinates.
+	void FindElements(const std::vector<vec3d>& x, std::vector<int>& elem, std::vector<vec3d>& r);
+
+	//! return the element with the given index
+	FESolidElement* Element(int n) { return m_elem[n]; }
+
+	//! set the max number of elements visited in a walk before using the octree
+	void SetMaxSteps(int n) { m_maxSteps = n; }
+
+protected:
+	//! see if the point is inside element n
+	bool IsInside(int n, const vec3d& x, double r[3]);
+
+	//! walk from element n towards the point x
+	int Walk(int n, const vec3d& x, double r[3]);
+
+protected:
+	FEMesh*			m_mesh;
+	FEOctreeSearch	m_octree;		//!< octree for the fallback search
+	FEElemElemList	m_EEL;			//!< element neighbour list
+	int				m_maxSteps;		//!< max nr of elements visited in a walk
+
+	std::vector<FESolidElement*>	m_elem;	//!< solid elements (or null for other elements)
+	std::vector<FESolidDomain*>		m_dom;	//!< domain of each element
+	std::vector<vec3d>				m_c;	//!< element centers
+	std::vector<FEBoundingBox>		m_box;	//!< element bounding boxes
+	std::vector<int>				m_faces;//!< nr of neighbours of each element
+};
@@ -41,6 +41,9 @@ FESolidDomain::FESolidDomain(FEModel* pfem) : FEDomain(FE_DOMAIN_SOLID, pfem), m
     m_dofSU.AddDof(pfem->GetDOFIndex("sx"));
 	m_dofSU.AddDof(pfem->GetDOFIndex("sy"));
 	m_dofSU.AddDof(pfem->GetDOFIndex("sz"));
+
+	m_bG0cache = false;
+	m_G0maxBytes = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -48,6 +51,7 @@ bool FESolidDomain::Create(int nsize, FE_Element_Spec espec)
 {
 	// allocate elements
     m_Elem.resize(nsize);
+	m_ip0.clear();
 	for (int i = 0; i < nsize; ++i)
 	{
 		FESolidElement& el = m_Elem[i];
@@ -83,6 +87,7 @@ void FESolidDomain::CopyFrom(FEMeshPartition* pd)
     FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pd);
     m_Elem = psd->m_Elem;
 	ForEachElement([=](FEElement& el) { el.SetMeshPartition(this); });
+	m_ip0.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -92,6 +97,12 @@ bool FESolidDomain::Init()
 	// base class first
 	if (FEDomain::Init() == false) return false;
 
+	// the cache is rebuilt below
+	m_G0.clear();
+	m_detJ0.clear();
+	m_ip0.clear();
+	m_G00.clear();
+
 	// init solid element data
 	// TODO: In principle I could parallelize this, but right now this cannot be done
 	//       because of the try block. 
@@ -132,9 +143,96 @@ bool FESolidDomain::Init()
 		return false;
 	}
 
+	// build the cache of reference gradients
+	if (m_bG0cache) BuildReferenceGradientCache();
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void FESolidDomain::SetReferenceGradientCache(bool b, size_t maxBytes)
+{
+	m_bG0cache = b;
+	m_G0maxBytes = maxBytes;
+	if (b == false)
+	{
+		vector<vec3d>().swap(m_G0);
+		vector<double>().swap(m_detJ0);
+		vector<size_t>().swap(m_ip0);
+		vector<size_t>().swap(m_G00);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// The gradients of all integration points of an element are stored contiguously
+// (integration point by integration point), and the elements follow each other.
+// This is called from Init, after the reference Jacobians have been evaluated.
+void FESolidDomain::BuildReferenceGradientCache()
+{
+	int NE = Elements();
+
+	// figure out how much memory we need
+	// (the gradient count of a large domain can overflow an int)
+	vector<size_t> ip0(NE + 1), G00(NE + 1);
+	ip0[0] = G00[0] = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		ip0[i + 1] = ip0[i] + (size_t)el.GaussPoints();
+		G00[i + 1] = G00[i] + (size_t)el.GaussPoints()*(size_t)el.Nodes();
+	}
+	size_t nbytes = G00[NE]*sizeof(vec3d) + ip0[NE]*sizeof(double) + 2*(size_t)(NE + 1)*sizeof(size_t);
+	if ((m_G0maxBytes > 0) && (nbytes > m_G0maxBytes))
+	{
+		feLogWarning("Reference gradient cache of domain %s needs %.1lf MB. It will not be used.", GetName().c_str(), nbytes / 1048576.0);
+		return;
+	}
+
+	vector<vec3d> G0(G00[NE]);
+	vector<double> detJ0(ip0[NE]);
+
+	#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int neln = el.Nodes();
+		int nint = el.GaussPoints();
+		for (int n = 0; n < nint; ++n)
+		{
+			// the inverse reference Jacobian was already evaluated in Init
+			const mat3d& Ji = el.m_J0i[n];
+			detJ0[ip0[i] + n] = el.GetMaterialPoint(n)->m_J0;
+
+			vec3d* G = &G0[G00[i] + (size_t)n*neln];
+			const double* Gr = el.Gr(n);
+			const double* Gs = el.Gs(n);
+			const double* Gt = el.Gt(n);
+			for (int j = 0; j < neln; ++j)
+			{
+				// note that we need the transposed of Ji, not Ji itself !
+				G[j].x = Ji[0][0] * Gr[j] + Ji[1][0] * Gs[j] + Ji[2][0] * Gt[j];
+				G[j].y = Ji[0][1] * Gr[j] + Ji[1][1] * Gs[j] + Ji[2][1] * Gt[j];
+				G[j].z = Ji[0][2] * Gr[j] + Ji[1][2] * Gs[j] + Ji[2][2] * Gt[j];
+			}
+		}
+	}
+
+	m_G0.swap(G0);
+	m_detJ0.swap(detJ0);
+	m_ip0.swap(ip0);
+	m_G00.swap(G00);
+}
+
+//-----------------------------------------------------------------------------
+const vec3d* FESolidDomain::ReferenceShapeGradient(const FESolidElement& el, int n, double& detJ0) const
+{
+	if (m_ip0.empty() || (el.GetMeshPartition() != this)) return nullptr;
+	int i = el.GetLocalID();
+	assert((i >= 0) && (i < (int)m_ip0.size() - 1));
+	detJ0 = m_detJ0[m_ip0[i] + n];
+	return &m_G0[m_G00[i] + (size_t)n*el.Nodes()];
+}
+
 //-----------------------------------------------------------------------------
 // Reset data
 void FESolidDomain::Reset()
@@ -1025,6 +1123,16 @@ double FESolidDomain::defgradp(FESolidElement &el, mat3d &F, int n)
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjac0(const FESolidElement& el, double Ji[3][3], int n)
 {
+	// see if we can use the cache (which also implies that m_J0i is valid)
+	double detJ0;
+	if (ReferenceShapeGradient(el, n, detJ0))
+	{
+		const mat3d& J0i = el.m_J0i[n];
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j) Ji[i][j] = J0i[i][j];
+		return detJ0;
+	}
+
     // nodal coordinates
     vec3d r0[FEElement::MAX_NODES];
 	GetReferenceNodalCoordinates(el, r0);
@@ -2246,6 +2354,16 @@ double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH, con
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient0(FESolidElement& el, int n, vec3d* GradH)
 {
+	// see if the gradients are cached
+	double J0;
+	const vec3d* G0 = ReferenceShapeGradient(el, n, J0);
+	if (G0)
+	{
+		int ne = el.Nodes();
+		for (int i = 0; i < ne; ++i) GradH[i] = G0[i];
+		return J0;
+	}
+
     // calculate jacobian
     double Ji[3][3];
     double detJ0 = invjac0(el, Ji, n);
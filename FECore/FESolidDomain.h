@@ -111,6 +111,14 @@ public:
     
     //! calculate inverse jacobian matrix w.r.t. reference frame
     double invjac0(const FESolidElement& el, double J[3][3], int n);
+
+	//! Enable the cache of the reference shape function gradients and Jacobians.
+	//! The cache is built in Init, unless it would need more than maxBytes.
+	void SetReferenceGradientCache(bool b, size_t maxBytes = 0);
+
+	//! Get the cached reference shape function gradients at integration point n
+	//! and the reference Jacobian in detJ0. Returns null if the cache is not used.
+	const vec3d* ReferenceShapeGradient(const FESolidElement& el, int n, double& detJ0) const;
     
     //! calculate inverse jacobian matrix w.r.t. reference frame
     double invjac0(const FESolidElement& el, double J[3][3], double r, double s, double t);
@@ -267,9 +275,20 @@ public:
 		FEVolumeMatrixIntegrand f	// the matrix function to evaluate
 	);
 
+protected:
+	void BuildReferenceGradientCache();
+
 protected:
     vector<FESolidElement>	m_Elem;		//!< array of elements
 
+	// cache of reference shape function gradients (see SetReferenceGradientCache)
+	bool			m_bG0cache;		//!< use the cache
+	size_t			m_G0maxBytes;	//!< memory budget for the cache (0 = no limit)
+	vector<vec3d>	m_G0;			//!< shape function gradients of all integration points
+	vector<double>	m_detJ0;		//!< reference Jacobians of all integration points
+	vector<size_t>	m_ip0;			//!< first integration point of each element
+	vector<size_t>	m_G00;			//!< first gradient of each element
+
 	FEDofList	m_dofU;
 	FEDofList	m_dofSU;
 };
@@ -0,0 +1,79 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FESolutionHistory.h"
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FESolutionHistory::FESolutionHistory()
+{
+}
+
+//-----------------------------------------------------------------------------
+void FESolutionHistory::Clear()
+{
+	m_data.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FESolutionHistory::Add(double t, const std::vector<double>& U)
+{
+	// If a time step was redone, the newer solution replaces the old one. 
+	while ((m_data.empty() == false) && (m_data.back().time >= t)) m_data.pop_back();
+
+	Entry e;
+	e.time = t;
+	e.U = U;
+	m_data.push_back(e);
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<double>* FESolutionHistory::Find(double t) const
+{
+	// find the first entry that is not before t
+	int N = (int)m_data.size();
+	int n0 = 0, n1 = N;
+	while (n0 < n1)
+	{
+		int m = (n0 + n1) / 2;
+		if (m_data[m].time < t) n0 = m + 1; else n1 = m;
+	}
+
+	// The time points of two runs will only match up to round-off, so we 
+	// compare with a tolerance relative to the spacing of the time points.
+	const double eps = 1e-9;
+	for (int i = n0 - 1; i <= n0; ++i)
+	{
+		if ((i < 0) || (i >= N)) continue;
+		double dt = (i > 0 ? m_data[i].time - m_data[i - 1].time : fabs(m_data[i].time));
+		if (fabs(m_data[i].time - t) <= eps*(dt > 0 ? dt : 1.0)) return &m_data[i].U;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,64 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! This class stores the converged solution vectors of a run, one for each
+//! time point. Its main use is to provide a good initial guess for the time steps 
+//! of a run that follows almost the same trajectory, e.g. a run with slightly 
+//! perturbed model parameters (see FENewtonSolver::SetInitialGuess).
+class FECORE_API FESolutionHistory
+{
+	struct Entry
+	{
+		double				time;	// time point
+		std::vector<double>	U;		// total solution vector at this time
+	};
+
+public:
+	FESolutionHistory();
+
+	//! remove all entries
+	void Clear();
+
+	//! store the solution at time t
+	//! (entries are expected to be added in order of increasing time)
+	void Add(double t, const std::vector<double>& U);
+
+	//! find the solution for time t. Returns null if there is none.
+	const std::vector<double>* Find(double t) const;
+
+	//! number of stored time points
+	int Size() const { return (int)m_data.size(); }
+
+private:
+	std::vector<Entry>	m_data;
+};
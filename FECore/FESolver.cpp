@@ -112,6 +112,14 @@ void FESolver::Clean()
 {
 }
 
+//-----------------------------------------------------------------------------
+// Update the solver after a local change of the mesh. 
+// By default, solvers need to be reinitialized.
+bool FESolver::Reinit(const FEMeshChangeSet& changes)
+{
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 // get the linear solver
 LinearSolver* FESolver::GetLinearSolver()
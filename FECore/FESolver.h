@@ -75,6 +75,7 @@ class FEModel;
 class FEGlobalMatrix;
 class LinearSolver;
 class FEGlobalVector;
+class FEMeshChangeSet;
 
 //-----------------------------------------------------------------------------
 //! This is the base class for all FE solvers.
@@ -100,6 +101,11 @@ public:
 	//! This is called by FEAnalaysis::Deactivate
 	virtual void Clean();
 
+	//! Update the solver after a local change of the mesh (see FEMeshAdaptor).
+	//! Returns false if the solver could not be updated, in which case the 
+	//! solver must be cleaned and initialized again.
+	virtual bool Reinit(const FEMeshChangeSet& changes);
+
 	//! rewind the solver (This is called when the time step fails and needs to retry)
 	virtual void Rewind() {}
 
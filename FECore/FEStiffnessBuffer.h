@@ -0,0 +1,69 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "SparseMatrix.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! This class collects contributions to the global stiffness matrix and the 
+//! RHS vector, so that these can be evaluated concurrently (each thread fills its own 
+//! buffer) and added to the global system at once afterwards (see FELinearSystem).
+class FEStiffnessBuffer
+{
+	struct ENTRY
+	{
+		int		i, j;
+		double	v;
+	};
+
+public:
+	// add a value to the stiffness matrix
+	void Add(int i, int j, double v) { ENTRY e = { i, j, v }; m_K.push_back(e); }
+
+	// add a value to the RHS vector
+	void AddRHS(int i, double v) { m_F.push_back(std::pair<int, double>(i, v)); }
+
+	// assemble the buffered values into the global stiffness matrix and RHS vector,
+	// and clear the buffer
+	void Assemble(SparseMatrix& K, std::vector<double>& F)
+	{
+		for (size_t n = 0; n < m_K.size(); ++n) K.add(m_K[n].i, m_K[n].j, m_K[n].v);
+		for (size_t n = 0; n < m_F.size(); ++n) F[m_F[n].first] += m_F[n].second;
+		Clear();
+	}
+
+	// clear the buffer (this does not release the memory)
+	void Clear() { m_K.clear(); m_F.clear(); }
+
+	// see if the buffer is empty
+	bool IsEmpty() const { return (m_K.empty() && m_F.empty()); }
+
+private:
+	std::vector<ENTRY>						m_K;
+	std::vector< std::pair<int, double> >	m_F;
+};
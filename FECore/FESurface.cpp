@@ -41,6 +41,7 @@ FESurface::FESurface(FEModel* fem) : FEMeshPartition(FE_DOMAIN_SURFACE, fem)
 	m_bitfc = false;
 	m_alpha = 1;
 	m_bshellb = false;
+	m_bvh.Attach(this);
 }
 
 //-----------------------------------------------------------------------------
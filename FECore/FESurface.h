@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include "FENodeSet.h"
 #include "FEDofList.h"
 #include "FESurfaceElement.h"
+#include "FESurfaceBVH.h"
 
 //-----------------------------------------------------------------------------
 class FEMesh;
@@ -243,6 +244,10 @@ public:
 	//! Get the facet set that created this surface
 	FEFacetSet* GetFacetSet() { return m_surf; }
 
+	//! Get the bounding volume hierarchy of the facets (call Update before use)
+	FESurfaceBVH& GetBVH() { return m_bvh; }
+	const FESurfaceBVH& GetBVH() const { return m_bvh; }
+
 public:
 	// Get nodal reference coordinates 
 	void GetReferenceNodalCoordinates(FESurfaceElement& el, vec3d* r0);
@@ -289,4 +294,5 @@ protected:
     bool                        m_bitfc;    //!< interface status
     double                      m_alpha;    //!< intermediate time fraction
 	bool						m_bshellb;	//!< true if this surface is the bottom of a shell domain
+	FESurfaceBVH				m_bvh;		//!< facet hierarchy for contact searches
 };
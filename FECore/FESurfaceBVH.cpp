@@ -0,0 +1,448 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FESurfaceBVH.h"
+#include "FESurface.h"
+#include "FEMesh.h"
+#include <algorithm>
+#include <float.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// helper class for sorting facets along an axis
+class FacetCompare
+{
+public:
+	FacetCompare(const vector<vec3d>& c, int axis) : m_c(c), m_axis(axis) {}
+
+	bool operator () (int a, int b) const
+	{
+		const vec3d& ca = m_c[a];
+		const vec3d& cb = m_c[b];
+		switch (m_axis)
+		{
+		case 0: return ca.x < cb.x;
+		case 1: return ca.y < cb.y;
+		}
+		return ca.z < cb.z;
+	}
+
+private:
+	const vector<vec3d>&	m_c;
+	int						m_axis;
+};
+
+//-----------------------------------------------------------------------------
+// helper function for merging two boxes
+static void MergeBox(FESurfaceBVH::BOX& a, const FESurfaceBVH::BOX& b)
+{
+	if (b.r0.x < a.r0.x) a.r0.x = b.r0.x;
+	if (b.r0.y < a.r0.y) a.r0.y = b.r0.y;
+	if (b.r0.z < a.r0.z) a.r0.z = b.r0.z;
+	if (b.r1.x > a.r1.x) a.r1.x = b.r1.x;
+	if (b.r1.y > a.r1.y) a.r1.y = b.r1.y;
+	if (b.r1.z > a.r1.z) a.r1.z = b.r1.z;
+}
+
+//-----------------------------------------------------------------------------
+// helper function for the component-wise maximum of two vectors
+static void MaxVector(vec3d& a, const vec3d& b)
+{
+	if (b.x > a.x) a.x = b.x;
+	if (b.y > a.y) a.y = b.y;
+	if (b.z > a.z) a.z = b.z;
+}
+
+//-----------------------------------------------------------------------------
+FESurfaceBVH::FESurfaceBVH(FESurface* ps)
+{
+	m_ps = ps;
+	m_area0 = 0.0;
+	m_rebuildRatio = 2.0;
+	m_nbuilds = 0;
+	m_nrefits = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Attach(FESurface* ps)
+{
+	if (ps != m_ps) Clear();
+	m_ps = ps;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Clear()
+{
+	m_node.clear();
+	m_fac.clear();
+	m_fbox.clear();
+	m_ftype.clear();
+	m_area0 = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// Build the tree if it does not exist yet or the surface changed, otherwise
+// the existing tree is refitted. If refitting made the boxes too loose, the 
+// tree is rebuilt after all.
+void FESurfaceBVH::Update()
+{
+	assert(m_ps);
+	if (m_node.empty() || ((int)m_fbox.size() != m_ps->Elements())) Build();
+	else
+	{
+		Refit();
+		if ((m_area0 > 0.0) && (TotalArea() > m_rebuildRatio*m_area0)) Build();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Build the tree by recursively splitting the facets at the median of their 
+// centroids along the longest axis. The resulting tree is balanced so its depth
+// grows with the logarithm of the number of facets.
+void FESurfaceBVH::Build()
+{
+	assert(m_ps);
+	Clear();
+
+	int NF = m_ps->Elements();
+	if (NF == 0) return;
+
+	// calculate the facet boxes and centroids
+	UpdateFacetBoxes();
+	vector<vec3d> c(NF);
+	for (int i = 0; i < NF; ++i) c[i] = (m_fbox[i].r0 + m_fbox[i].r1)*0.5;
+
+	m_fac.resize(NF);
+	for (int i = 0; i < NF; ++i) m_fac[i] = i;
+
+	// create the root
+	NODE root;
+	root.nchild = -1;
+	root.nfirst = 0;
+	root.ncount = NF;
+	m_node.reserve(2*(NF / MAX_LEAF_SIZE) + 1);
+	m_node.push_back(root);
+
+	// split nodes until the leaves are small enough
+	vector<int> work;
+	work.push_back(0);
+	while (work.empty() == false)
+	{
+		int ni = work.back(); work.pop_back();
+		int n0 = m_node[ni].nfirst;
+		int nc = m_node[ni].ncount;
+		if (nc <= MAX_LEAF_SIZE) continue;
+
+		// find the longest axis of the centroid bounds
+		vec3d cmin = c[m_fac[n0]], cmax = cmin;
+		for (int i = 1; i < nc; ++i)
+		{
+			const vec3d& ci = c[m_fac[n0 + i]];
+			if (ci.x < cmin.x) cmin.x = ci.x;
+			if (ci.x > cmax.x) cmax.x = ci.x;
+			if (ci.y < cmin.y) cmin.y = ci.y;
+			if (ci.y > cmax.y) cmax.y = ci.y;
+			if (ci.z < cmin.z) cmin.z = ci.z;
+			if (ci.z > cmax.z) cmax.z = ci.z;
+		}
+		vec3d d = cmax - cmin;
+		int axis = 0;
+		if ((d.y > d.x) && (d.y >= d.z)) axis = 1;
+		else if ((d.z > d.x) && (d.z > d.y)) axis = 2;
+
+		// split at the median
+		int nmid = nc / 2;
+		vector<int>::iterator it = m_fac.begin() + n0;
+		nth_element(it, it + nmid, it + nc, FacetCompare(c, axis));
+
+		NODE left, right;
+		left.nchild = right.nchild = -1;
+		left.nfirst = n0; left.ncount = nmid;
+		right.nfirst = n0 + nmid; right.ncount = nc - nmid;
+
+		int nchild = (int)m_node.size();
+		m_node[ni].nchild = nchild;
+		m_node.push_back(left);
+		m_node.push_back(right);
+
+		work.push_back(nchild);
+		work.push_back(nchild + 1);
+	}
+
+	// calculate the node boxes
+	RefitNodes();
+
+	m_area0 = TotalArea();
+	m_nbuilds++;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Refit()
+{
+	assert(m_ps);
+	if (m_node.empty()) return;
+	UpdateFacetBoxes();
+	RefitNodes();
+	m_nrefits++;
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the bounding boxes of the facets from the current nodal positions.
+// Shell bottom surfaces are intersected at the shell bottom positions but their
+// nearest nodes are searched at the nodal positions, so the boxes cover both.
+void FESurfaceBVH::UpdateFacetBoxes()
+{
+	FEMesh& mesh = *m_ps->GetMesh();
+	bool bshellb = m_ps->IsShellBottom();
+	int NF = m_ps->Elements();
+	m_fbox.resize(NF);
+	m_ftype.resize(NF);
+
+	#pragma omp parallel for
+	for (int i = 0; i < NF; ++i)
+	{
+		FESurfaceElement& el = m_ps->Element(i);
+		BOX& b = m_fbox[i];
+		b.r0 = b.r1 = mesh.Node(el.m_node[0]).m_rt;
+		int neln = el.Nodes();
+		for (int j = 0; j < neln; ++j)
+		{
+			FENode& node = mesh.Node(el.m_node[j]);
+			vec3d r[2] = { node.m_rt, (bshellb ? node.m_st() : node.m_rt) };
+			for (int k = 0; k < 2; ++k)
+			{
+				if (r[k].x < b.r0.x) b.r0.x = r[k].x;
+				if (r[k].x > b.r1.x) b.r1.x = r[k].x;
+				if (r[k].y < b.r0.y) b.r0.y = r[k].y;
+				if (r[k].y > b.r1.y) b.r1.y = r[k].y;
+				if (r[k].z < b.r0.z) b.r0.z = r[k].z;
+				if (r[k].z > b.r1.z) b.r1.z = r[k].z;
+			}
+		}
+
+		switch (neln)
+		{
+		case 8 : m_ftype[i] = FACET_QUAD8; break;
+		case 9 : m_ftype[i] = FACET_QUAD9; break;
+		default: m_ftype[i] = FACET_LINEAR;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the node boxes from the facet boxes. Children are always stored
+// after their parent, so a reverse sweep visits the children first.
+void FESurfaceBVH::RefitNodes()
+{
+	for (int i = (int)m_node.size() - 1; i >= 0; --i)
+	{
+		NODE& node = m_node[i];
+		if (node.nchild >= 0)
+		{
+			const NODE& c0 = m_node[node.nchild];
+			const NODE& c1 = m_node[node.nchild + 1];
+			node.box = c0.box;
+			MergeBox(node.box, c1.box);
+			for (int k = 0; k < FACET_TYPES; ++k)
+			{
+				node.h[k] = c0.h[k];
+				MaxVector(node.h[k], c1.h[k]);
+			}
+		}
+		else
+		{
+			for (int k = 0; k < FACET_TYPES; ++k) node.h[k] = vec3d(0, 0, 0);
+			for (int j = 0; j < node.ncount; ++j)
+			{
+				int nf = m_fac[node.nfirst + j];
+				const BOX& b = m_fbox[nf];
+				if (j == 0) node.box = b; else MergeBox(node.box, b);
+
+				MaxVector(node.h[(int)m_ftype[nf]], (b.r1 - b.r0)*0.5);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// sum of the (half) surface areas of all node boxes. This measures the quality
+// of the tree, since it is proportional to the expected number of visited nodes.
+double FESurfaceBVH::TotalArea() const
+{
+	double A = 0.0;
+	for (size_t i = 0; i < m_node.size(); ++i)
+	{
+		vec3d d = m_node[i].box.r1 - m_node[i].box.r0;
+		A += d.x*d.y + d.y*d.z + d.z*d.x;
+	}
+	return A;
+}
+
+//-----------------------------------------------------------------------------
+// FESurface::Intersect accepts points at facet coordinates slightly outside the
+// facet (up to the tolerance tol). Such a point is a combination of the facet's 
+// nodes with weights whose absolute values sum to at most L, so it lies within 
+// L times the half extents of the facet box from the box center. This calculates
+// the padding factors L-1 (relative to the half extents) for each category:
+// - linear: tri3, quad4, tri6 and tri7 facets are only accepted if the ray 
+//   crosses a (flat) sub-triangle with barycentric coordinates >= -tol, so L = 1 + 4*tol.
+// - quad9: L is the square of the 1D bound max(1.25, 2*a^2 - 1), with a = 1 + tol.
+// - quad8: the serendipity facet equals a quad9 facet whose center node lies 
+//   within three half extents of the box center, which adds 2*max(1, a^2 - 1)^2.
+void FESurfaceBVH::PaddingFactors(double tol, double f[FACET_TYPES])
+{
+	if (tol < 0.0) tol = 0.0;
+	double a = 1.0 + tol;
+	double L1 = 2.0*a*a - 1.0; if (L1 < 1.25) L1 = 1.25;
+	double c = a*a - 1.0; if (c < 1.0) c = 1.0;
+	double L9 = L1*L1;
+	double L8 = L9 + 2.0*c*c;
+
+	f[FACET_LINEAR] = 4.0*tol;
+	f[FACET_QUAD9 ] = L9 - 1.0;
+	f[FACET_QUAD8 ] = L8 - 1.0;
+}
+
+//-----------------------------------------------------------------------------
+// Check if the (infinite) line through p with direction n crosses the box, 
+// enlarged by the padding d. A small fraction of the box diagonal is added to 
+// cover round-off and the residual of the Newton iterations in FESurface::Intersect.
+bool FESurfaceBVH::LineIntersectsBox(const BOX& b, const vec3d& pad, const vec3d& p, const vec3d& n)
+{
+	double e = 1e-6*(b.r1 - b.r0).norm();
+	vec3d d = pad + vec3d(e, e, e);
+	double lo[3] = { b.r0.x - d.x, b.r0.y - d.y, b.r0.z - d.z };
+	double hi[3] = { b.r1.x + d.x, b.r1.y + d.y, b.r1.z + d.z };
+	double pa[3] = { p.x, p.y, p.z };
+	double na[3] = { n.x, n.y, n.z };
+
+	double tmin = -DBL_MAX, tmax = DBL_MAX;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (na[i] == 0.0)
+		{
+			if ((pa[i] < lo[i]) || (pa[i] > hi[i])) return false;
+		}
+		else
+		{
+			double t0 = (lo[i] - pa[i]) / na[i];
+			double t1 = (hi[i] - pa[i]) / na[i];
+			if (t0 > t1) { double t = t0; t0 = t1; t1 = t; }
+			if (t0 > tmin) tmin = t0;
+			if (t1 < tmax) tmax = t1;
+			if (tmin > tmax) return false;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// squared distance from a point to a box (zero if the point is inside)
+double FESurfaceBVH::BoxDistance2(const BOX& b, const vec3d& x)
+{
+	double dx = (x.x < b.r0.x ? b.r0.x - x.x : (x.x > b.r1.x ? x.x - b.r1.x : 0.0));
+	double dy = (x.y < b.r0.y ? b.r0.y - x.y : (x.y > b.r1.y ? x.y - b.r1.y : 0.0));
+	double dz = (x.z < b.r0.z ? b.r0.z - x.z : (x.z > b.r1.z ? x.z - b.r1.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+// Find the closest node by a depth-first search that visits the closer child
+// first and skips all nodes whose box is farther away than the best node so far.
+// If two nodes are equally close, the one with the lowest index is returned.
+int FESurfaceBVH::FindNearestNode(const vec3d& x, int iguess, int nskip) const
+{
+	if (m_node.empty()) return -1;
+
+	int imin = -1;
+	double dmin = DBL_MAX;
+	if ((iguess >= 0) && (iguess < m_ps->Nodes()) && (m_ps->NodeIndex(iguess) != nskip))
+	{
+		vec3d r = m_ps->Node(iguess).m_rt;
+		imin = iguess;
+		dmin = (r - x)*(r - x);
+	}
+
+	int stack[MAX_DEPTH];
+	int nstack = 0;
+	stack[nstack++] = 0;
+	while (nstack > 0)
+	{
+		const NODE& node = m_node[stack[--nstack]];
+		if (BoxDistance2(node.box, x) > dmin) continue;
+
+		if (node.nchild >= 0)
+		{
+			// push the farther child first, so that the closer one is visited first
+			double d0 = BoxDistance2(m_node[node.nchild].box, x);
+			double d1 = BoxDistance2(m_node[node.nchild + 1].box, x);
+			if (d0 <= d1)
+			{
+				stack[nstack++] = node.nchild + 1;
+				stack[nstack++] = node.nchild;
+			}
+			else
+			{
+				stack[nstack++] = node.nchild;
+				stack[nstack++] = node.nchild + 1;
+			}
+		}
+		else
+		{
+			for (int i = 0; i < node.ncount; ++i)
+			{
+				const FESurfaceElement& el = m_ps->Element(m_fac[node.nfirst + i]);
+				int neln = el.Nodes();
+				for (int j = 0; j < neln; ++j)
+				{
+					int l = el.m_lnode[j];
+					if ((nskip >= 0) && (el.m_node[j] == nskip)) continue;
+					vec3d r = m_ps->Node(l).m_rt;
+					double d = (r - x)*(r - x);
+					if ((d < dmin) || ((d == dmin) && (l < imin)))
+					{
+						dmin = d;
+						imin = l;
+					}
+				}
+			}
+		}
+	}
+
+	return imin;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::FindNearestNodes(const vector<vec3d>& x, vector<int>& nodes) const
+{
+	int N = (int)x.size();
+	nodes.resize(N);
+	#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < N; ++i) nodes[i] = FindNearestNode(x[i]);
+}
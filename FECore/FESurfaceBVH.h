@@ -0,0 +1,176 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "vec3d.h"
+#include <vector>
+#include "fecore_api.h"
+
+class FESurface;
+
+//-----------------------------------------------------------------------------
+//! Bounding volume hierarchy over the facets of a surface. This is used as the
+//! broad phase of the contact search. The tree is built once and afterwards
+//! only its boxes are refitted to the current nodal positions. It is rebuilt
+//! when the topology of the surface changes or when the refitted boxes have
+//! become too loose. The queries do not allocate and can be called from
+//! multiple threads simultaneously. Since the queries use the boxes of the last
+//! update, Update must be called (serially) before each pass of queries.
+class FECORE_API FESurfaceBVH
+{
+public:
+	// max depth of the tree (also the size of the query stacks)
+	enum { MAX_DEPTH = 64 };
+
+	// max number of facets in a leaf
+	enum { MAX_LEAF_SIZE = 4 };
+
+	// Facet categories. These differ in how far a point that FESurface::Intersect
+	// accepts can lie outside of the bounding box of the facet's nodes.
+	enum { FACET_LINEAR, FACET_QUAD8, FACET_QUAD9, FACET_TYPES };
+
+	struct BOX
+	{
+		vec3d	r0;	//!< lower corner
+		vec3d	r1;	//!< upper corner
+	};
+
+	struct NODE
+	{
+		BOX		box;		//!< bounding box of this node
+		vec3d	h[FACET_TYPES];	//!< max half extents of the facet boxes in this node, per category
+		int		nchild;		//!< index of first child (second child is nchild+1), or -1 for leaves
+		int		nfirst;		//!< first facet (into facet list)
+		int		ncount;		//!< number of facets
+	};
+
+public:
+	FESurfaceBVH(FESurface* ps = 0);
+
+	//! attach to a surface
+	void Attach(FESurface* ps);
+
+	//! Build or refit the tree to the current configuration
+	void Update();
+
+	//! Build the tree from scratch
+	void Build();
+
+	//! refit the boxes to the current nodal positions
+	void Refit();
+
+	//! clear all data
+	void Clear();
+
+	//! Set the ratio of refitted over built box area that triggers a rebuild
+	void SetRebuildRatio(double r) { m_rebuildRatio = r; }
+
+	//! number of times the tree was built
+	int Builds() const { return m_nbuilds; }
+
+	//! number of times the tree was refitted
+	int Refits() const { return m_nrefits; }
+
+public:
+	//! Call f(i) for all facets i that the line through p with direction n may
+	//! intersect with FESurface::Intersect for the tolerance tol. The facet boxes
+	//! are enlarged just enough that no such facet is missed.
+	template <class F> void FindRayCandidates(const vec3d& p, const vec3d& n, double tol, F f) const;
+
+	//! find the surface node (local index) closest to x. The node iguess, if
+	//! valid, is used as the initial guess. The mesh node nskip is excluded from the search.
+	int FindNearestNode(const vec3d& x, int iguess = -1, int nskip = -1) const;
+
+	//! Find the nearest nodes for a batch of points
+	void FindNearestNodes(const std::vector<vec3d>& x, std::vector<int>& nodes) const;
+
+protected:
+	void UpdateFacetBoxes();
+	void RefitNodes();
+	double TotalArea() const;
+
+	static void PaddingFactors(double tol, double f[FACET_TYPES]);
+	static bool LineIntersectsBox(const BOX& b, const vec3d& pad, const vec3d& p, const vec3d& n);
+	static double BoxDistance2(const BOX& b, const vec3d& x);
+
+protected:
+	FESurface*			m_ps;		//!< the surface
+	std::vector<NODE>	m_node;		//!< tree nodes (the root is the first node)
+	std::vector<int>	m_fac;		//!< facet list (the leaves point into this list)
+	std::vector<BOX>	m_fbox;		//!< facet bounding boxes
+	std::vector<char>	m_ftype;	//!< facet categories
+
+	double	m_area0;			//!< total box area after last build
+	double	m_rebuildRatio;		//!< area ratio that triggers a rebuild
+	int		m_nbuilds;			//!< build counter
+	int		m_nrefits;			//!< refit counter
+};
+
+//-----------------------------------------------------------------------------
+template <class F> void FESurfaceBVH::FindRayCandidates(const vec3d& p, const vec3d& n, double tol, F f) const
+{
+	if (m_node.empty()) return;
+
+	double fac[FACET_TYPES];
+	PaddingFactors(tol, fac);
+
+	int stack[MAX_DEPTH];
+	int nstack = 0;
+	stack[nstack++] = 0;
+	while (nstack > 0)
+	{
+		const NODE& node = m_node[stack[--nstack]];
+
+		// the padding of a node must cover the padding of all its facets
+		vec3d d(0, 0, 0);
+		for (int k = 0; k < FACET_TYPES; ++k)
+		{
+			const vec3d& h = node.h[k];
+			if (fac[k]*h.x > d.x) d.x = fac[k]*h.x;
+			if (fac[k]*h.y > d.y) d.y = fac[k]*h.y;
+			if (fac[k]*h.z > d.z) d.z = fac[k]*h.z;
+		}
+		if (LineIntersectsBox(node.box, d, p, n) == false) continue;
+
+		if (node.nchild >= 0)
+		{
+			stack[nstack++] = node.nchild + 1;
+			stack[nstack++] = node.nchild;
+		}
+		else
+		{
+			for (int i = 0; i < node.ncount; ++i)
+			{
+				int nf = m_fac[node.nfirst + i];
+				const BOX& b = m_fbox[nf];
+				vec3d df = (b.r1 - b.r0)*(0.5*fac[(int)m_ftype[nf]]);
+				if (LineIntersectsBox(b, df, p, n)) f(nf);
+			}
+		}
+	}
+}
@@ -67,6 +67,9 @@ public:
 
 	int MaxNodes() const { return m_maxFaceNodes; }
 
+	// get the storage format
+	int StorageFormat() const { return m_format; }
+
 	// return the item list associated with this map
 	FEItemList* GetItemList() override;
 
@@ -32,7 +32,7 @@ SOFTWARE.*/
 #include "FESurfaceLoad.h"
 #include "FEBoundaryCondition.h"
 #include "FESurfacePairConstraint.h"
-#include "FEOctreeSearch.h"
+#include "FEPointLocator.h"
 #include "log.h"
 
 struct TETGENOPTIONS
@@ -490,20 +490,28 @@ bool FETetgenRefine::ReconstructMesh(FEModel& fem)
 	vector<vec3d> pos(N0, vec3d(0,0,0));
 	vector<vector<double> > val(N0, vector<double>(MAX_DOFS, 0.0));
 
-	FEOctreeSearch osearch(&mesh);
-	if (osearch.Init() == false) return false;
+	FEPointLocator locator(&mesh);
+	if (locator.Init() == false) return false;
+
+	// locate all the points
+	vector<vec3d> X(N0);
+	for (int i = 0; i < N0; ++i)
+	{
+		X[i].x = oldMesh.pointlist[3 * i  ];
+		X[i].y = oldMesh.pointlist[3 * i+1];
+		X[i].z = oldMesh.pointlist[3 * i+2];
+	}
+	vector<int> elem;
+	vector<vec3d> R;
+	locator.FindElements(X, elem, R);
 
 	double v[FEElement::MAX_NODES] = { 0 };
 	vec3d rt[FEElement::MAX_NODES];
-	double r[3];
 	for (int i = 0; i < N0; ++i)
 	{
-		vec3d xi;
-		xi.x = oldMesh.pointlist[3 * i  ];
-		xi.y = oldMesh.pointlist[3 * i+1];
-		xi.z = oldMesh.pointlist[3 * i+2];
-		FESolidElement* pe = (FESolidElement*)osearch.FindElement(xi, r); assert(pe);
+		FESolidElement* pe = (elem[i] >= 0 ? locator.Element(elem[i]) : nullptr); assert(pe);
 		if (pe == nullptr) return false;
+		double r[3] = { R[i].x, R[i].y, R[i].z };
 
 		// get the nodal coordinates
 		for (int j = 0; j < pe->Nodes(); ++j) rt[j] = mesh.Node(pe->m_node[j]).m_rt;
@@ -875,8 +883,15 @@ bool build_new_mesh(FEModel& fem, tetgenio& out, bool resetMesh)
 	}
 	else
 	{
-		FEOctreeSearch octree(&mesh);
-		octree.Init();
+		FEPointLocator locator(&mesh);
+		if (locator.Init() == false) return false;
+
+		// locate the new nodes
+		vector<vec3d> X(nodes - N0);
+		for (int i = N0; i < nodes; ++i) X[i - N0] = mesh.Node(i).m_r0;
+		vector<int> elem;
+		vector<vec3d> R;
+		locator.FindElements(X, elem, R);
 
 		// update solution
 		for (int i = N0; i < nodes; ++i)
@@ -892,8 +907,8 @@ bool build_new_mesh(FEModel& fem, tetgenio& out, bool resetMesh)
 				return false;
 			}
 */
-			double r[3] = { 0 };
-			FESolidElement* el = (FESolidElement*) octree.FindElement(nodei.m_r0, r);
+			double r[3] = { R[i - N0].x, R[i - N0].y, R[i - N0].z };
+			FESolidElement* el = (elem[i - N0] >= 0 ? locator.Element(elem[i - N0]) : nullptr);
 			if (el == nullptr)
 			{
 				assert(false);
@@ -318,6 +318,89 @@ void SparseMatrixProfile::Insert(int i, int j)
 	a.insertRow(i);
 }
 
+//-----------------------------------------------------------------------------
+//! Checks whether every entry of mp is also an entry of this profile.
+//! The row entries of a column are sorted and do not overlap, so a single
+//! sweep over both columns suffices.
+bool SparseMatrixProfile::Contains(const SparseMatrixProfile& mp) const
+{
+	if ((mp.m_nrow != m_nrow) || (mp.m_ncol != m_ncol)) return false;
+
+	for (int j = 0; j<m_ncol; ++j)
+	{
+		const ColumnProfile& a = m_prof[j];
+		const ColumnProfile& b = mp.m_prof[j];
+		int na = a.size();
+		int nb = b.size();
+
+		int k = 0;
+		for (int i = 0; i<nb; ++i)
+		{
+			const RowEntry& rb = b[i];
+
+			// find the first entry of a that does not end before rb starts
+			while ((k < na) && (a[k].end < rb.start)) ++k;
+
+			// that entry must cover all of rb
+			if ((k == na) || (a[k].start > rb.start) || (a[k].end < rb.end)) return false;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Adds all the entries of mp to this profile. The two profiles must have the
+//! same dimensions.
+void SparseMatrixProfile::Merge(const SparseMatrixProfile& mp)
+{
+	assert((mp.m_nrow == m_nrow) && (mp.m_ncol == m_ncol));
+
+#pragma omp parallel for schedule(dynamic, 256)
+	for (int j = 0; j<m_ncol; ++j)
+	{
+		const ColumnProfile& a = m_prof[j];
+		const ColumnProfile& b = mp.m_prof[j];
+		int na = a.size();
+		int nb = b.size();
+		if (nb == 0) continue;
+
+		// merge the two sorted lists of row entries
+		ColumnProfile c;
+		c.reserve(na + nb);
+		int ka = 0, kb = 0;
+		while ((ka < na) || (kb < nb))
+		{
+			RowEntry r;
+			if ((kb == nb) || ((ka < na) && (a[ka].start <= b[kb].start))) r = a[ka++];
+			else r = b[kb++];
+
+			// entries that overlap or touch the last one are combined
+			int n = c.size();
+			if ((n > 0) && (r.start <= c[n - 1].end + 1))
+			{
+				if (r.end > c[n - 1].end) c[n - 1].end = r.end;
+			}
+			else c.push_back(r.start, r.end);
+		}
+
+		m_prof[j].swap(c);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! returns the number of entries in the profile
+size_t SparseMatrixProfile::Entries() const
+{
+	size_t nsize = 0;
+	for (int j = 0; j<m_ncol; ++j)
+	{
+		const ColumnProfile& a = m_prof[j];
+		for (int i = 0; i<a.size(); ++i) nsize += (size_t)(a[i].end - a[i].start + 1);
+	}
+	return nsize;
+}
+
 //-----------------------------------------------------------------------------
 // extract the matrix profile of a block
 SparseMatrixProfile SparseMatrixProfile::GetBlockProfile(int nrow0, int ncol0, int nrow1, int ncol1) const
@@ -85,6 +85,9 @@ public:
 		// add row index to column profile
 		void insertRow(int row);
 
+		// swap the profile data with another column profile
+		void swap(ColumnProfile& a) { m_data.swap(a.m_data); }
+
 	private:
 		vector<RowEntry>	m_data;	// the column profile data
 	};
@@ -114,6 +117,15 @@ public:
 	//! inserts an entry into the profile (This is an expensive operation!)
 	void Insert(int i, int j);
 
+	//! see if all the entries of another profile are also in this profile
+	bool Contains(const SparseMatrixProfile& mp) const;
+
+	//! adds the entries of another profile to this profile
+	void Merge(const SparseMatrixProfile& mp);
+
+	//! returns the number of entries in the profile
+	size_t Entries() const;
+
 	//! returns the number of rows
 	int Rows() const { return m_nrow; }
 
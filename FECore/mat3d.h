@@ -144,6 +144,9 @@ public:
 	mat3ds(const mat3dd& d);
 	mat3ds(const mat3ds& d);
 
+	// assignment operator
+	mat3ds& operator = (const mat3ds& d);
+
 	// access operators
 	double& operator () (int i, int j);
 	const double& operator () (int i, int j) const;
@@ -233,25 +233,33 @@ void BlockMatrix::Zero()
 
 //-----------------------------------------------------------------------------
 //! multiply with vector
+//! Each block product is evaluated in parallel by the block itself. The first
+//! block of each row writes directly into r, so that the temporary buffer is 
+//! only used for accumulating the remaining blocks.
 bool BlockMatrix::mult_vector(double* x, double* r)
 {
-	int nr = Rows();
-	vector<double> tmp(nr, 0);
-	for (int i=0; i<nr; ++i) r[i] = 0.0;
 	int NP = Partitions();
+	vector<double> tmp;
 	for (int i=0; i<NP; ++i)
 	{
 		int n0 = m_part[i];
+		double* ri = r + n0;
 		for (int j=0; j<NP; ++j)
 		{
 			int m0 = m_part[j];
 
 			BLOCK& bij = Block(i, j);
 
-			bij.pA->mult_vector(x + m0, &tmp[0] + n0);
+			if (j == 0) bij.pA->mult_vector(x + m0, ri);
+			else
+			{
+				int nj = bij.Rows();
+				tmp.resize(nj);
+				bij.pA->mult_vector(x + m0, &tmp[0]);
 
-			int nj = bij.Rows();
-			for (int k=0; k<nj; ++k) r[n0 + k] += tmp[n0 + k];
+				#pragma omp parallel for if (nj > 10000)
+				for (int k=0; k<nj; ++k) ri[k] += tmp[k];
+			}
 		}
 	}
 
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "CompactSymmMatrix.h"
+#include "SparseKernels.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -37,58 +38,36 @@ CompactSymmMatrix::CompactSymmMatrix(int offset) : CompactMatrix(offset)
 }
 
 //-----------------------------------------------------------------------------
+// Only the lower triangular part is stored (column-wise). Row j of the product
+// therefore needs column j (diagonal and lower part) and row j of the lower part
+// (which is the upper part by symmetry). The latter is accessed via the row index
+// so that all rows can be evaluated in parallel without write conflicts.
 bool CompactSymmMatrix::mult_vector(double* x, double* r)
 {
 	// get row count
-	int N = Rows();
-	int M = Columns();
+	const int N = Rows();
 
-	// zero result vector
-	for (int j = 0; j<N; ++j) r[j] = 0.0;
+	// build the row index of the strictly lower triangular part
+	if ((int)m_rowPointers.size() != N + 1) buildRowIndex(true);
+	const int* rp = m_rowPointers.data();
+	const int* rc = m_rowColumns.data();
+	const int* rv = m_rowValues.data();
 
-	// loop over all columns
-	for (int j = 0; j<M; ++j)
+	// loop over all rows
+	#pragma omp parallel for schedule(guided) if (m_nsize > NumCore::SPMV_MIN_PARALLEL_NNZ)
+	for (int j = 0; j<N; ++j)
 	{
-		double* pv = m_pd + m_ppointers[j] - m_offset;
-		int* pi = m_pindices + m_ppointers[j] - m_offset;
-		int n = m_ppointers[j + 1] - m_ppointers[j];
+		// add diagonal and lower triangular elements
+		const double* pv = m_pd + (m_ppointers[j] - m_offset);
+		const int* pi = m_pindices + (m_ppointers[j] - m_offset);
+		const int n = m_ppointers[j + 1] - m_ppointers[j];
+		double rj = NumCore::gather_dot(n, pv, pi, x, m_offset);
 
-		// add off-diagonal elements
-		for (int i = 1; i<n - 7; i += 8)
-		{
-			// add lower triangular element
-			r[pi[i    ] - m_offset] += pv[i    ] * x[j];
-			r[pi[i + 1] - m_offset] += pv[i + 1] * x[j];
-			r[pi[i + 2] - m_offset] += pv[i + 2] * x[j];
-			r[pi[i + 3] - m_offset] += pv[i + 3] * x[j];
-			r[pi[i + 4] - m_offset] += pv[i + 4] * x[j];
-			r[pi[i + 5] - m_offset] += pv[i + 5] * x[j];
-			r[pi[i + 6] - m_offset] += pv[i + 6] * x[j];
-			r[pi[i + 7] - m_offset] += pv[i + 7] * x[j];
-		}
-		for (int i = 0; i<(n - 1) % 8; ++i)
-			r[pi[n - 1 - i] - m_offset] += pv[n - 1 - i] * x[j];
-
-		// add diagonal element
-		double rj = pv[0] * x[j];
-
-		// add upper-triangular elements
-		for (int i = 1; i<n - 7; i += 8)
-		{
-			// add upper triangular element
-			rj += pv[i    ] * x[pi[i    ] - m_offset];
-			rj += pv[i + 1] * x[pi[i + 1] - m_offset];
-			rj += pv[i + 2] * x[pi[i + 2] - m_offset];
-			rj += pv[i + 3] * x[pi[i + 3] - m_offset];
-			rj += pv[i + 4] * x[pi[i + 4] - m_offset];
-			rj += pv[i + 5] * x[pi[i + 5] - m_offset];
-			rj += pv[i + 6] * x[pi[i + 6] - m_offset];
-			rj += pv[i + 7] * x[pi[i + 7] - m_offset];
-		}
-		for (int i = 0; i<(n - 1) % 8; ++i)
-			rj += pv[n - 1 - i] * x[pi[n - 1 - i] - m_offset];
+		// add upper triangular elements
+		const int m0 = rp[j];
+		rj += NumCore::gather_dot(rp[j + 1] - m0, m_pd, rv + m0, rc + m0, x);
 
-		r[j] += rj;
+		r[j] = rj;
 	}
 
 	return true;
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "CompactUnSymmMatrix.h"
+#include "SparseKernels.h"
 #include <FECore/log.h>
 
 // We must undef PARDISO since it is defined as a function in mkl_solver.h
@@ -371,17 +372,13 @@ bool CRSSparseMatrix::mult_vector(double* x, double* r)
 	{
 		assert(m_offset == 0);
 		// loop over all rows
-	#pragma omp parallel for schedule(guided)
+	#pragma omp parallel for schedule(guided) if (m_nsize > NumCore::SPMV_MIN_PARALLEL_NNZ)
 		for (int i = 0; i < N; ++i)
 		{
 			const double* pv = m_pd + (m_ppointers[i] - m_offset);
 			const int* pi = m_pindices + (m_ppointers[i] - m_offset);
 			const int n = m_ppointers[i + 1] - m_ppointers[i];
-			r[i] = 0.0;
-			for (int j = 0; j < n; j ++)
-			{
-				r[i] += (*pv++) * x[*pi++ - m_offset];
-			}
+			r[i] = NumCore::gather_dot(n, pv, pi, x, m_offset);
 		}
 	}
 
@@ -775,22 +772,26 @@ double CCSSparseMatrix::diag(int i)
 }
 
 //-----------------------------------------------------------------------------
+// The product is evaluated row by row via the row index of the matrix. This 
+// avoids the write conflicts of a column-wise scatter, so that rows can be
+// processed in parallel.
 bool CCSSparseMatrix::mult_vector(double* x, double* r)
 {
 	// get the matrix size
 	const int N = Rows();
-	const int M = Columns();
 
-	// zero r
-	for (int i=0; i<N; ++i) r[i] = 0.0;
+	// build the row index
+	if ((int)m_rowPointers.size() != N + 1) buildRowIndex(false);
+	const int* rp = m_rowPointers.data();
+	const int* rc = m_rowColumns.data();
+	const int* rv = m_rowValues.data();
 
-	// loop over all columns
-	for (int i = 0; i<M; ++i)
+	// loop over all rows
+	#pragma omp parallel for schedule(guided) if (m_nsize > NumCore::SPMV_MIN_PARALLEL_NNZ)
+	for (int i = 0; i<N; ++i)
 	{
-		double* pv = m_pd + (m_ppointers[i] - m_offset);
-		int* pi = m_pindices + (m_ppointers[i] - m_offset);
-		int n = m_ppointers[i + 1] - m_ppointers[i];
-		for (int j = 0; j<n; j++)  r[pi[j] - m_offset] += pv[j] * x[i];
+		const int n0 = rp[i];
+		r[i] = NumCore::gather_dot(rp[i + 1] - n0, m_pd, rv + n0, rc + n0, x);
 	}
 
 	return true;
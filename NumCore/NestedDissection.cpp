@@ -0,0 +1,352 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "NestedDissection.h"
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+void NumCore::SymmetricGraph(int n, const int* pointers, const int* indices, int offset, vector<int>& xadj, vector<int>& adj)
+{
+	// count the entries of A + A^T (this may count some entries twice)
+	vector<int> cnt(n + 1, 0);
+	for (int j = 0; j < n; ++j)
+	{
+		for (int k = pointers[j] - offset; k < pointers[j + 1] - offset; ++k)
+		{
+			int i = indices[k] - offset;
+			if (i != j) { cnt[i]++; cnt[j]++; }
+		}
+	}
+
+	vector<int> pos(n + 1, 0);
+	for (int i = 0; i < n; ++i) pos[i + 1] = pos[i] + cnt[i];
+
+	vector<int> tmp(pos[n]);
+	vector<int> tag(pos.begin(), pos.end() - 1);
+	for (int j = 0; j < n; ++j)
+	{
+		for (int k = pointers[j] - offset; k < pointers[j + 1] - offset; ++k)
+		{
+			int i = indices[k] - offset;
+			if (i != j)
+			{
+				tmp[tag[i]++] = j;
+				tmp[tag[j]++] = i;
+			}
+		}
+	}
+
+	// sort the adjacency lists and remove duplicates
+	xadj.assign(n + 1, 0);
+	adj.clear();
+	adj.reserve(pos[n]);
+	for (int i = 0; i < n; ++i)
+	{
+		int* a = &tmp[0] + pos[i];
+		int* b = &tmp[0] + pos[i + 1];
+		sort(a, b);
+		int* e = unique(a, b);
+		adj.insert(adj.end(), a, e);
+		xadj[i + 1] = (int)adj.size();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// See if vertices i and i-1 have the same adjacency (including the vertices themselves)
+static bool sameAdjacency(int i, const vector<int>& xadj, const vector<int>& adj)
+{
+	int j = i - 1;
+	int ni = xadj[i + 1] - xadj[i];
+	int nj = xadj[j + 1] - xadj[j];
+	if (ni != nj) return false;
+
+	const int* ai = &adj[0] + xadj[i];
+	const int* aj = &adj[0] + xadj[j];
+
+	// the vertices must be connected, and the remaining neighbors must match
+	int ki = 0, kj = 0;
+	bool connected = false;
+	while ((ki < ni) || (kj < nj))
+	{
+		if ((ki < ni) && (ai[ki] == j)) { ki++; connected = true; continue; }
+		if ((kj < nj) && (aj[kj] == i)) { kj++; continue; }
+		if ((ki >= ni) || (kj >= nj) || (ai[ki] != aj[kj])) return false;
+		ki++; kj++;
+	}
+	return connected;
+}
+
+//-----------------------------------------------------------------------------
+int NumCore::CompressGraph(int n, const vector<int>& xadj, const vector<int>& adj, vector<int>& group, vector<int>& first, vector<int>& cxadj, vector<int>& cadj)
+{
+	group.assign(n, 0);
+	first.clear();
+	int ng = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		if ((i == 0) || (sameAdjacency(i, xadj, adj) == false))
+		{
+			first.push_back(i);
+			ng++;
+		}
+		group[i] = ng - 1;
+	}
+	first.push_back(n);
+
+	// build the graph of the groups
+	cxadj.assign(ng + 1, 0);
+	cadj.clear();
+	for (int k = 0; k < ng; ++k)
+	{
+		int v = first[k];
+		int last = -1;
+		for (int m = xadj[v]; m < xadj[v + 1]; ++m)
+		{
+			// adjacency lists are sorted, so group numbers are increasing
+			int g = group[adj[m]];
+			if ((g != k) && (g != last))
+			{
+				cadj.push_back(g);
+				last = g;
+			}
+		}
+		cxadj[k + 1] = (int)cadj.size();
+	}
+
+	return ng;
+}
+
+//-----------------------------------------------------------------------------
+namespace {
+
+// Helper class for building level structures of subgraphs
+class LevelStructure
+{
+public:
+	LevelStructure(int n, const vector<int>& xadj, const vector<int>& adj) : m_xadj(xadj), m_adj(adj)
+	{
+		m_label.assign(n, -1);
+		m_stamp.assign(n, -1);
+		m_level.assign(n, -1);
+		m_queue.resize(n);
+		m_nstamp = 0;
+	}
+
+	// mark the vertices of a subgraph
+	void SetSubgraph(const vector<int>& v, int label)
+	{
+		for (size_t i = 0; i < v.size(); ++i) m_label[v[i]] = label;
+	}
+
+	// Do a breadth-first search of the subgraph with the given label, starting at root.
+	// Returns the number of vertices that were visited.
+	int Build(int root, int label)
+	{
+		int stamp = m_nstamp++;
+		m_levelStart.clear();
+		m_levelStart.push_back(0);
+
+		int head = 0, tail = 0;
+		m_queue[tail++] = root;
+		m_stamp[root] = stamp;
+		m_level[root] = 0;
+		int lastLevel = 0;
+		while (head < tail)
+		{
+			int v = m_queue[head++];
+			if (m_level[v] != lastLevel) { m_levelStart.push_back(head - 1); lastLevel = m_level[v]; }
+			for (int k = m_xadj[v]; k < m_xadj[v + 1]; ++k)
+			{
+				int u = m_adj[k];
+				if ((m_label[u] == label) && (m_stamp[u] != stamp))
+				{
+					m_stamp[u] = stamp;
+					m_level[u] = m_level[v] + 1;
+					m_queue[tail++] = u;
+				}
+			}
+		}
+		m_levelStart.push_back(tail);
+		return tail;
+	}
+
+	int Levels() const { return (int)m_levelStart.size() - 1; }
+
+	// degree of v in the subgraph
+	int Degree(int v, int label) const
+	{
+		int d = 0;
+		for (int k = m_xadj[v]; k < m_xadj[v + 1]; ++k) if (m_label[m_adj[k]] == label) d++;
+		return d;
+	}
+
+	// find a pseudo-peripheral vertex of the subgraph (George-Liu)
+	int PseudoPeripheral(int root, int label)
+	{
+		Build(root, label);
+		for (int iter = 0; iter < 5; ++iter)
+		{
+			int nlev = Levels();
+
+			// choose the vertex of minimum degree in the last level
+			int vmin = -1, dmin = 0;
+			for (int k = m_levelStart[nlev - 1]; k < m_levelStart[nlev]; ++k)
+			{
+				int v = m_queue[k];
+				int d = Degree(v, label);
+				if ((vmin == -1) || (d < dmin)) { vmin = v; dmin = d; }
+			}
+
+			Build(vmin, label);
+			if (Levels() <= nlev) break;
+			root = vmin;
+		}
+		return root;
+	}
+
+public:
+	const vector<int>&	m_xadj;
+	const vector<int>&	m_adj;
+	vector<int>	m_label;		// subgraph that a vertex belongs to
+	vector<int>	m_stamp;		// visited marker
+	vector<int>	m_level;		// level of vertex in last search
+	vector<int>	m_queue;		// vertices in order of the last search
+	vector<int>	m_levelStart;	// start of each level in queue
+	int			m_nstamp;
+};
+
+struct Subgraph
+{
+	vector<int>	vert;	// vertices of this subgraph
+	int			last;	// last position in ordering
+};
+
+}
+
+//-----------------------------------------------------------------------------
+// The graph is recursively divided by vertex separators that are found from the 
+// middle level of the level structure rooted at a pseudo-peripheral vertex. 
+// The separator vertices are numbered last. 
+void NumCore::NestedDissection(int n, const vector<int>& xadj, const vector<int>& adj, vector<int>& perm, int leafSize)
+{
+	perm.assign(n, -1);
+	if (n == 0) return;
+	if (leafSize < 1) leafSize = 1;
+
+	LevelStructure ls(n, xadj, adj);
+
+	vector<Subgraph> stack(1);
+	stack[0].vert.resize(n);
+	for (int i = 0; i < n; ++i) stack[0].vert[i] = i;
+	stack[0].last = n - 1;
+
+	int label = 0;
+	while (stack.empty() == false)
+	{
+		Subgraph g;
+		g.vert.swap(stack.back().vert);
+		g.last = stack.back().last;
+		stack.pop_back();
+
+		int m = (int)g.vert.size();
+		if (m == 0) continue;
+
+		ls.SetSubgraph(g.vert, label);
+
+		// find a good starting vertex
+		int root = ls.PseudoPeripheral(g.vert[0], label);
+		int nvisit = ls.Build(root, label);
+		int nlev = ls.Levels();
+
+		Subgraph a, b;
+		vector<int> sep;
+		if (nvisit < m)
+		{
+			// the subgraph is not connected, so split off the component we found
+			for (int k = 0; k < nvisit; ++k) a.vert.push_back(ls.m_queue[k]);
+			for (int k = 0; k < m; ++k)
+			{
+				int v = g.vert[k];
+				if (ls.m_stamp[v] != ls.m_nstamp - 1) b.vert.push_back(v);
+			}
+		}
+		else if ((m <= leafSize) || (nlev < 3))
+		{
+			// number the vertices in the order of the search
+			for (int k = 0; k < m; ++k) perm[g.last - m + 1 + k] = ls.m_queue[k];
+			label++;
+			continue;
+		}
+		else
+		{
+			// find the middle level
+			int L = 1;
+			while ((L < nlev - 2) && (ls.m_levelStart[L + 1] < m / 2)) L++;
+
+			// look for a smaller separator among the levels that still give a reasonable balance
+			const int* ps = &ls.m_levelStart[0];
+			int nmin = m / 4;
+			for (int l = 1; l < nlev - 1; ++l)
+			{
+				if ((ps[l] >= nmin) && (m - ps[l + 1] >= nmin) && (ps[l + 1] - ps[l] < ps[L + 1] - ps[L])) L = l;
+			}
+
+			for (int k = 0; k < ls.m_levelStart[L]; ++k) a.vert.push_back(ls.m_queue[k]);
+			for (int k = ls.m_levelStart[L + 1]; k < m; ++k) b.vert.push_back(ls.m_queue[k]);
+
+			// separator vertices that are not connected to the upper part can move to the lower part
+			for (int k = ls.m_levelStart[L]; k < ls.m_levelStart[L + 1]; ++k)
+			{
+				int v = ls.m_queue[k];
+				bool touchesB = false;
+				for (int j = xadj[v]; j < xadj[v + 1]; ++j)
+				{
+					int u = adj[j];
+					if ((ls.m_label[u] == label) && (ls.m_level[u] == L + 1)) { touchesB = true; break; }
+				}
+				if (touchesB) sep.push_back(v); else a.vert.push_back(v);
+			}
+		}
+		label++;
+
+		// separator is numbered last
+		int ns = (int)sep.size();
+		for (int k = 0; k < ns; ++k) perm[g.last - ns + 1 + k] = sep[k];
+		b.last = g.last - ns;
+		a.last = b.last - (int)b.vert.size();
+
+		stack.push_back(Subgraph());
+		stack.back().vert.swap(a.vert);
+		stack.back().last = a.last;
+		stack.push_back(Subgraph());
+		stack.back().vert.swap(b.vert);
+		stack.back().last = b.last;
+	}
+}
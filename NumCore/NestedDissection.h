@@ -0,0 +1,52 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Graph tools for calculating fill-reducing orderings of sparse matrices.
+// The graphs are stored in compressed adjacency format, i.e. the neighbors of
+// vertex i are adj[xadj[i]] ... adj[xadj[i+1]-1]. Graphs do not contain self-loops.
+namespace NumCore
+{
+	// Build the adjacency graph of A + A^T (without the diagonal) from the sparsity
+	// pattern of a compressed row or column matrix.
+	void SymmetricGraph(int n, const int* pointers, const int* indices, int offset, std::vector<int>& xadj, std::vector<int>& adj);
+
+	// Find groups of consecutive vertices that have identical adjacency (e.g. the degrees
+	// of freedom of a node) and build the graph of these groups. On return, group[i] is the
+	// group of vertex i and the vertices of group k are first[k] ... first[k+1]-1.
+	// Returns the number of groups.
+	int CompressGraph(int n, const std::vector<int>& xadj, const std::vector<int>& adj, std::vector<int>& group, std::vector<int>& first, std::vector<int>& cxadj, std::vector<int>& cadj);
+
+	// Calculate a nested dissection ordering. On return, perm[k] is the vertex that is
+	// eliminated at position k. Subgraphs with at most leafSize vertices are not divided further.
+	void NestedDissection(int n, const std::vector<int>& xadj, const std::vector<int>& adj, std::vector<int>& perm, int leafSize = 64);
+
+} // namespace NumCore
@@ -26,6 +26,8 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "NumCore.h"
 #include "SkylineSolver.h"
+#include "SupernodalSolver.h"
+#include "SupernodalLUSolver.h"
 #include "LUSolver.h"
 #include "PardisoSolver.h"
 #include "RCICGSolver.h"
@@ -53,6 +55,8 @@ void NumCore::InitModule()
 	// register linear solvers
 	REGISTER_FECORE_CLASS(PardisoSolver  , "pardiso");
 	REGISTER_FECORE_CLASS(SkylineSolver  , "skyline");
+	REGISTER_FECORE_CLASS(SupernodalSolver, "supernodal");
+	REGISTER_FECORE_CLASS(SupernodalLUSolver, "supernodal_lu");
 	REGISTER_FECORE_CLASS(LUSolver       , "LU"     );
 	REGISTER_FECORE_CLASS(FGMRESSolver        , "fgmres"   );
 	REGISTER_FECORE_CLASS(BoomerAMGSolver     , "boomeramg");
@@ -80,6 +84,6 @@ void NumCore::InitModule()
 #ifdef PARDISO
 	fecore.SetDefaultSolverType("pardiso");
 #else
-	fecore.SetDefaultSolverType("skyline");
+	fecore.SetDefaultSolverType("supernodal");
 #endif
 }
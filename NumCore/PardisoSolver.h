@@ -66,6 +66,7 @@ protected:
 	double m_dparm[64];
 
 	bool m_iparm3;	// use direct-iterative method
+	bool m_breuseSymbolic;	// skip the symbolic factorization if the matrix structure did not change
 
 	// Matrix data
 	int m_n, m_nnz, m_nrhs;
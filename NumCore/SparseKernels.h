@@ -0,0 +1,73 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Inner kernels for the sparse matrix-vector products of the compact matrix
+// formats. The loops accumulate four independent partial sums so that the 
+// compiler can vectorize them and overlap the indirect loads of x.
+namespace NumCore
+{
+	// Matrix-vector products of matrices with fewer nonzeroes than this
+	// are not worth distributing over threads.
+	enum { SPMV_MIN_PARALLEL_NNZ = 20000 };
+
+	// returns sum( v[k]*x[ind[k] - offset] ), k = 0 .. n-1
+	inline double gather_dot(int n, const double* v, const int* ind, const double* x, int offset)
+	{
+		double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+		int k = 0;
+		for (; k < n - 3; k += 4)
+		{
+			s0 += v[k    ] * x[ind[k    ] - offset];
+			s1 += v[k + 1] * x[ind[k + 1] - offset];
+			s2 += v[k + 2] * x[ind[k + 2] - offset];
+			s3 += v[k + 3] * x[ind[k + 3] - offset];
+		}
+		for (; k < n; ++k) s0 += v[k] * x[ind[k] - offset];
+		return (s0 + s1) + (s2 + s3);
+	}
+
+	// returns sum( v[loc[k]]*x[col[k]] ), k = 0 .. n-1
+	inline double gather_dot(int n, const double* v, const int* loc, const int* col, const double* x)
+	{
+		double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+		int k = 0;
+		for (; k < n - 3; k += 4)
+		{
+			s0 += v[loc[k    ]] * x[col[k    ]];
+			s1 += v[loc[k + 1]] * x[col[k + 1]];
+			s2 += v[loc[k + 2]] * x[col[k + 2]];
+			s3 += v[loc[k + 3]] * x[col[k + 3]];
+		}
+		for (; k < n; ++k) s0 += v[loc[k]] * x[col[k]];
+		return (s0 + s1) + (s2 + s3);
+	}
+
+} // namespace NumCore
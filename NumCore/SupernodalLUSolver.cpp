@@ -0,0 +1,554 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "SupernodalLUSolver.h"
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <algorithm>
+#include <math.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(SupernodalLUSolver, LinearSolver)
+	ADD_PARAMETER(m_leafSize  , "leaf_size");
+	ADD_PARAMETER(m_pivotTol  , "pivot_threshold");
+	ADD_PARAMETER(m_perturb   , "pivot_perturbation");
+	ADD_PARAMETER(m_maxRefine , "max_refinements");
+	ADD_PARAMETER(m_printLevel, "print_level");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+// Below these operation counts the dense kernels are not worth threading
+#define MIN_PARALLEL_WORK	32768
+
+//-----------------------------------------------------------------------------
+SupernodalLUSolver::SupernodalLUSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
+{
+	m_isAnalyzed = false;
+	m_pivmin = 0.0;
+	m_nperturb = 0;
+
+	m_leafSize = 64;
+	m_pivotTol = 0.1;
+	m_perturb = 1e-13;
+	m_maxRefine = 2;
+	m_printLevel = 0;
+}
+
+//-----------------------------------------------------------------------------
+SupernodalLUSolver::~SupernodalLUSolver()
+{
+	Destroy();
+}
+
+//-----------------------------------------------------------------------------
+//! Create a sparse matrix
+SparseMatrix* SupernodalLUSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	// symmetric matrices are not supported. The caller will switch to an unsymmetric format.
+	if (ntype == REAL_SYMMETRIC) return (m_pA = 0);
+	return (m_pA = new CRSSparseMatrix(0));
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalLUSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	m_pA = dynamic_cast<CompactMatrix*>(pA);
+	if (m_pA && m_pA->isSymmetric()) m_pA = nullptr;
+	return (m_pA != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalLUSolver::SetPrintLevel(int n)
+{
+	m_printLevel = n;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalLUSolver::SamePattern() const
+{
+	int n = (m_pA->isRowBased() ? m_pA->Rows() : m_pA->Columns());
+	if ((int)m_pointers.size() != n + 1) return false;
+
+	const int* pointers = m_pA->Pointers();
+	if (equal(m_pointers.begin(), m_pointers.end(), pointers) == false) return false;
+
+	int nnz = m_pointers[n] - m_pointers[0];
+	if ((int)m_indices.size() != nnz) return false;
+	return equal(m_indices.begin(), m_indices.end(), m_pA->Indices());
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalLUSolver::PreProcess()
+{
+	if (m_pA == nullptr) return false;
+	if (m_pA->IsSquare() == false) return false;
+
+	// we only need to redo the symbolic analysis if the sparsity pattern changed
+	if ((m_isAnalyzed == false) || (SamePattern() == false))
+	{
+		if (Analyze() == false) return false;
+	}
+	else if (m_printLevel > 0) feLog("Reusing symbolic factorization.\n");
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalLUSolver::Analyze()
+{
+	m_isAnalyzed = false;
+
+	const int neq = m_pA->Rows();
+	const int offset = m_pA->Offset();
+	const int* pointers = m_pA->Pointers();
+	const int* indices = m_pA->Indices();
+	const int nnz = (neq > 0 ? pointers[neq] - offset : 0);
+	const bool rowBased = m_pA->isRowBased();
+
+	// ordering and symbolic factorization (of A + A^T)
+	m_S.Create(neq, pointers, indices, offset, m_leafSize);
+
+	// Find the location in the factor of each matrix value. Values in the 
+	// diagonal blocks are stored in the L panels, the rest of the upper triangular
+	// part goes in the U panels (which are offset by the size of the L panels).
+	const size_t nL = m_S.Size();
+	m_scatter.resize(nnz);
+#pragma omp parallel for
+	for (int j = 0; j < neq; ++j)
+	{
+		for (int k = pointers[j] - offset; k < pointers[j + 1] - offset; ++k)
+		{
+			int ni = m_S.m_iperm[rowBased ? j : indices[k] - offset];
+			int nj = m_S.m_iperm[rowBased ? indices[k] - offset : j];
+			if ((ni >= nj) || (m_S.m_colSn[ni] == m_S.m_colSn[nj])) m_scatter[k] = m_S.Location(ni, nj);
+			else m_scatter[k] = nL + m_S.Location(nj, ni);
+		}
+	}
+
+	// allocate the factor
+	m_L.resize(nL);
+	m_U.resize(nL);
+	m_piv.resize(neq);
+
+	// store the pattern so we can check later if we need to redo this
+	m_pointers.assign(pointers, pointers + neq + 1);
+	m_indices.assign(indices, indices + nnz);
+
+	if (m_printLevel > 0)
+	{
+		feLog("\tNr of supernodes .......................... : %d\n", m_S.m_nsn);
+		feLog("\tNr of nonzeroes in factor ................. : %lg\n", 2.0*(double)nL);
+		feLog("\tNr of levels in elimination tree .......... : %d\n", m_S.Levels());
+	}
+
+	m_isAnalyzed = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the update C(i,k) = sum_l A(p0 + i, l)*B(p0 + k, l), for rows i0 <= i < mr 
+// and columns k0 ... k0+kn-1, and subtract it from the target panel T. A and B are panels 
+// of the descendant supernode. The array rel gives the rows of the target panel that 
+// correspond to the rows p0 ... p0+mr-1 of the descendant.
+static void updateColumns(const double* A, const double* B, int md, int wd, int p0, int mr, int i0,
+	const int* rd, const int* rel, int k0, int kn, double* T, int ms, int f, double* buf)
+{
+	const int len = mr - i0;
+	if (len <= 0) return;
+	for (int i = 0; i < kn*len; ++i) buf[i] = 0.0;
+
+	double b[4];
+	for (int l = 0; l < wd; ++l)
+	{
+		const double* a = A + (size_t)l*md + p0 + i0;
+		const double* bc = B + (size_t)l*md + p0 + k0;
+		for (int j = 0; j < kn; ++j) b[j] = bc[j];
+
+		if (kn == 4)
+		{
+			double* c0 = buf;
+			double* c1 = buf + len;
+			double* c2 = buf + 2*len;
+			double* c3 = buf + 3*len;
+			for (int i = 0; i < len; ++i)
+			{
+				double ai = a[i];
+				c0[i] += ai*b[0];
+				c1[i] += ai*b[1];
+				c2[i] += ai*b[2];
+				c3[i] += ai*b[3];
+			}
+		}
+		else
+		{
+			for (int j = 0; j < kn; ++j)
+			{
+				double* cj = buf + j*len;
+				double bj = b[j];
+				for (int i = 0; i < len; ++i) cj[i] += a[i]*bj;
+			}
+		}
+	}
+
+	// scatter into the target
+	for (int j = 0; j < kn; ++j)
+	{
+		int k = k0 + j;
+		double* tc = T + (size_t)(rd[p0 + k] - f)*ms;
+		const double* cj = buf + j*len;
+		for (int i = 0; i < len; ++i) tc[rel[i0 + i]] -= cj[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+int SupernodalLUSolver::FactorSupernode(int s, bool parallel, vector<double>& work, vector<int>& rel)
+{
+	const int f = m_S.m_snCol[s];
+	const int ws = m_S.m_snCol[s + 1] - f;
+	const int* rs = &m_S.m_snRows[0] + m_S.m_snRowPtr[s];
+	const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+	double* Ls = &m_L[0] + m_S.m_snVal[s];
+	double* Us = &m_U[0] + m_S.m_snVal[s];
+
+	// apply the updates from the descendants
+	for (int u = m_S.m_updPtr[s]; u < m_S.m_updPtr[s + 1]; ++u)
+	{
+		const int d = m_S.m_updSn[u];
+		const int p0 = m_S.m_updRow0[u];
+		const int p1 = m_S.m_updRow1[u];
+		const int wd = m_S.m_snCol[d + 1] - m_S.m_snCol[d];
+		const int* rd = &m_S.m_snRows[0] + m_S.m_snRowPtr[d];
+		const int md = m_S.m_snRowPtr[d + 1] - m_S.m_snRowPtr[d];
+		const double* Ld = &m_L[0] + m_S.m_snVal[d];
+		const double* Ud = &m_U[0] + m_S.m_snVal[d];
+		const int mr = md - p0;
+		const int nc = p1 - p0;
+
+		// the rows of d are a subset of the rows of s
+		rel.resize(mr);
+		int pos = 0;
+		for (int i = 0; i < mr; ++i)
+		{
+			int r = rd[p0 + i];
+			while (rs[pos] != r) pos++;
+			rel[i] = pos;
+		}
+
+		// The L panel is updated with L_d*U_d and the U panel with U_d^T*L_d^T.
+		const int nb = (nc + 3) / 4;
+		double work_load = 2.0*mr*nc*wd;
+		if (parallel && (work_load > MIN_PARALLEL_WORK))
+		{
+			const int* prel = &rel[0];
+#pragma omp parallel
+			{
+				vector<double> buf(4 * mr);
+#pragma omp for schedule(dynamic)
+				for (int b = 0; b < nb; ++b)
+				{
+					int k0 = 4 * b;
+					int kn = (k0 + 4 <= nc ? 4 : nc - k0);
+					updateColumns(Ld, Ud, md, wd, p0, mr, 0, rd, prel, k0, kn, Ls, ms, f, &buf[0]);
+					updateColumns(Ud, Ld, md, wd, p0, mr, nc, rd, prel, k0, kn, Us, ms, f, &buf[0]);
+				}
+			}
+		}
+		else
+		{
+			if ((int)work.size() < 4 * mr) work.resize(4 * mr);
+			for (int b = 0; b < nb; ++b)
+			{
+				int k0 = 4 * b;
+				int kn = (k0 + 4 <= nc ? 4 : nc - k0);
+				updateColumns(Ld, Ud, md, wd, p0, mr, 0, rd, &rel[0], k0, kn, Ls, ms, f, &work[0]);
+				updateColumns(Ud, Ld, md, wd, p0, mr, nc, rd, &rel[0], k0, kn, Us, ms, f, &work[0]);
+			}
+		}
+	}
+
+	// factor the panel with partial pivoting within the diagonal block
+	int nperturb = 0;
+	int* piv = &m_piv[f];
+	for (int j = 0; j < ws; ++j)
+	{
+		double* cj = Ls + (size_t)j*ms;
+
+		// find the pivot
+		int p = j;
+		double vmax = 0.0;
+		for (int i = j; i < ws; ++i)
+		{
+			double v = fabs(cj[i]);
+			if (v > vmax) { vmax = v; p = i; }
+		}
+		if (fabs(cj[j]) >= m_pivotTol*vmax) p = j;
+		piv[j] = p;
+
+		// swap the rows of L and the columns of U^T
+		if (p != j)
+		{
+			for (int k = 0; k < ws; ++k) swap(Ls[(size_t)k*ms + j], Ls[(size_t)k*ms + p]);
+			swap_ranges(Us + (size_t)j*ms + ws, Us + (size_t)(j + 1)*ms, Us + (size_t)p*ms + ws);
+		}
+
+		// perturb small pivots
+		double d = cj[j];
+		if (fabs(d) < m_pivmin)
+		{
+			d = (d >= 0.0 ? m_pivmin : -m_pivmin);
+			cj[j] = d;
+			nperturb++;
+		}
+
+		const double di = 1.0 / d;
+		for (int i = j + 1; i < ms; ++i) cj[i] *= di;
+
+		// update the remaining columns of the block
+		double work_load = (double)(ms - j)*(ws - j);
+#pragma omp parallel for schedule(dynamic) if (parallel && (work_load > MIN_PARALLEL_WORK))
+		for (int k = j + 1; k < ws; ++k)
+		{
+			double* ck = Ls + (size_t)k*ms;
+			const double ujk = ck[j];
+			if (ujk == 0.0) continue;
+			for (int i = j + 1; i < ms; ++i) ck[i] -= cj[i] * ujk;
+		}
+
+		// update the remaining rows of U
+		const double* uj = Us + (size_t)j*ms;
+		work_load = (double)(ws - j)*(ms - ws);
+#pragma omp parallel for schedule(dynamic) if (parallel && (work_load > MIN_PARALLEL_WORK))
+		for (int i = j + 1; i < ws; ++i)
+		{
+			const double lij = cj[i];
+			if (lij == 0.0) continue;
+			double* ui = Us + (size_t)i*ms;
+			for (int r = ws; r < ms; ++r) ui[r] -= lij * uj[r];
+		}
+	}
+
+	return nperturb;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalLUSolver::Factor()
+{
+	const int neq = m_pA->Rows();
+	if (neq == 0) return true;
+	if (m_isAnalyzed == false) return false;
+
+	// copy the matrix values into the factor
+	const double* pa = m_pA->Values();
+	const int nnz = (int)m_scatter.size();
+	const size_t nL = m_L.size();
+#pragma omp parallel for
+	for (int s = 0; s < m_S.m_nsn; ++s)
+	{
+		for (size_t i = m_S.m_snVal[s]; i < m_S.m_snVal[s + 1]; ++i) { m_L[i] = 0.0; m_U[i] = 0.0; }
+	}
+	double amax = 0.0;
+	for (int i = 0; i < nnz; ++i)
+	{
+		size_t n = m_scatter[i];
+		if (n < nL) m_L[n] = pa[i]; else m_U[n - nL] = pa[i];
+		if (fabs(pa[i]) > amax) amax = fabs(pa[i]);
+	}
+	m_pivmin = m_perturb*amax;
+
+	int nthreads = 1;
+#pragma omp parallel
+	{
+#pragma omp single
+		nthreads = omp_get_num_threads();
+	}
+
+	// Process the elimination tree level by level. When a level has enough supernodes, the 
+	// supernodes are distributed over the threads. Otherwise, the dense kernels are threaded.
+	vector<double> work;
+	vector<int> rel;
+	int nperturb = 0;
+	const int nlevels = m_S.Levels();
+	for (int l = 0; l < nlevels; ++l)
+	{
+		const int l0 = m_S.m_levelPtr[l];
+		const int l1 = m_S.m_levelPtr[l + 1];
+		if (l1 - l0 >= 2 * nthreads)
+		{
+#pragma omp parallel
+			{
+				vector<double> work_t;
+				vector<int> rel_t;
+#pragma omp for schedule(dynamic) reduction(+:nperturb)
+				for (int i = l0; i < l1; ++i)
+				{
+					nperturb += FactorSupernode(m_S.m_levelSn[i], false, work_t, rel_t);
+				}
+			}
+		}
+		else
+		{
+			for (int i = l0; i < l1; ++i)
+			{
+				nperturb += FactorSupernode(m_S.m_levelSn[i], true, work, rel);
+			}
+		}
+	}
+	m_nperturb = nperturb;
+
+	if ((m_printLevel > 0) && (m_nperturb > 0))
+	{
+		feLog("\tNr of perturbed pivots .................... : %d\n", m_nperturb);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalLUSolver::Solve(vector<double>& y)
+{
+	// forward substitution
+	for (int s = 0; s < m_S.m_nsn; ++s)
+	{
+		const int f = m_S.m_snCol[s];
+		const int ws = m_S.m_snCol[s + 1] - f;
+		const int* rs = &m_S.m_snRows[0] + m_S.m_snRowPtr[s];
+		const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+		const double* Ls = &m_L[0] + m_S.m_snVal[s];
+
+		// apply the row interchanges of this supernode
+		for (int j = 0; j < ws; ++j)
+		{
+			int p = m_piv[f + j];
+			if (p != j) swap(y[f + j], y[f + p]);
+		}
+
+		for (int j = 0; j < ws; ++j)
+		{
+			const double yj = y[f + j];
+			if (yj == 0.0) continue;
+			const double* cj = Ls + (size_t)j*ms;
+			for (int i = j + 1; i < ms; ++i) y[rs[i]] -= cj[i] * yj;
+		}
+	}
+
+	// backward substitution
+	for (int s = m_S.m_nsn - 1; s >= 0; --s)
+	{
+		const int f = m_S.m_snCol[s];
+		const int ws = m_S.m_snCol[s + 1] - f;
+		const int* rs = &m_S.m_snRows[0] + m_S.m_snRowPtr[s];
+		const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+		const double* Ls = &m_L[0] + m_S.m_snVal[s];
+		const double* Us = &m_U[0] + m_S.m_snVal[s];
+		for (int j = ws - 1; j >= 0; --j)
+		{
+			const double* uj = Us + (size_t)j*ms;
+			double sum = 0.0;
+			for (int r = ws; r < ms; ++r) sum += uj[r] * y[rs[r]];
+			for (int k = j + 1; k < ws; ++k) sum += Ls[(size_t)k*ms + j] * y[f + k];
+			y[f + j] = (y[f + j] - sum) / Ls[(size_t)j*ms + j];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalLUSolver::Residual(const double* x, const double* b, vector<double>& r)
+{
+	const int neq = m_pA->Rows();
+	const int offset = m_pA->Offset();
+	const int* pointers = m_pA->Pointers();
+	const int* indices = m_pA->Indices();
+	const double* values = m_pA->Values();
+
+	r.assign(b, b + neq);
+	if (m_pA->isRowBased())
+	{
+#pragma omp parallel for
+		for (int i = 0; i < neq; ++i)
+		{
+			double ri = 0.0;
+			for (int k = pointers[i] - offset; k < pointers[i + 1] - offset; ++k) ri += values[k] * x[indices[k] - offset];
+			r[i] -= ri;
+		}
+	}
+	else
+	{
+		for (int j = 0; j < neq; ++j)
+		{
+			for (int k = pointers[j] - offset; k < pointers[j + 1] - offset; ++k) r[indices[k] - offset] -= values[k] * x[j];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalLUSolver::BackSolve(double* x, double* b)
+{
+	const int neq = m_pA->Rows();
+	if (neq == 0) return true;
+
+	vector<double> y(neq);
+	for (int i = 0; i < neq; ++i) y[m_S.m_iperm[i]] = b[i];
+	Solve(y);
+	for (int i = 0; i < neq; ++i) x[i] = y[m_S.m_iperm[i]];
+
+	// Do some iterative refinement if pivots were perturbed
+	int niter = 0;
+	if ((m_nperturb > 0) && (m_maxRefine > 0))
+	{
+		double bnorm = 0.0;
+		for (int i = 0; i < neq; ++i) bnorm = max(bnorm, fabs(b[i]));
+
+		vector<double> r;
+		for (niter = 0; niter < m_maxRefine; ++niter)
+		{
+			Residual(x, b, r);
+			double rnorm = 0.0;
+			for (int i = 0; i < neq; ++i) rnorm = max(rnorm, fabs(r[i]));
+			if (rnorm <= 1e-15*bnorm) break;
+
+			for (int i = 0; i < neq; ++i) y[m_S.m_iperm[i]] = r[i];
+			Solve(y);
+			for (int i = 0; i < neq; ++i) x[i] += y[m_S.m_iperm[i]];
+		}
+	}
+
+	// update stats
+	UpdateStats(1 + niter);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalLUSolver::Destroy()
+{
+	// The symbolic factorization is kept so that it can be reused
+	// when the matrix is recreated with the same sparsity pattern.
+	LinearSolver::Destroy();
+}
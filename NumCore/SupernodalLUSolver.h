@@ -0,0 +1,115 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactUnSymmMatrix.h"
+#include "SupernodalStructure.h"
+
+//-----------------------------------------------------------------------------
+//! Sparse direct LU solver for unsymmetric matrices that does not depend on external libraries.
+
+//! The ordering and supernode structure are calculated from the pattern of A + A^T (see 
+//! SupernodalSolver). For each supernode, the L part and the transpose of the U part are stored 
+//! as dense panels. Rows are only interchanged within the diagonal block of a supernode
+//! (threshold partial pivoting), so that the structure of the factor does not depend on the 
+//! pivot choices. Pivots that remain too small are perturbed and the solution is then improved 
+//! with iterative refinement. The symbolic analysis is reused as long as the sparsity pattern
+//! does not change. 
+class SupernodalLUSolver : public LinearSolver
+{
+public:
+	//! constructor
+	SupernodalLUSolver(FEModel* fem);
+
+	//! destructor
+	~SupernodalLUSolver();
+
+	//! Symbolic analysis
+	bool PreProcess() override;
+
+	//! Numerical factorization
+	bool Factor() override;
+
+	//! Backsolve the linear system
+	bool BackSolve(double* x, double* b) override;
+
+	//! Clean up
+	void Destroy() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! Set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	//! set the print level
+	void SetPrintLevel(int n) override;
+
+private:
+	// see if the matrix has the same sparsity pattern as the one that was analyzed
+	bool SamePattern() const;
+
+	// do the symbolic analysis
+	bool Analyze();
+
+	// factor a single supernode
+	int FactorSupernode(int s, bool parallel, std::vector<double>& work, std::vector<int>& rel);
+
+	// solve with the factored matrix (in permuted numbering)
+	void Solve(std::vector<double>& y);
+
+	// calculate r = b - A*x
+	void Residual(const double* x, const double* b, std::vector<double>& r);
+
+private:
+	CompactMatrix*	m_pA;			//!< the matrix
+
+	SupernodalStructure	m_S;		//!< structure of the factor
+
+	std::vector<size_t>	m_scatter;	//!< location of matrix values in factor
+	std::vector<double>	m_L;		//!< L panels (including the diagonal blocks)
+	std::vector<double>	m_U;		//!< U panels (transposed, only the part below the diagonal blocks is used)
+	std::vector<int>	m_piv;		//!< row interchanges in the diagonal blocks
+
+	// sparsity pattern of the last analysis
+	std::vector<int>	m_pointers;
+	std::vector<int>	m_indices;
+	bool	m_isAnalyzed;
+
+	double	m_pivmin;		//!< pivots smaller than this are perturbed
+	int		m_nperturb;		//!< nr of perturbed pivots in last factorization
+
+	int		m_leafSize;		//!< size of subgraphs that are no longer divided in the nested dissection
+	double	m_pivotTol;		//!< threshold for partial pivoting
+	double	m_perturb;		//!< relative size of pivot perturbation
+	int		m_maxRefine;	//!< max nr of iterative refinement steps
+	int		m_printLevel;	//!< print level
+
+	DECLARE_FECORE_CLASS();
+};
@@ -0,0 +1,450 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "SupernodalSolver.h"
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(SupernodalSolver, LinearSolver)
+	ADD_PARAMETER(m_leafSize  , "leaf_size");
+	ADD_PARAMETER(m_printLevel, "print_level");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+// Below these operation counts the dense kernels are not worth threading
+#define MIN_PARALLEL_WORK	32768
+
+// Nr of columns in the diagonal blocks of a supernode panel
+#define PANEL_BLOCK_SIZE	64
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::SupernodalSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
+{
+	m_isAnalyzed = false;
+	m_leafSize = 64;
+	m_printLevel = 0;
+}
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::~SupernodalSolver()
+{
+	Destroy();
+}
+
+//-----------------------------------------------------------------------------
+//! Create a sparse matrix
+SparseMatrix* SupernodalSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	return (m_pA = (ntype == REAL_SYMMETRIC ? new CompactSymmMatrix(0) : 0));
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	m_pA = dynamic_cast<CompactSymmMatrix*>(pA);
+	return (m_pA != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalSolver::SetPrintLevel(int n)
+{
+	m_printLevel = n;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SamePattern() const
+{
+	int neq = m_pA->Rows();
+	if ((int)m_pointers.size() != neq + 1) return false;
+
+	const int* pointers = m_pA->Pointers();
+	if (equal(m_pointers.begin(), m_pointers.end(), pointers) == false) return false;
+
+	int nnz = m_pointers[neq] - m_pointers[0];
+	if ((int)m_indices.size() != nnz) return false;
+	return equal(m_indices.begin(), m_indices.end(), m_pA->Indices());
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::PreProcess()
+{
+	if (m_pA == nullptr) return false;
+
+	// we only need to redo the symbolic analysis if the sparsity pattern changed
+	if ((m_isAnalyzed == false) || (SamePattern() == false))
+	{
+		if (Analyze() == false) return false;
+	}
+	else if (m_printLevel > 0) feLog("Reusing symbolic factorization.\n");
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::Analyze()
+{
+	m_isAnalyzed = false;
+
+	const int neq = m_pA->Rows();
+	const int offset = m_pA->Offset();
+	const int* pointers = m_pA->Pointers();
+	const int* indices = m_pA->Indices();
+	const int nnz = (neq > 0 ? pointers[neq] - offset : 0);
+
+	// ordering and symbolic factorization
+	m_S.Create(neq, pointers, indices, offset, m_leafSize);
+
+	// find the location in the factor of each matrix value
+	m_scatter.resize(nnz);
+#pragma omp parallel for
+	for (int j = 0; j < neq; ++j)
+	{
+		for (int k = pointers[j] - offset; k < pointers[j + 1] - offset; ++k)
+		{
+			int ni = m_S.m_iperm[indices[k] - offset];
+			int nj = m_S.m_iperm[j];
+			m_scatter[k] = (ni > nj ? m_S.Location(ni, nj) : m_S.Location(nj, ni));
+		}
+	}
+
+	// allocate the factor
+	m_L.resize(m_S.Size());
+
+	// store the pattern so we can check later if we need to redo this
+	m_pointers.assign(pointers, pointers + neq + 1);
+	m_indices.assign(indices, indices + nnz);
+
+	if (m_printLevel > 0)
+	{
+		feLog("\tNr of supernodes .......................... : %d\n", m_S.m_nsn);
+		feLog("\tNr of nonzeroes in factor ................. : %lg\n", (double) m_S.Size());
+		feLog("\tNr of levels in elimination tree .......... : %d\n", m_S.Levels());
+	}
+
+	m_isAnalyzed = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the update C = A * D * B^T for columns k0 ... k0+kn-1 of C, where A is the panel 
+// Ld(p0:md, :) and B is Ld(p0:p1, :), and subtract it from the target panel Ls. The array rel 
+// gives the rows of the target panel that correspond to rows p0 ... md-1 of Ld.
+static void updateColumns(const double* Ld, int md, int wd, int p0, int mr, const int* rd, const int* rel,
+	int k0, int kn, double* Ls, int ms, int f, double* buf)
+{
+	// we only need the lower-triangular part of the update
+	const int len = mr - k0;
+	for (int i = 0; i < kn*len; ++i) buf[i] = 0.0;
+
+	double b[4];
+	for (int l = 0; l < wd; ++l)
+	{
+		const double* lc = Ld + (size_t)l*md + p0;
+		const double dl = Ld[(size_t)l*md + l];
+		const double* a = lc + k0;
+		for (int j = 0; j < kn; ++j) b[j] = dl*lc[k0 + j];
+
+		if (kn == 4)
+		{
+			double* c0 = buf;
+			double* c1 = buf + len;
+			double* c2 = buf + 2*len;
+			double* c3 = buf + 3*len;
+			for (int i = 0; i < len; ++i)
+			{
+				double ai = a[i];
+				c0[i] += ai*b[0];
+				c1[i] += ai*b[1];
+				c2[i] += ai*b[2];
+				c3[i] += ai*b[3];
+			}
+		}
+		else
+		{
+			for (int j = 0; j < kn; ++j)
+			{
+				double* cj = buf + j*len;
+				double bj = b[j];
+				for (int i = 0; i < len; ++i) cj[i] += a[i]*bj;
+			}
+		}
+	}
+
+	// scatter into the target
+	for (int j = 0; j < kn; ++j)
+	{
+		int k = k0 + j;
+		double* tc = Ls + (size_t)(rd[p0 + k] - f)*ms;
+		const double* cj = buf + j*len;
+		for (int i = j; i < len; ++i) tc[rel[k0 + i]] -= cj[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::FactorSupernode(int s, bool parallel, vector<double>& work, vector<int>& rel)
+{
+	const int f = m_S.m_snCol[s];
+	const int ws = m_S.m_snCol[s + 1] - f;
+	const int* rs = &m_S.m_snRows[0] + m_S.m_snRowPtr[s];
+	const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+	double* Ls = &m_L[0] + m_S.m_snVal[s];
+
+	// apply the updates from the descendants
+	for (int u = m_S.m_updPtr[s]; u < m_S.m_updPtr[s + 1]; ++u)
+	{
+		const int d = m_S.m_updSn[u];
+		const int p0 = m_S.m_updRow0[u];
+		const int p1 = m_S.m_updRow1[u];
+		const int wd = m_S.m_snCol[d + 1] - m_S.m_snCol[d];
+		const int* rd = &m_S.m_snRows[0] + m_S.m_snRowPtr[d];
+		const int md = m_S.m_snRowPtr[d + 1] - m_S.m_snRowPtr[d];
+		const double* Ld = &m_L[0] + m_S.m_snVal[d];
+		const int mr = md - p0;
+		const int nc = p1 - p0;
+
+		// the rows of d are a subset of the rows of s
+		rel.resize(mr);
+		int pos = 0;
+		for (int i = 0; i < mr; ++i)
+		{
+			int r = rd[p0 + i];
+			while (rs[pos] != r) pos++;
+			rel[i] = pos;
+		}
+
+		const int nb = (nc + 3) / 4;
+		double work_load = (double)mr*nc*wd;
+		if (parallel && (work_load > MIN_PARALLEL_WORK))
+		{
+			const int* prel = &rel[0];
+#pragma omp parallel
+			{
+				vector<double> buf(4 * mr);
+#pragma omp for schedule(dynamic)
+				for (int b = 0; b < nb; ++b)
+				{
+					int k0 = 4 * b;
+					int kn = (k0 + 4 <= nc ? 4 : nc - k0);
+					updateColumns(Ld, md, wd, p0, mr, rd, prel, k0, kn, Ls, ms, f, &buf[0]);
+				}
+			}
+		}
+		else
+		{
+			if ((int)work.size() < 4 * mr) work.resize(4 * mr);
+			for (int b = 0; b < nb; ++b)
+			{
+				int k0 = 4 * b;
+				int kn = (k0 + 4 <= nc ? 4 : nc - k0);
+				updateColumns(Ld, md, wd, p0, mr, rd, &rel[0], k0, kn, Ls, ms, f, &work[0]);
+			}
+		}
+	}
+
+	// Factor the panel. The columns are processed in blocks: the columns of the block are 
+	// factored with rank-1 updates and then the block is applied to the remaining columns.
+	for (int jb = 0; jb < ws; jb += PANEL_BLOCK_SIZE)
+	{
+		const int je = (jb + PANEL_BLOCK_SIZE < ws ? jb + PANEL_BLOCK_SIZE : ws);
+		for (int j = jb; j < je; ++j)
+		{
+			double* cj = Ls + (size_t)j*ms;
+			const double d = cj[j];
+			if (d == 0.0) return false;
+
+			for (int k = j + 1; k < je; ++k)
+			{
+				double* ck = Ls + (size_t)k*ms;
+				const double fk = cj[k] / d;
+				if (fk == 0.0) continue;
+				for (int i = k; i < ms; ++i) ck[i] -= cj[i] * fk;
+			}
+
+			const double di = 1.0 / d;
+			for (int i = j + 1; i < ms; ++i) cj[i] *= di;
+		}
+
+		// update the trailing columns
+		const int nk = ws - je;
+		double work_load = (double)(ms - je)*nk*(je - jb);
+#pragma omp parallel for schedule(dynamic) if (parallel && (work_load > MIN_PARALLEL_WORK))
+		for (int k = je; k < ws; ++k)
+		{
+			double* ck = Ls + (size_t)k*ms;
+			for (int l = jb; l < je; ++l)
+			{
+				const double* cl = Ls + (size_t)l*ms;
+				const double b = cl[l] * cl[k];
+				if (b == 0.0) continue;
+				for (int i = k; i < ms; ++i) ck[i] -= cl[i] * b;
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::Factor()
+{
+	const int neq = m_pA->Rows();
+	if (neq == 0) return true;
+	if (m_isAnalyzed == false) return false;
+
+	// copy the matrix values into the factor
+	const double* pa = m_pA->Values();
+	const int nnz = (int)m_scatter.size();
+#pragma omp parallel for
+	for (int s = 0; s < m_S.m_nsn; ++s)
+	{
+		for (size_t i = m_S.m_snVal[s]; i < m_S.m_snVal[s + 1]; ++i) m_L[i] = 0.0;
+	}
+#pragma omp parallel for
+	for (int i = 0; i < nnz; ++i) m_L[m_scatter[i]] = pa[i];
+
+	int nthreads = 1;
+#pragma omp parallel
+	{
+#pragma omp single
+		nthreads = omp_get_num_threads();
+	}
+
+	// Process the elimination tree level by level. When a level has enough supernodes, the 
+	// supernodes are distributed over the threads. Otherwise, the dense kernels are threaded.
+	vector<double> work;
+	vector<int> rel;
+	const int nlevels = m_S.Levels();
+	for (int l = 0; l < nlevels; ++l)
+	{
+		const int l0 = m_S.m_levelPtr[l];
+		const int l1 = m_S.m_levelPtr[l + 1];
+		int nfail = 0;
+		if (l1 - l0 >= 2 * nthreads)
+		{
+#pragma omp parallel
+			{
+				vector<double> work_t;
+				vector<int> rel_t;
+#pragma omp for schedule(dynamic) reduction(+:nfail)
+				for (int i = l0; i < l1; ++i)
+				{
+					if (FactorSupernode(m_S.m_levelSn[i], false, work_t, rel_t) == false) nfail++;
+				}
+			}
+		}
+		else
+		{
+			for (int i = l0; i < l1; ++i)
+			{
+				if (FactorSupernode(m_S.m_levelSn[i], true, work, rel) == false) nfail++;
+			}
+		}
+
+		if (nfail > 0)
+		{
+			feLogError("Zero pivot encountered in supernodal factorization.");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::BackSolve(double* x, double* b)
+{
+	const int neq = m_pA->Rows();
+	if (neq == 0) return true;
+
+	// permute right-hand side
+	vector<double> y(neq);
+	for (int i = 0; i < neq; ++i) y[m_S.m_iperm[i]] = b[i];
+
+	// forward substitution
+	for (int s = 0; s < m_S.m_nsn; ++s)
+	{
+		const int f = m_S.m_snCol[s];
+		const int ws = m_S.m_snCol[s + 1] - f;
+		const int* rs = &m_S.m_snRows[0] + m_S.m_snRowPtr[s];
+		const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+		const double* Ls = &m_L[0] + m_S.m_snVal[s];
+		for (int j = 0; j < ws; ++j)
+		{
+			const double yj = y[f + j];
+			if (yj == 0.0) continue;
+			const double* cj = Ls + (size_t)j*ms;
+			for (int i = j + 1; i < ms; ++i) y[rs[i]] -= cj[i] * yj;
+		}
+	}
+
+	// diagonal
+	for (int s = 0; s < m_S.m_nsn; ++s)
+	{
+		const int f = m_S.m_snCol[s];
+		const int ws = m_S.m_snCol[s + 1] - f;
+		const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+		const double* Ls = &m_L[0] + m_S.m_snVal[s];
+		for (int j = 0; j < ws; ++j) y[f + j] /= Ls[(size_t)j*ms + j];
+	}
+
+	// backward substitution
+	for (int s = m_S.m_nsn - 1; s >= 0; --s)
+	{
+		const int f = m_S.m_snCol[s];
+		const int ws = m_S.m_snCol[s + 1] - f;
+		const int* rs = &m_S.m_snRows[0] + m_S.m_snRowPtr[s];
+		const int ms = m_S.m_snRowPtr[s + 1] - m_S.m_snRowPtr[s];
+		const double* Ls = &m_L[0] + m_S.m_snVal[s];
+		for (int j = ws - 1; j >= 0; --j)
+		{
+			const double* cj = Ls + (size_t)j*ms;
+			double sum = 0.0;
+			for (int i = j + 1; i < ms; ++i) sum += cj[i] * y[rs[i]];
+			y[f + j] -= sum;
+		}
+	}
+
+	for (int i = 0; i < neq; ++i) x[i] = y[m_S.m_iperm[i]];
+
+	// update stats
+	UpdateStats(1);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalSolver::Destroy()
+{
+	// The symbolic factorization is kept so that it can be reused
+	// when the matrix is recreated with the same sparsity pattern.
+	LinearSolver::Destroy();
+}
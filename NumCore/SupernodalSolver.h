@@ -0,0 +1,101 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactSymmMatrix.h"
+#include "SupernodalStructure.h"
+
+//-----------------------------------------------------------------------------
+//! Sparse direct solver for symmetric matrices that does not depend on external libraries. 
+
+//! The matrix is reordered with nested dissection and factored as L*D*L^T. Columns of the 
+//! factor that share the same sparsity pattern are grouped into supernodes, which are stored 
+//! as dense panels so that the numerical factorization can be done with dense (multithreaded) kernels.
+//! Independent subtrees of the elimination tree are factored in parallel. 
+//! The symbolic analysis (ordering and the structure of the factor) is only redone 
+//! when the sparsity pattern of the matrix changes.
+//! Note that, like the skyline solver, no pivoting is done.
+class SupernodalSolver : public LinearSolver
+{
+public:
+	//! constructor
+	SupernodalSolver(FEModel* fem);
+
+	//! destructor
+	~SupernodalSolver();
+
+	//! Symbolic analysis
+	bool PreProcess() override;
+
+	//! Numerical factorization
+	bool Factor() override;
+
+	//! Backsolve the linear system
+	bool BackSolve(double* x, double* b) override;
+
+	//! Clean up
+	void Destroy() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! Set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	//! set the print level
+	void SetPrintLevel(int n) override;
+
+private:
+	// see if the matrix has the same sparsity pattern as the one that was analyzed
+	bool SamePattern() const;
+
+	// do the symbolic analysis
+	bool Analyze();
+
+	// factor a single supernode
+	bool FactorSupernode(int s, bool parallel, std::vector<double>& work, std::vector<int>& rel);
+
+private:
+	CompactSymmMatrix*	m_pA;			//!< the matrix
+
+	SupernodalStructure	m_S;		//!< structure of the factor
+
+	std::vector<size_t>	m_scatter;		//!< location of matrix values in factor
+	std::vector<double>	m_L;			//!< values of factor
+
+	// sparsity pattern of the last analysis
+	std::vector<int>	m_pointers;
+	std::vector<int>	m_indices;
+	bool	m_isAnalyzed;
+
+	int		m_leafSize;		//!< size of subgraphs that are no longer divided in the nested dissection
+	int		m_printLevel;	//!< print level
+
+	DECLARE_FECORE_CLASS();
+};
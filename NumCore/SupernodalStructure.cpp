@@ -0,0 +1,251 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "SupernodalStructure.h"
+#include "NestedDissection.h"
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+SupernodalStructure::SupernodalStructure()
+{
+	m_nsn = 0;
+}
+
+//-----------------------------------------------------------------------------
+size_t SupernodalStructure::Location(int r, int c) const
+{
+	int s = m_colSn[c];
+	const int* rs = &m_snRows[0] + m_snRowPtr[s];
+	int ms = m_snRowPtr[s + 1] - m_snRowPtr[s];
+	int pos = (int)(lower_bound(rs, rs + ms, r) - rs);
+	return m_snVal[s] + (size_t)(c - m_snCol[s])*ms + pos;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalStructure::Create(int neq, const int* pointers, const int* indices, int offset, int leafSize)
+{
+	// Build the graph of the matrix and group equations with identical sparsity
+	// (e.g. the degrees of freedom of a node). The ordering and symbolic factorization 
+	// are done on the graph of these groups.
+	vector<int> group, first, gxadj, gadj;
+	int ng = 0;
+	{
+		vector<int> xadj, adj;
+		NumCore::SymmetricGraph(neq, pointers, indices, offset, xadj, adj);
+		ng = NumCore::CompressGraph(neq, xadj, adj, group, first, gxadj, gadj);
+	}
+
+	// calculate the fill-reducing ordering
+	vector<int> gperm, giperm(ng);
+	NumCore::NestedDissection(ng, gxadj, gadj, gperm, leafSize);
+	for (int k = 0; k < ng; ++k) giperm[gperm[k]] = k;
+
+	// elimination tree (Liu's algorithm)
+	vector<int> parent(ng, -1), anc(ng, -1);
+	for (int k = 0; k < ng; ++k)
+	{
+		int v = gperm[k];
+		for (int m = gxadj[v]; m < gxadj[v + 1]; ++m)
+		{
+			int i = giperm[gadj[m]];
+			while ((i != -1) && (i < k))
+			{
+				int inext = anc[i];
+				anc[i] = k;
+				if (inext == -1) parent[i] = k;
+				i = inext;
+			}
+		}
+	}
+
+	// children lists
+	vector<int> childPtr(ng + 1, 0), child(ng);
+	for (int k = 0; k < ng; ++k) if (parent[k] != -1) childPtr[parent[k] + 1]++;
+	for (int k = 0; k < ng; ++k) childPtr[k + 1] += childPtr[k];
+	{
+		vector<int> tag(childPtr.begin(), childPtr.end() - 1);
+		for (int k = 0; k < ng; ++k) if (parent[k] != -1) child[tag[parent[k]]++] = k;
+	}
+
+	// Symbolic factorization: the structure of column k of the factor is the union of 
+	// column k of the matrix and the structures of its children in the elimination tree.
+	// Column k is added to the supernode of column k-1 if its structure is that of k-1 without k-1.
+	// We only need to keep the structures of the first column of each supernode.
+	vector< vector<int> > str(ng);
+	vector<int> cnt(ng, 0), marker(ng, -1);
+	vector<bool> isStart(ng, true);
+	for (int k = 0; k < ng; ++k)
+	{
+		vector<int>& sk = str[k];
+		sk.push_back(k);
+		marker[k] = k;
+
+		int v = gperm[k];
+		for (int m = gxadj[v]; m < gxadj[v + 1]; ++m)
+		{
+			int i = giperm[gadj[m]];
+			if ((i > k) && (marker[i] != k)) { sk.push_back(i); marker[i] = k; }
+		}
+
+		for (int m = childPtr[k]; m < childPtr[k + 1]; ++m)
+		{
+			const vector<int>& sc = str[child[m]];
+			for (size_t n = 0; n < sc.size(); ++n)
+			{
+				int i = sc[n];
+				if ((i > k) && (marker[i] != k)) { sk.push_back(i); marker[i] = k; }
+			}
+		}
+		sort(sk.begin(), sk.end());
+		cnt[k] = (int)sk.size();
+
+		if ((k > 0) && (parent[k - 1] == k) && (cnt[k - 1] == cnt[k] + 1)) isStart[k] = false;
+
+		for (int m = childPtr[k]; m < childPtr[k + 1]; ++m)
+		{
+			int c = child[m];
+			if (isStart[c] == false) vector<int>().swap(str[c]);
+		}
+	}
+
+	// equation numbers of the groups (in new numbering)
+	vector<int> dofStart(ng + 1, 0);
+	for (int k = 0; k < ng; ++k)
+	{
+		int v = gperm[k];
+		dofStart[k + 1] = dofStart[k] + (first[v + 1] - first[v]);
+	}
+
+	// permutation of the equations
+	m_perm.resize(neq);
+	m_iperm.resize(neq);
+	for (int k = 0; k < ng; ++k)
+	{
+		int v = gperm[k];
+		int nk = first[v + 1] - first[v];
+		for (int t = 0; t < nk; ++t) m_perm[dofStart[k] + t] = first[v] + t;
+	}
+	for (int i = 0; i < neq; ++i) m_iperm[m_perm[i]] = i;
+
+	// setup the supernodes
+	m_snCol.clear();
+	m_snRowPtr.assign(1, 0);
+	m_snRows.clear();
+	m_snVal.assign(1, 0);
+	for (int k = 0; k < ng; ++k)
+	{
+		if (isStart[k] == false) continue;
+
+		m_snCol.push_back(dofStart[k]);
+		const vector<int>& sk = str[k];
+		for (size_t n = 0; n < sk.size(); ++n)
+		{
+			int g = sk[n];
+			for (int i = dofStart[g]; i < dofStart[g + 1]; ++i) m_snRows.push_back(i);
+		}
+		m_snRowPtr.push_back((int)m_snRows.size());
+		vector<int>().swap(str[k]);
+	}
+	m_nsn = (int)m_snCol.size();
+	m_snCol.push_back(neq);
+
+	m_colSn.resize(neq);
+	for (int s = 0; s < m_nsn; ++s)
+	{
+		int ws = m_snCol[s + 1] - m_snCol[s];
+		size_t ms = m_snRowPtr[s + 1] - m_snRowPtr[s];
+		m_snVal.push_back(m_snVal[s] + ms*ws);
+		for (int i = m_snCol[s]; i < m_snCol[s + 1]; ++i) m_colSn[i] = s;
+	}
+
+	// Level of each supernode in the supernodal elimination tree. Supernodes in the same
+	// level do not depend on each other and can be factored in parallel.
+	vector<int> level(m_nsn, 0);
+	int maxLevel = 0;
+	for (int s = 0; s < m_nsn; ++s)
+	{
+		int ws = m_snCol[s + 1] - m_snCol[s];
+		int ms = m_snRowPtr[s + 1] - m_snRowPtr[s];
+		if (ms > ws)
+		{
+			int p = m_colSn[m_snRows[m_snRowPtr[s] + ws]];
+			if (level[s] + 1 > level[p]) level[p] = level[s] + 1;
+		}
+		if (level[s] > maxLevel) maxLevel = level[s];
+	}
+	m_levelPtr.assign(maxLevel + 2, 0);
+	m_levelSn.resize(m_nsn);
+	for (int s = 0; s < m_nsn; ++s) m_levelPtr[level[s] + 1]++;
+	for (int l = 0; l <= maxLevel; ++l) m_levelPtr[l + 1] += m_levelPtr[l];
+	{
+		vector<int> tag(m_levelPtr.begin(), m_levelPtr.end() - 1);
+		for (int s = 0; s < m_nsn; ++s) m_levelSn[tag[level[s]]++] = s;
+	}
+
+	// Find the updates. Supernode d updates supernode t with the rows of d that lie in the columns of t.
+	m_updPtr.assign(m_nsn + 1, 0);
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		vector<int> tag;
+		if (pass == 1)
+		{
+			for (int s = 0; s < m_nsn; ++s) m_updPtr[s + 1] += m_updPtr[s];
+			int nupd = m_updPtr[m_nsn];
+			m_updSn.resize(nupd);
+			m_updRow0.resize(nupd);
+			m_updRow1.resize(nupd);
+			tag.assign(m_updPtr.begin(), m_updPtr.end() - 1);
+		}
+
+		for (int d = 0; d < m_nsn; ++d)
+		{
+			const int* rd = &m_snRows[0] + m_snRowPtr[d];
+			int wd = m_snCol[d + 1] - m_snCol[d];
+			int md = m_snRowPtr[d + 1] - m_snRowPtr[d];
+			int p = wd;
+			while (p < md)
+			{
+				int t = m_colSn[rd[p]];
+				int q = p;
+				while ((q < md) && (rd[q] < m_snCol[t + 1])) q++;
+				if (pass == 0) m_updPtr[t + 1]++;
+				else
+				{
+					int n = tag[t]++;
+					m_updSn[n] = d;
+					m_updRow0[n] = p;
+					m_updRow1[n] = q;
+				}
+				p = q;
+			}
+		}
+	}
+
+}
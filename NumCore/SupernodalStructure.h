@@ -0,0 +1,80 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Structure of a supernodal factorization of a matrix with a symmetric sparsity
+//! pattern (or of the pattern of A + A^T for unsymmetric matrices). 
+
+//! The equations are reordered with nested dissection. Columns of the factor with 
+//! the same sparsity are grouped into supernodes. The columns of a supernode are 
+//! stored as a dense panel (column-major) whose rows are given by the supernode's row 
+//! structure. The first rows of a supernode are the columns of the supernode itself.
+class SupernodalStructure
+{
+public:
+	SupernodalStructure();
+
+	//! Do the symbolic analysis of a compressed row or column pattern
+	void Create(int neq, const int* pointers, const int* indices, int offset, int leafSize);
+
+	//! Location of entry (r, c) in the panels (in permuted numbering).
+	//! Row r must be in the row structure of the supernode of column c.
+	size_t Location(int r, int c) const;
+
+	//! Total size of all panels
+	size_t Size() const { return m_snVal.empty() ? 0 : m_snVal.back(); }
+
+	//! Number of levels of the elimination tree
+	int Levels() const { return (int)m_levelPtr.size() - 1; }
+
+public:
+	// ordering
+	std::vector<int>	m_perm;			//!< new to old equation number
+	std::vector<int>	m_iperm;		//!< old to new equation number
+
+	// structure of the factor
+	int	m_nsn;							//!< number of supernodes
+	std::vector<int>	m_snCol;		//!< first column of each supernode
+	std::vector<int>	m_snRowPtr;		//!< start of row structure of each supernode
+	std::vector<int>	m_snRows;		//!< row indices (in permuted numbering)
+	std::vector<size_t>	m_snVal;		//!< start of dense panel of each supernode
+	std::vector<int>	m_colSn;		//!< supernode of each column
+
+	// update lists: the supernodes (and row ranges) that update each supernode
+	std::vector<int>	m_updPtr;
+	std::vector<int>	m_updSn;
+	std::vector<int>	m_updRow0;
+	std::vector<int>	m_updRow1;
+
+	// supernodes, sorted by level in the elimination tree
+	std::vector<int>	m_levelPtr;
+	std::vector<int>	m_levelSn;
+};